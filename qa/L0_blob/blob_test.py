@@ -0,0 +1,140 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import socket
+import unittest
+import numpy as np
+import http_util as hu
+
+# The server is started with a 4096 byte blob store.
+_store_byte_size = 4096
+_model_name = "graphdef_int32_int32_int32"
+
+
+def _upload(content, headers={}):
+    return hu.request("POST", "/api/blob", content, headers)
+
+
+class BlobTest(unittest.TestCase):
+
+    def _upload_ok(self, content):
+        status, headers, _ = _upload(content)
+        self.assertEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        self.assertTrue("nv-blobkey" in headers)
+        return headers["nv-blobkey"]
+
+    def _infer(self, key, input1):
+        # INPUT0 from the blob, INPUT1 in the body. Version 1 of the
+        # model produces the sum and difference of the inputs.
+        request_header = \
+            'batch_size: 1 input { name: "INPUT0" blob_key: "%s" } ' \
+            'input { name: "INPUT1" } ' \
+            'output { name: "OUTPUT0" } output { name: "OUTPUT1" }' % key
+        return hu.infer(_model_name, request_header, input1.tobytes(),
+                        model_version=1)
+
+    def test_upload_infer(self):
+        input0 = np.arange(16, dtype=np.int32)
+        input1 = np.full(16, 5, dtype=np.int32)
+        key = self._upload_ok(input0.tobytes())
+
+        # The same content gives the same key.
+        self.assertEqual(self._upload_ok(input0.tobytes()), key)
+
+        status, headers, body = self._infer(key, input1)
+        self.assertEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        outputs = np.frombuffer(body, dtype=np.int32)
+        self.assertTrue(np.array_equal(outputs[:16], input0 + input1))
+        self.assertTrue(np.array_equal(outputs[16:], input0 - input1))
+
+    def test_unknown_key(self):
+        status, headers, _ = self._infer(
+            "0" * 32, np.zeros(16, dtype=np.int32))
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "BLOB_NOT_FOUND")
+
+    def test_eviction(self):
+        # Filling the store evicts the least recently used blob.
+        first = np.full(16, 1, dtype=np.int32)
+        key = self._upload_ok(first.tobytes())
+        for i in range(2 * _store_byte_size // first.nbytes):
+            self._upload_ok(np.full(16, 100 + i, dtype=np.int32).tobytes())
+
+        status, headers, _ = self._infer(key, np.zeros(16, dtype=np.int32))
+        self.assertEqual(hu.status_code(headers), "BLOB_NOT_FOUND")
+
+    def test_largest(self):
+        self._upload_ok(b"\x01" * _store_byte_size)
+
+    def test_too_large(self):
+        # A body larger than the store, sent without a Content-Length
+        # so that the server can only check it once it is received.
+        conn = hu.httplib.HTTPConnection("localhost:8000")
+        conn.putrequest("POST", "/api/blob")
+        conn.putheader("Transfer-Encoding", "chunked")
+        conn.endheaders()
+        chunk = b"\x02" * 1024
+        for _ in range((_store_byte_size // len(chunk)) + 1):
+            conn.send(b"%x\r\n%s\r\n" % (len(chunk), chunk))
+        conn.send(b"0\r\n\r\n")
+        response = conn.getresponse()
+        response.read()
+        conn.close()
+        self.assertEqual(response.status, 400)
+        self.assertEqual(hu.status_code(dict(
+            (k.lower(), v) for k, v in response.getheaders())), "INVALID_ARG")
+
+    def test_too_large_content_length(self):
+        # A Content-Length larger than the store is rejected from the
+        # headers and the connection is closed without reading the
+        # body, so the body is never sent.
+        sock = socket.create_connection(("localhost", 8000))
+        sock.sendall(b"POST /api/blob HTTP/1.1\r\nHost: localhost\r\n"
+                     b"Content-Length: 1073741824\r\n\r\n")
+        sock.settimeout(10)
+        reply = b""
+        try:
+            while True:
+                data = sock.recv(4096)
+                if not data:
+                    break
+                reply += data
+        except socket.error:
+            pass
+        sock.close()
+        self.assertFalse(reply.startswith(b"HTTP/1.1 200"))
+
+        # The server is still healthy.
+        status, _, _ = hu.request("GET", "/api/health/live")
+        self.assertEqual(status, 200)
+
+
+if __name__ == '__main__':
+    unittest.main()
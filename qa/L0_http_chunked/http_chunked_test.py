@@ -0,0 +1,176 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import socket
+import time
+import unittest
+import zlib
+import numpy as np
+import http_util as hu
+
+# The server sends response bodies larger than 256 bytes in 256 byte
+# chunks, and compresses response bodies of at least 512 bytes. Version
+# 1 of the model produces the sum and difference of its inputs, each
+# 16 INT32 values per batch entry, so the response body is 128 bytes
+# per batch entry.
+_model_name = "graphdef_int32_int32_int32"
+_chunk_byte_size = 256
+_request_header = \
+    'batch_size: %d input { name: "INPUT0" } input { name: "INPUT1" } ' \
+    'output { name: "OUTPUT0" } output { name: "OUTPUT1" }'
+
+
+def _inputs(batch_size):
+    input0 = np.arange(batch_size * 16, dtype=np.int32)
+    input1 = np.full(batch_size * 16, 3, dtype=np.int32)
+    return input0, input1
+
+
+def _raw_infer(batch_size, protocol, read_delay_s=0):
+    """Send an infer request with 'protocol', "HTTP/1.0" or "HTTP/1.1",
+    and read the response a few bytes at a time, waiting 'read_delay_s'
+    between reads. Return the response headers, with lower-cased names,
+    and the body as it was sent, without decoding any chunks."""
+    input0, input1 = _inputs(batch_size)
+    body = input0.tobytes() + input1.tobytes()
+    request = \
+        ("POST /api/infer/%s/1 %s\r\n" % (_model_name, protocol)) + \
+        "Host: localhost\r\nConnection: close\r\n" + \
+        ("NV-InferRequest: %s\r\n" % (_request_header % batch_size)) + \
+        ("Content-Length: %d\r\n\r\n" % len(body))
+
+    sock = socket.create_connection(("localhost", 8000))
+    try:
+        sock.sendall(request.encode() + body)
+        response = b""
+        while True:
+            data = sock.recv(64)
+            if not data:
+                break
+            response += data
+            if read_delay_s > 0:
+                time.sleep(read_delay_s)
+    finally:
+        sock.close()
+
+    head, _, content = response.partition(b"\r\n\r\n")
+    lines = head.decode().split("\r\n")
+    headers = {}
+    for line in lines[1:]:
+        name, _, value = line.partition(":")
+        headers[name.strip().lower()] = value.strip()
+    return lines[0], headers, content
+
+
+def _dechunk(content):
+    """Return the sizes of the chunks in a chunked 'content' and the
+    data they hold."""
+    sizes = []
+    data = b""
+    while True:
+        size_line, _, content = content.partition(b"\r\n")
+        size = int(size_line.split(b";")[0], 16)
+        if size == 0:
+            return sizes, data
+        sizes.append(size)
+        data += content[:size]
+        content = content[size + 2:]
+
+
+class HTTPChunkedTest(unittest.TestCase):
+
+    def _check_outputs(self, body, input0, input1):
+        outputs = np.frombuffer(body, dtype=np.int32)
+        size = input0.size
+        self.assertTrue(np.array_equal(outputs[:size], input0 + input1))
+        self.assertTrue(np.array_equal(outputs[size:], input0 - input1))
+
+    def _infer_ok(self, batch_size, headers={}):
+        input0, input1 = _inputs(batch_size)
+        status, response_headers, content = hu.infer(
+            _model_name, _request_header % batch_size,
+            input0.tobytes() + input1.tobytes(), headers, model_version=1)
+        self.assertEqual(status, 200, response_headers.get('nv-status'))
+        self.assertEqual(hu.status_code(response_headers), "SUCCESS")
+        return response_headers, content
+
+    def test_chunked_response(self):
+        batch_size = 8
+        headers, content = self._infer_ok(batch_size)
+        self.assertEqual(headers.get("transfer-encoding"), "chunked")
+        self.assertFalse("content-length" in headers)
+        self._check_outputs(content, *_inputs(batch_size))
+
+    def test_unchunked_response(self):
+        # A body of exactly the chunk size is sent at once.
+        batch_size = _chunk_byte_size // 128
+        headers, content = self._infer_ok(batch_size)
+        self.assertFalse("transfer-encoding" in headers)
+        self.assertEqual(int(headers.get("content-length")), len(content))
+        self._check_outputs(content, *_inputs(batch_size))
+
+    def test_chunk_sizes(self):
+        batch_size = 8
+        status_line, headers, content = _raw_infer(batch_size, "HTTP/1.1")
+        self.assertTrue(status_line.endswith("200 OK"), status_line)
+        self.assertEqual(headers.get("transfer-encoding"), "chunked")
+        sizes, data = _dechunk(content)
+        self.assertEqual(sizes, [_chunk_byte_size] * 4)
+        self._check_outputs(data, *_inputs(batch_size))
+
+    def test_slow_reader(self):
+        batch_size = 8
+        status_line, headers, content = _raw_infer(
+            batch_size, "HTTP/1.1", read_delay_s=0.05)
+        self.assertTrue(status_line.endswith("200 OK"), status_line)
+        self.assertEqual(headers.get("transfer-encoding"), "chunked")
+        _, data = _dechunk(content)
+        self._check_outputs(data, *_inputs(batch_size))
+
+    def test_http10_response(self):
+        # Chunked transfer encoding requires HTTP/1.1.
+        batch_size = 8
+        status_line, headers, content = _raw_infer(batch_size, "HTTP/1.0")
+        self.assertTrue(status_line.endswith("200 OK"), status_line)
+        self.assertFalse("transfer-encoding" in headers)
+        self._check_outputs(content, *_inputs(batch_size))
+
+    def test_chunked_compressed_response(self):
+        batch_size = 8
+        for accept, wbits in (("gzip", 16 + zlib.MAX_WBITS),
+                              ("deflate", zlib.MAX_WBITS)):
+            headers, content = self._infer_ok(
+                batch_size, { "Accept-Encoding" : accept })
+            self.assertEqual(headers.get("transfer-encoding"), "chunked")
+            self.assertEqual(headers.get("content-encoding"), accept)
+            self._check_outputs(zlib.decompress(content, wbits),
+                                *_inputs(batch_size))
+
+
+if __name__ == '__main__':
+    unittest.main()
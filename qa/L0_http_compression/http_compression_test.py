@@ -0,0 +1,146 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import gzip
+import io
+import unittest
+import zlib
+import numpy as np
+import http_util as hu
+
+# The server compresses response bodies of at least 512 bytes. Version
+# 1 of the model produces the sum and difference of its inputs, each
+# 16 INT32 values per batch entry, so the response body is 128 bytes
+# per batch entry.
+_model_name = "graphdef_int32_int32_int32"
+_threshold = 512
+
+
+def _gzip(data):
+    out = io.BytesIO()
+    with gzip.GzipFile(fileobj=out, mode="wb") as f:
+        f.write(data)
+    return out.getvalue()
+
+
+def _infer(batch_size, body, headers={}):
+    request_header = \
+        ('batch_size: %d input { name: "INPUT0" } ' % batch_size) + \
+        'input { name: "INPUT1" } ' \
+        'output { name: "OUTPUT0" } output { name: "OUTPUT1" }'
+    return hu.infer(_model_name, request_header, body, headers,
+                    model_version=1)
+
+
+class HTTPCompressionTest(unittest.TestCase):
+
+    def _inputs(self, batch_size):
+        input0 = np.arange(batch_size * 16, dtype=np.int32)
+        input1 = np.full(batch_size * 16, 3, dtype=np.int32)
+        return input0, input1
+
+    def _check_outputs(self, body, input0, input1):
+        outputs = np.frombuffer(body, dtype=np.int32)
+        size = input0.size
+        self.assertTrue(np.array_equal(outputs[:size], input0 + input1))
+        self.assertTrue(np.array_equal(outputs[size:], input0 - input1))
+
+    def _infer_ok(self, batch_size, body, headers={}):
+        status, response_headers, content = _infer(batch_size, body, headers)
+        self.assertEqual(status, 200, response_headers.get('nv-status'))
+        self.assertEqual(hu.status_code(response_headers), "SUCCESS")
+        return response_headers, content
+
+    def test_compressed_request(self):
+        input0, input1 = self._inputs(2)
+        body = input0.tobytes() + input1.tobytes()
+        for encoding, compressed in (("gzip", _gzip(body)),
+                                     ("deflate", zlib.compress(body))):
+            headers, content = self._infer_ok(
+                2, compressed, { "Content-Encoding" : encoding })
+            self.assertFalse("content-encoding" in headers)
+            self._check_outputs(content, input0, input1)
+
+    def test_compressed_response(self):
+        batch_size = _threshold // 128
+        input0, input1 = self._inputs(batch_size)
+        body = input0.tobytes() + input1.tobytes()
+        for accept, encoding, wbits in (
+                ("gzip", "gzip", 16 + zlib.MAX_WBITS),
+                ("deflate", "deflate", zlib.MAX_WBITS),
+                ("gzip;q=0, deflate", "deflate", zlib.MAX_WBITS),
+                ("br, gzip;q=0.5", "gzip", 16 + zlib.MAX_WBITS)):
+            headers, content = self._infer_ok(
+                batch_size, body, { "Accept-Encoding" : accept })
+            self.assertEqual(headers.get("content-encoding"), encoding)
+            self._check_outputs(zlib.decompress(content, wbits), input0,
+                                input1)
+
+    def test_uncompressed_response(self):
+        # Below the threshold, or without an accepted encoding, the
+        # response is not compressed.
+        for batch_size, accept in ((_threshold // 128 - 1, "gzip"),
+                                   (_threshold // 128, "br"),
+                                   (_threshold // 128, "gzip;q=0"),
+                                   (_threshold // 128, None)):
+            input0, input1 = self._inputs(batch_size)
+            headers = {} if accept is None else { "Accept-Encoding" : accept }
+            response_headers, content = self._infer_ok(
+                batch_size, input0.tobytes() + input1.tobytes(), headers)
+            self.assertFalse("content-encoding" in response_headers)
+            self._check_outputs(content, input0, input1)
+
+    def test_both_compressed(self):
+        batch_size = 8
+        input0, input1 = self._inputs(batch_size)
+        headers, content = self._infer_ok(
+            batch_size, _gzip(input0.tobytes() + input1.tobytes()),
+            { "Content-Encoding" : "gzip", "Accept-Encoding" : "gzip" })
+        self.assertEqual(headers.get("content-encoding"), "gzip")
+        self._check_outputs(zlib.decompress(content, 16 + zlib.MAX_WBITS),
+                            input0, input1)
+
+    def test_corrupt_request(self):
+        input0, input1 = self._inputs(1)
+        compressed = bytearray(_gzip(input0.tobytes() + input1.tobytes()))
+        compressed[len(compressed) // 2] ^= 0xff
+        status, headers, _ = _infer(1, bytes(compressed),
+                                    { "Content-Encoding" : "gzip" })
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+    def test_unknown_encoding(self):
+        input0, input1 = self._inputs(1)
+        status, headers, _ = _infer(1, input0.tobytes() + input1.tobytes(),
+                                    { "Content-Encoding" : "br" })
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "UNSUPPORTED")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,113 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import socket
+import time
+import unittest
+import numpy as np
+import http_util as hu
+
+# Version 1 of the model produces the sum and difference of its
+# inputs, each 16 INT32 values per batch entry, so the input data of a
+# request is 128 bytes per batch entry.
+_model_name = "graphdef_int32_int32_int32"
+_request_header = \
+    'batch_size: %d input { name: "INPUT0" } input { name: "%s" } ' \
+    'output { name: "OUTPUT0" }'
+
+
+def _body(batch_size):
+    return np.arange(batch_size * 32, dtype=np.int32).tobytes()
+
+
+def _infer(model_name, batch_size, body, input1_name="INPUT1"):
+    status, headers, _ = hu.infer(
+        model_name, _request_header % (batch_size, input1_name), body)
+    return status, hu.status_code(headers)
+
+
+class InferUploadTest(unittest.TestCase):
+
+    def test_success(self):
+        self.assertEqual(_infer(_model_name, 2, _body(2)), (200, "SUCCESS"))
+
+    def test_unknown_model(self):
+        # The large body of a request that can't succeed is discarded
+        # and the error returned once it is received.
+        status, code = _infer("no_such_model", 1, b"\0" * (16 * 1024 * 1024))
+        self.assertEqual(status, 400)
+        self.assertEqual(code, "NOT_FOUND")
+
+    def test_unknown_input(self):
+        status, code = _infer(_model_name, 1, _body(1), "NO_SUCH_INPUT")
+        self.assertEqual(status, 400)
+        self.assertEqual(code, "INVALID_ARG")
+
+    def test_body_smaller(self):
+        status, code = _infer(_model_name, 2, _body(1))
+        self.assertEqual(status, 400)
+        self.assertEqual(code, "INVALID_ARG")
+
+    def test_body_larger(self):
+        # A body announced larger than the input data is rejected by
+        # closing the connection, without reading the rest of it.
+        header = _request_header % (1, "INPUT1")
+        request = \
+            ("POST /api/infer/%s HTTP/1.1\r\n" % _model_name) + \
+            "Host: localhost\r\n" + \
+            ("NV-InferRequest: %s\r\n" % header) + \
+            ("Content-Length: %d\r\n\r\n" % (64 * 1024 * 1024))
+
+        sock = socket.create_connection(("localhost", 8000))
+        response = b""
+        try:
+            sock.sendall(request.encode())
+            time.sleep(1)
+            sock.settimeout(10)
+            for _ in range(64 * 1024):
+                sock.sendall(b"\0" * 1024)
+            self.fail("expected the server to close the connection")
+        except socket.timeout:
+            self.fail("expected the server to close the connection")
+        except socket.error:
+            pass
+        finally:
+            try:
+                response = sock.recv(4096)
+            except socket.error:
+                pass
+            sock.close()
+
+        self.assertFalse(response.startswith(b"HTTP/1.1 200"), response)
+
+        # The server still serves other requests.
+        self.assertEqual(_infer(_model_name, 1, _body(1)), (200, "SUCCESS"))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,154 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import unittest
+import numpy as np
+import http_util as hu
+
+# Version 1 of each model produces the sum (OUTPUT0) and difference
+# (OUTPUT1) of its two 16-element inputs.
+_outputs = 'output { name: "OUTPUT0" } output { name: "OUTPUT1" }'
+
+
+def _input(name, data_type=None, conversion=None):
+    text = 'input { name: "%s"' % name
+    if data_type is not None:
+        text += ' data_type: %s' % data_type
+    if conversion is not None:
+        text += ' conversion { %s }' % conversion
+    return text + ' } '
+
+
+def _infer(model_name, batch_size, inputs, input_values):
+    request_header = ('batch_size: %d ' % batch_size) + \
+        ''.join(inputs) + _outputs
+    body = b''.join(v.tobytes() for v in input_values)
+    return hu.infer(model_name, request_header, body, model_version=1)
+
+
+class InputConversionTest(unittest.TestCase):
+
+    def _check(self, model_name, dtype, batch_size, inputs, input_values,
+               expected0, expected1):
+        status, headers, body = _infer(model_name, batch_size, inputs,
+                                       input_values)
+        self.assertEqual(status, 200, headers.get('nv-status'))
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        outputs = np.frombuffer(body, dtype=dtype).reshape(2, batch_size, 16)
+        self.assertTrue(np.array_equal(outputs[0], expected0),
+                        "{} != {}".format(outputs[0], expected0))
+        self.assertTrue(np.array_equal(outputs[1], expected1),
+                        "{} != {}".format(outputs[1], expected1))
+
+    def test_uint8_to_fp32(self):
+        for batch_size in (1, 3):
+            input0 = np.arange(batch_size * 16, dtype=np.uint8) * 5
+            input1 = np.arange(batch_size * 16, dtype=np.float32)
+            converted0 = input0.astype(np.float32)
+            self._check("graphdef_float32_float32_float32", np.float32,
+                        batch_size,
+                        (_input("INPUT0", "TYPE_UINT8"), _input("INPUT1")),
+                        (input0, input1),
+                        (converted0 + input1).reshape(batch_size, 16),
+                        (converted0 - input1).reshape(batch_size, 16))
+
+    def test_scale_offset(self):
+        # Scale and offset are applied to the wire values before they
+        # reach the model.
+        input0 = np.arange(16, dtype=np.uint8) * 16
+        input1 = np.zeros(16, dtype=np.int8)
+        converted0 = input0.astype(np.float32) * 0.5 + 1.0
+        self._check("graphdef_float32_float32_float32", np.float32, 1,
+                    (_input("INPUT0", "TYPE_UINT8",
+                            "scale: 0.5 offset: 1.0"),
+                     _input("INPUT1", "TYPE_INT8")),
+                    (input0, input1),
+                    converted0.reshape(1, 16), converted0.reshape(1, 16))
+
+    def test_fp16_to_fp32(self):
+        input0 = np.linspace(-4, 4, 16).astype(np.float16)
+        input1 = np.full(16, 0.25, dtype=np.float16)
+        converted0 = input0.astype(np.float32)
+        converted1 = input1.astype(np.float32)
+        self._check("graphdef_float32_float32_float32", np.float32, 1,
+                    (_input("INPUT0", "TYPE_FP16"),
+                     _input("INPUT1", "TYPE_FP16")),
+                    (input0, input1),
+                    (converted0 + converted1).reshape(1, 16),
+                    (converted0 - converted1).reshape(1, 16))
+
+    def test_fp32_to_int32(self):
+        # Values are rounded to nearest, ties away from zero, NaN
+        # becomes zero, and out-of-range values saturate.
+        info = np.iinfo(np.int32)
+        input0 = np.array([ 0.0, 0.4, 0.5, 1.5, 2.5, -0.4, -0.5, -1.5,
+                            -2.5, 100.7, -100.7, np.nan, 1e10, -1e10,
+                            np.inf, -np.inf ], dtype=np.float32)
+        converted0 = np.array([ 0, 0, 1, 2, 3, 0, -1, -2, -3, 101, -101,
+                                0, info.max, info.min, info.max,
+                                info.min ], dtype=np.int32)
+        input1 = np.zeros(16, dtype=np.int32)
+        self._check("graphdef_int32_int32_int32", np.int32, 1,
+                    (_input("INPUT0", "TYPE_FP32"), _input("INPUT1")),
+                    (input0, input1),
+                    converted0.reshape(1, 16), converted0.reshape(1, 16))
+
+    def test_same_data_type(self):
+        # Naming the model's datatype is the same as not converting.
+        input0 = np.arange(16, dtype=np.int32)
+        input1 = np.full(16, 3, dtype=np.int32)
+        self._check("graphdef_int32_int32_int32", np.int32, 1,
+                    (_input("INPUT0", "TYPE_INT32"), _input("INPUT1")),
+                    (input0, input1),
+                    (input0 + input1).reshape(1, 16),
+                    (input0 - input1).reshape(1, 16))
+
+    def _check_error(self, inputs, input_values):
+        status, headers, _ = _infer("graphdef_int32_int32_int32", 1, inputs,
+                                    input_values)
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+    def test_unconvertible(self):
+        zeros = np.zeros(16, dtype=np.int32)
+        for data_type in ("TYPE_STRING", "TYPE_BOOL"):
+            self._check_error((_input("INPUT0", data_type),
+                               _input("INPUT1")), (zeros, zeros))
+        self._check_error((_input("INPUT0", "TYPE_BOOL", "scale: 2"),
+                           _input("INPUT1")), (zeros, zeros))
+
+    def test_wrong_byte_size(self):
+        # The body must be sized for the wire datatype, not the model
+        # datatype.
+        zeros = np.zeros(16, dtype=np.int32)
+        self._check_error((_input("INPUT0", "TYPE_UINT8"), _input("INPUT1")),
+                          (zeros, zeros))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,116 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import unittest
+import numpy as np
+import http_util as hu
+
+# The identity models return each input unchanged as the matching
+# output, so OUTPUT0 shows INPUT0 in the layout of the model.
+_model_dims = { "nchw" : (3, 4, 5), "nhwc" : (4, 5, 3) }
+_to_model = { "nchw" : (0, 3, 1, 2), "nhwc" : (0, 2, 3, 1) }
+
+
+def _infer(model_format, batch_size, input0_spec, input0, input1_spec="",
+           data_type=np.float32):
+    request_header = \
+        ('batch_size: %d input { name: "INPUT0" %s } ' %
+         (batch_size, input0_spec)) + \
+        ('input { name: "INPUT1" %s } ' % input1_spec) + \
+        'output { name: "OUTPUT0" } output { name: "OUTPUT1" }'
+    input1 = np.arange(batch_size * 60, dtype=np.float32)
+    return hu.infer("custom_%s_float32" % model_format, request_header,
+                    input0.astype(data_type).tobytes() + input1.tobytes())
+
+
+class InputFormatTest(unittest.TestCase):
+
+    def _check(self, model_format, batch_size, input0_spec, input0,
+               data_type=np.float32):
+        status, headers, body = _infer(model_format, batch_size,
+                                       input0_spec, input0,
+                                       data_type=data_type)
+        self.assertEqual(status, 200, headers.get('nv-status'))
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        outputs = np.frombuffer(body, dtype=np.float32)
+        output0 = outputs[:batch_size * 60].reshape(
+            (batch_size,) + _model_dims[model_format])
+        output1 = outputs[batch_size * 60:]
+        expected0 = np.transpose(input0, _to_model[model_format])
+        self.assertTrue(np.array_equal(output0, expected0),
+                        "{} != {}".format(output0, expected0))
+        self.assertTrue(np.array_equal(
+            output1, np.arange(batch_size * 60, dtype=np.float32)))
+
+    def test_nhwc_to_nchw(self):
+        for batch_size in (1, 3):
+            input0 = np.arange(batch_size * 60, dtype=np.float32).reshape(
+                batch_size, 4, 5, 3)
+            self._check("nchw", batch_size, "format: FORMAT_NHWC", input0)
+            self._check("nchw", batch_size,
+                        "format: FORMAT_NHWC dims: [ 4, 5, 3 ]", input0)
+
+    def test_nchw_to_nhwc(self):
+        for batch_size in (1, 3):
+            input0 = np.arange(batch_size * 60, dtype=np.float32).reshape(
+                batch_size, 3, 4, 5)
+            self._check("nhwc", batch_size, "format: FORMAT_NCHW", input0)
+            self._check("nhwc", batch_size,
+                        "format: FORMAT_NCHW dims: [ 3, 4, 5 ]", input0)
+
+    def test_same_format(self):
+        input0 = np.arange(60, dtype=np.float32).reshape(1, 3, 4, 5)
+        status, headers, body = _infer("nchw", 1, "format: FORMAT_NCHW",
+                                       input0)
+        self.assertEqual(status, 200, headers.get('nv-status'))
+        self.assertTrue(np.array_equal(
+            np.frombuffer(body, dtype=np.float32)[:60], input0.flatten()))
+
+    def test_with_conversion(self):
+        # The datatype conversion and the transpose combine.
+        input0 = np.arange(120, dtype=np.uint8).reshape(2, 4, 5, 3)
+        self._check("nchw", 2, "format: FORMAT_NHWC data_type: TYPE_UINT8",
+                    input0, data_type=np.uint8)
+
+    def _check_error(self, model_format, input0_spec, input1_spec=""):
+        input0 = np.zeros(60, dtype=np.float32)
+        status, headers, _ = _infer(model_format, 1, input0_spec, input0,
+                                    input1_spec)
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+    def test_errors(self):
+        # An input without a format can't be transposed.
+        self._check_error("nchw", "", "format: FORMAT_NHWC")
+        # Dims must be in the layout of the request.
+        self._check_error("nchw", "format: FORMAT_NHWC dims: [ 3, 4, 5 ]")
+        self._check_error("nchw", "format: FORMAT_NHWC dims: [ 20, 3 ]")
+
+
+if __name__ == '__main__':
+    unittest.main()
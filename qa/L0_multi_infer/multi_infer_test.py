@@ -0,0 +1,189 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import base64
+import struct
+import time
+import unittest
+import grpc
+import numpy as np
+import http_util as hu
+from tensorrtserver.api import *
+from tensorrtserver.api import api_pb2
+from tensorrtserver.api import grpc_service_pb2
+from tensorrtserver.api import grpc_service_pb2_grpc
+from tensorrtserver.api import request_status_pb2
+
+# graphdef_int32_int32_int32 uses the dynamic batcher with a preferred
+# batch size of 4 and a queue delay of 5 seconds.
+_batched_model = "graphdef_int32_int32_int32"
+_queue_delay_s = 5
+_models = { _batched_model : np.int32,
+            "graphdef_float32_float32_float32" : np.float32 }
+
+
+def _execution_count():
+    ctx = ServerStatusContext("localhost:8000", ProtocolType.HTTP,
+                              _batched_model)
+    status = ctx.get_server_status()
+    return status.model_status[_batched_model].version_status[1] \
+        .model_execution_count
+
+
+def _request(model_name, seed):
+    """Return the request header, inputs and expected outputs of a
+    request to version 1 of 'model_name', which produces the sum and
+    difference of its inputs."""
+    dtype = _models[model_name]
+    input0 = (np.arange(16) + seed).astype(dtype)
+    input1 = np.full(16, seed % 5, dtype=dtype)
+    header = api_pb2.InferRequestHeader()
+    header.batch_size = 1
+    header.input.add(name="INPUT0", batch_byte_size=input0.nbytes)
+    header.input.add(name="INPUT1", batch_byte_size=input1.nbytes)
+    header.output.add(name="OUTPUT0")
+    header.output.add(name="OUTPUT1")
+    return (model_name, header, (input0, input1),
+            (input0 + input1, input0 - input1))
+
+
+def _multi_infer_http(requests):
+    multi_header = api_pb2.MultiInferRequestHeader()
+    for model_name, header, _, _ in requests:
+        multi_header.request.add(model_name=model_name, model_version=1,
+                                 meta_data=header)
+    body = b"".join(i.tobytes() for _, _, inputs, _ in requests
+                    for i in inputs)
+    status, headers, content = hu.request(
+        "POST", "/api/multiinfer", body,
+        { "NV-MultiInferRequest-Binary" :
+          base64.b64encode(multi_header.SerializeToString()) })
+    if status != 200:
+        return status, headers, None
+
+    # Each response is the size-prefixed RequestStatus and
+    # InferResponseHeader followed by the size-prefixed raw output.
+    responses = []
+    offset = 0
+    while offset < len(content):
+        request_status = request_status_pb2.RequestStatus()
+        size = struct.unpack_from("<I", content, offset)[0]
+        request_status.ParseFromString(content[offset + 4:offset + 4 + size])
+        offset += 4 + size
+        size = struct.unpack_from("<I", content, offset)[0]
+        offset += 4 + size
+        size = struct.unpack_from("<Q", content, offset)[0]
+        raw = content[offset + 8:offset + 8 + size]
+        offset += 8 + size
+        responses.append((request_status.code, raw))
+    return status, headers, responses
+
+
+def _multi_infer_grpc(requests):
+    multi_request = grpc_service_pb2.MultiInferRequest()
+    for model_name, header, inputs, _ in requests:
+        request = multi_request.request.add(model_name=model_name,
+                                            model_version=1,
+                                            meta_data=header)
+        request.raw_input.extend([ i.tobytes() for i in inputs ])
+    channel = grpc.insecure_channel("localhost:8001")
+    stub = grpc_service_pb2_grpc.GRPCServiceStub(channel)
+    response = stub.MultiInfer(multi_request)
+    return response.request_status.code, \
+        [ (r.request_status.code, b"".join(r.raw_output))
+          for r in response.response ]
+
+
+class MultiInferTest(unittest.TestCase):
+
+    def _check(self, requests, responses):
+        self.assertEqual(len(responses), len(requests))
+        for (model_name, _, _, expected), (code, raw) in \
+                zip(requests, responses):
+            if expected is None:
+                self.assertNotEqual(code, request_status_pb2.SUCCESS)
+                continue
+            self.assertEqual(code, request_status_pb2.SUCCESS)
+            outputs = np.frombuffer(raw, dtype=_models[model_name])
+            self.assertTrue(np.array_equal(outputs[:16], expected[0]))
+            self.assertTrue(np.array_equal(outputs[16:], expected[1]))
+
+    def _run(self, protocol, requests):
+        if protocol == ProtocolType.HTTP:
+            status, headers, responses = _multi_infer_http(requests)
+            self.assertEqual(status, 200, headers.get('nv-status'))
+        else:
+            code, responses = _multi_infer_grpc(requests)
+            self.assertEqual(code, request_status_pb2.SUCCESS)
+        self._check(requests, responses)
+
+    def test_batched_on_completion(self):
+        # Three requests don't reach the preferred batch size, but they
+        # are batched together and scheduled as soon as all have been
+        # issued, without waiting for the queue delay.
+        for protocol in (ProtocolType.HTTP, ProtocolType.GRPC):
+            requests = [ _request(_batched_model, s) for s in range(3) ]
+            requests.append(_request("graphdef_float32_float32_float32", 7))
+            before = _execution_count()
+            start = time.time()
+            self._run(protocol, requests)
+            self.assertLess(time.time() - start, _queue_delay_s / 2.0)
+            self.assertEqual(_execution_count() - before, 1)
+
+    def test_preferred_batch(self):
+        # Eight requests form two batches of the preferred size.
+        for protocol in (ProtocolType.HTTP, ProtocolType.GRPC):
+            requests = [ _request(_batched_model, s) for s in range(8) ]
+            before = _execution_count()
+            start = time.time()
+            self._run(protocol, requests)
+            self.assertLess(time.time() - start, _queue_delay_s / 2.0)
+            self.assertEqual(_execution_count() - before, 2)
+
+    def test_failed_request(self):
+        # A request to an unknown model fails on its own. Its input
+        # size is taken from its header to find the following inputs.
+        for protocol in (ProtocolType.HTTP, ProtocolType.GRPC):
+            unknown = _request(_batched_model, 3)
+            unknown = ("unknown_model", unknown[1], unknown[2], None)
+            requests = [ _request(_batched_model, 1), unknown,
+                         _request("graphdef_float32_float32_float32", 2) ]
+            self._run(protocol, requests)
+
+    def test_empty(self):
+        status, headers, _ = _multi_infer_http([])
+        self.assertEqual(status, 400)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+        code, responses = _multi_infer_grpc([])
+        self.assertEqual(code, request_status_pb2.INVALID_ARG)
+        self.assertEqual(len(responses), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,157 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import re
+import unittest
+import numpy as np
+import http_util as hu
+
+_model_name = "graphdef_float32_float32_float32"
+
+
+def _to_bfloat16_bits(values):
+    # Round-to-nearest-even truncation of FP32 to the upper 16 bits.
+    bits = values.astype(np.float32).view(np.uint32).astype(np.uint64)
+    rounding = 0x7fff + ((bits >> 16) & 1)
+    return ((bits + rounding) >> 16).astype(np.uint16)
+
+
+def _output(name, data_type=None, conversion=None, cls=False):
+    text = 'output { name: "%s"' % name
+    if data_type is not None:
+        text += ' data_type: %s' % data_type
+    if conversion is not None:
+        text += ' conversion { %s }' % conversion
+    if cls:
+        text += ' cls { count: 1 }'
+    return text + ' } '
+
+
+def _infer(outputs, input0, input1, batch_size=1):
+    # Version 1 of the model produces the sum (OUTPUT0) and difference
+    # (OUTPUT1) of its inputs.
+    request_header = \
+        ('batch_size: %d input { name: "INPUT0" } ' % batch_size) + \
+        'input { name: "INPUT1" } ' + ''.join(outputs)
+    return hu.infer(_model_name, request_header,
+                    input0.tobytes() + input1.tobytes(), model_version=1)
+
+
+class OutputConversionTest(unittest.TestCase):
+
+    def _infer_ok(self, outputs, input0, input1, batch_size=1):
+        status, headers, body = _infer(outputs, input0, input1, batch_size)
+        self.assertEqual(status, 200, headers.get('nv-status'))
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        return headers, body
+
+    def test_fp16(self):
+        for batch_size in (1, 2):
+            input0 = np.linspace(-1000, 1000, 16 * batch_size,
+                                 dtype=np.float32)
+            input1 = np.full(16 * batch_size, 0.1, dtype=np.float32)
+            headers, body = self._infer_ok(
+                (_output("OUTPUT0", "TYPE_FP16"),), input0, input1,
+                batch_size)
+            self.assertTrue("data_type: TYPE_FP16" in
+                            headers["nv-inferresponse"])
+            self.assertEqual(len(body), batch_size * 16 * 2)
+            output0 = np.frombuffer(body, dtype=np.float16)
+            self.assertTrue(np.array_equal(
+                output0, (input0 + input1).astype(np.float16)))
+
+    def test_bf16(self):
+        input0 = np.array([ 0.0, 1.0, -1.0, 3.14159, -2.71828, 1e-3, 65504,
+                            1e30, -1e-30, 1.00390625, 1.01171875, 0.5,
+                            100.5, 255.0, 257.0, 7.0 ], dtype=np.float32)
+        input1 = np.zeros(16, dtype=np.float32)
+        headers, body = self._infer_ok(
+            (_output("OUTPUT0", "TYPE_BF16"),), input0, input1)
+        self.assertTrue("data_type: TYPE_BF16" in headers["nv-inferresponse"])
+        output0 = np.frombuffer(body, dtype=np.uint16)
+        self.assertTrue(np.array_equal(output0, _to_bfloat16_bits(input0)),
+                        "{} != {}".format(output0,
+                                          _to_bfloat16_bits(input0)))
+
+    def test_int8_quantize(self):
+        # FP32 in [-1, 1] quantized to INT8 with a scale of 127, rounding
+        # ties away from zero. Values outside the range saturate.
+        input0 = np.linspace(-1, 1, 16, dtype=np.float32)
+        input0[0] = -3.0
+        input0[15] = 3.0
+        input1 = np.zeros(16, dtype=np.float32)
+        _, body = self._infer_ok(
+            (_output("OUTPUT0", "TYPE_INT8", "scale: 127"),), input0, input1)
+        self.assertEqual(len(body), 16)
+        scaled = input0 * np.float32(127)
+        expected = np.clip(np.sign(scaled) * np.floor(np.abs(scaled) + 0.5),
+                           -128, 127)
+        self.assertTrue(np.array_equal(
+            np.frombuffer(body, dtype=np.int8), expected.astype(np.int8)))
+
+    def test_mixed(self):
+        # One output converted with an offset, the other returned as
+        # produced by the model.
+        input0 = np.arange(16, dtype=np.float32)
+        input1 = np.full(16, 2, dtype=np.float32)
+        headers, body = self._infer_ok(
+            (_output("OUTPUT0", "TYPE_UINT8", "scale: 2 offset: 10"),
+             _output("OUTPUT1")), input0, input1)
+        self.assertEqual(len(body), 16 + 16 * 4)
+        output0 = np.frombuffer(body[:16], dtype=np.uint8)
+        output1 = np.frombuffer(body[16:], dtype=np.float32)
+        self.assertTrue(np.array_equal(
+            output0, ((input0 + input1) * 2 + 10).astype(np.uint8)))
+        self.assertTrue(np.array_equal(output1, input0 - input1))
+
+        # Only the converted output reports a datatype.
+        response = headers["nv-inferresponse"]
+        self.assertEqual(len(re.findall(r'data_type:', response)), 1)
+
+    def test_same_data_type(self):
+        input0 = np.arange(16, dtype=np.float32)
+        input1 = np.ones(16, dtype=np.float32)
+        _, body = self._infer_ok((_output("OUTPUT0", "TYPE_FP32"),),
+                                 input0, input1)
+        self.assertTrue(np.array_equal(
+            np.frombuffer(body, dtype=np.float32), input0 + input1))
+
+    def _check_error(self, outputs):
+        zeros = np.zeros(16, dtype=np.float32)
+        status, headers, _ = _infer(outputs, zeros, zeros)
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+    def test_errors(self):
+        self._check_error((_output("OUTPUT0", "TYPE_STRING"),))
+        self._check_error((_output("OUTPUT0", "TYPE_BOOL"),))
+        self._check_error((_output("OUTPUT0", "TYPE_FP16", cls=True),))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,98 @@
+#!/bin/bash
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Compare the latency of requests sent to the server over TCP
+# loopback and over its Unix domain sockets, for both protocols.
+
+CLIENT_LOG="./perf_client.log"
+PERF_CLIENT=../clients/perf_client
+
+DATADIR=/data/inferenceserver/qa_model_repository
+MODEL=graphdef_int32_int32_int32
+
+HTTP_SOCKET=/tmp/trtserver_http.sock
+GRPC_SOCKET=/tmp/trtserver_grpc.sock
+
+SERVER=/opt/tensorrtserver/bin/trtserver
+SERVER_ARGS="--model-store=$DATADIR --http-unix-socket=$HTTP_SOCKET \
+             --grpc-unix-socket=$GRPC_SOCKET"
+SERVER_LOG="./inference_server.log"
+source ../common/util.sh
+
+rm -f $SERVER_LOG $CLIENT_LOG *.csv
+
+RET=0
+
+run_server
+if [ "$SERVER_PID" == "0" ]; then
+    echo -e "\n***\n*** Failed to start $SERVER\n***"
+    cat $SERVER_LOG
+    exit 1
+fi
+
+declare -A URLS=(
+    ["http_loopback"]="localhost:8000"
+    ["http_uds"]="unix:$HTTP_SOCKET"
+    ["grpc_loopback"]="localhost:8001"
+    ["grpc_uds"]="unix:$GRPC_SOCKET")
+
+for PROTOCOL in http grpc; do
+    for TRANSPORT in loopback uds; do
+        NAME=${PROTOCOL}_${TRANSPORT}
+        set +e
+        $PERF_CLIENT -i $PROTOCOL -u ${URLS[$NAME]} -m $MODEL -b 1 -t 1 \
+            -p5000 -f ${NAME}.csv >>$CLIENT_LOG 2>&1
+        if [ $? -ne 0 ]; then
+            cat $CLIENT_LOG
+            echo -e "\n***\n*** Test Failed: $NAME\n***"
+            RET=1
+        elif [ $(grep ": 0 infer/sec\|: 0 usec" $CLIENT_LOG | wc -l) -ne 0 ]; then
+            cat $CLIENT_LOG
+            echo -e "\n***\n*** Test Failed: $NAME reported no inferences\n***"
+            RET=1
+        fi
+        set -e
+
+        echo "=== $NAME"
+        cat ${NAME}.csv
+    done
+done
+
+kill $SERVER_PID
+wait $SERVER_PID
+
+# The server removes its HTTP socket file when it exits
+if [ -e $HTTP_SOCKET ]; then
+    echo -e "\n***\n*** Test Failed: $HTTP_SOCKET not removed\n***"
+    RET=1
+fi
+
+if [ $RET -eq 0 ]; then
+  echo -e "\n***\n*** Test Passed\n***"
+fi
+
+exit $RET
@@ -0,0 +1,107 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import unittest
+import numpy as np
+from tensorrtserver.api import *
+
+_model_name = "graphdef_int32_int32_int32"
+_model_version = 1
+_configs = (("localhost:8000", ProtocolType.HTTP),
+            ("localhost:8001", ProtocolType.GRPC))
+
+
+def _execution_count():
+    ctx = ServerStatusContext("localhost:8000", ProtocolType.HTTP, _model_name)
+    status = ctx.get_server_status()
+    version_status = \
+        status.model_status[_model_name].version_status[_model_version]
+    return version_status.model_execution_count
+
+
+class RequestCoalescingTest(unittest.TestCase):
+
+    def _infer_all(self, inputs):
+        # Send a request for each (input0, input1) pair in 'inputs',
+        # alternating between protocols, without waiting for any to
+        # complete. Then check that each got the sum and difference of
+        # its own inputs.
+        requests = []
+        for i, (input0, input1) in enumerate(inputs):
+            config = _configs[i % len(_configs)]
+            ctx = InferContext(config[0], config[1], _model_name,
+                               _model_version)
+            request_id = ctx.async_run(
+                { "INPUT0" : [ input0 ], "INPUT1" : [ input1 ] },
+                { "OUTPUT0" : InferContext.ResultFormat.RAW,
+                  "OUTPUT1" : InferContext.ResultFormat.RAW }, 1)
+            requests.append((ctx, request_id, input0, input1))
+
+        for ctx, request_id, input0, input1 in requests:
+            results = ctx.get_async_run_results(request_id, True)
+            self.assertTrue(np.array_equal(results["OUTPUT0"][0],
+                                           input0 + input1))
+            self.assertTrue(np.array_equal(results["OUTPUT1"][0],
+                                           input0 - input1))
+
+    def test_identical(self):
+        # Identical requests sent while the first is queued all share
+        # its single execution.
+        input0 = np.arange(16, dtype=np.int32)
+        input1 = np.ones(16, dtype=np.int32)
+        before = _execution_count()
+        self._infer_all([ (input0, input1) ] * 6)
+        self.assertEqual(_execution_count() - before, 1)
+
+    def test_distinct(self):
+        # Requests that differ in a single input element are not
+        # coalesced, each gets its own response. The four distinct
+        # requests are batched into one execution.
+        input0 = np.arange(16, dtype=np.int32)
+        inputs = []
+        for i in range(4):
+            input1 = np.zeros(16, dtype=np.int32)
+            input1[i] = 1
+            inputs.append((input0, input1))
+        before = _execution_count()
+        self._infer_all(inputs + inputs)
+        self.assertEqual(_execution_count() - before, 1)
+
+    def test_completed(self):
+        # Coalescing only applies while a request is in flight, a
+        # request identical to one that has completed executes again.
+        input0 = np.full(16, 7, dtype=np.int32)
+        input1 = np.full(16, 2, dtype=np.int32)
+        before = _execution_count()
+        self._infer_all([ (input0, input1) ])
+        self._infer_all([ (input0, input1) ])
+        self.assertEqual(_execution_count() - before, 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
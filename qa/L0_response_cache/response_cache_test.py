@@ -0,0 +1,138 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import unittest
+import numpy as np
+from tensorrtserver.api import *
+
+_model_name = "graphdef_int32_int32_int32"
+_model_version = 1
+_configs = (("localhost:8000", ProtocolType.HTTP),
+            ("localhost:8001", ProtocolType.GRPC))
+
+
+def _execution_count():
+    ctx = ServerStatusContext("localhost:8000", ProtocolType.HTTP, _model_name)
+    status = ctx.get_server_status()
+    version_status = \
+        status.model_status[_model_name].version_status[_model_version]
+    return version_status.model_execution_count
+
+
+class ResponseCacheTest(unittest.TestCase):
+
+    def _infer(self, input0, input1, config=_configs[0],
+               outputs=("OUTPUT0", "OUTPUT1"), batch_size=1):
+        ctx = InferContext(config[0], config[1], _model_name, _model_version)
+        output_req = {}
+        for name in outputs:
+            output_req[name] = InferContext.ResultFormat.RAW
+        results = ctx.run({ "INPUT0" : [ input0 ] * batch_size,
+                            "INPUT1" : [ input1 ] * batch_size },
+                          output_req, batch_size)
+
+        # Version 1 of the model produces the sum and difference of
+        # the inputs.
+        self.assertEqual(len(results), len(outputs))
+        for b in range(batch_size):
+            if "OUTPUT0" in outputs:
+                self.assertTrue(np.array_equal(results["OUTPUT0"][b],
+                                               input0 + input1))
+            if "OUTPUT1" in outputs:
+                self.assertTrue(np.array_equal(results["OUTPUT1"][b],
+                                               input0 - input1))
+        return ctx.get_last_request_id()
+
+    def _check_executions(self, fn, expected):
+        before = _execution_count()
+        fn()
+        self.assertEqual(_execution_count() - before, expected)
+
+    def test_hit(self):
+        # Only the first of several identical requests executes the
+        # model, over either protocol, and each response has its own
+        # request ID.
+        input0 = np.arange(16, dtype=np.int32)
+        input1 = np.full(16, 3, dtype=np.int32)
+        self._check_executions(lambda: self._infer(input0, input1), 1)
+
+        request_ids = set()
+        for config in _configs:
+            for _ in range(3):
+                self._check_executions(
+                    lambda: request_ids.add(
+                        self._infer(input0, input1, config)), 0)
+        self.assertEqual(len(request_ids), len(_configs) * 3)
+
+    def test_different_content(self):
+        # Requests that differ only in the content of one input, even
+        # by a single element, are not identical.
+        input0 = np.arange(16, dtype=np.int32) + 100
+        input1 = np.ones(16, dtype=np.int32)
+        self._check_executions(lambda: self._infer(input0, input1), 1)
+
+        for i in range(16):
+            changed = np.copy(input1)
+            changed[i] = 2
+            self._check_executions(lambda: self._infer(input0, changed), 1)
+
+        # Swapping the inputs gives a different request.
+        self._check_executions(lambda: self._infer(input1, input0), 1)
+
+    def test_different_request(self):
+        # The same input content with a different batch size or
+        # different requested outputs is not identical.
+        input0 = np.arange(16, dtype=np.int32) + 200
+        input1 = np.arange(16, dtype=np.int32)
+        self._check_executions(lambda: self._infer(input0, input1), 1)
+        self._check_executions(
+            lambda: self._infer(input0, input1, batch_size=2), 1)
+        self._check_executions(
+            lambda: self._infer(input0, input1, outputs=("OUTPUT0",)), 1)
+        self._check_executions(
+            lambda: self._infer(input0, input1, outputs=("OUTPUT1",)), 1)
+
+        # Each of which is now cached.
+        self._check_executions(
+            lambda: self._infer(input0, input1, batch_size=2), 0)
+        self._check_executions(
+            lambda: self._infer(input0, input1, outputs=("OUTPUT0",)), 0)
+
+    def test_eviction(self):
+        # The cache holds 1MB, filling it with more distinct requests
+        # than fit evicts the least recently used.
+        input1 = np.zeros(16, dtype=np.int32)
+        first = np.full(16, 1000, dtype=np.int32)
+        self._check_executions(lambda: self._infer(first, input1), 1)
+        for i in range(4096):
+            self._infer(np.full(16, 2000 + i, dtype=np.int32), input1)
+        self._check_executions(lambda: self._infer(first, input1), 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,192 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import unittest
+import numpy as np
+from tensorrtserver.api import *
+
+_model_name = "graphdef_int32_int32_int32"
+_model_version = 1
+_configs = (("localhost:8000", ProtocolType.HTTP),
+            ("localhost:8001", ProtocolType.GRPC))
+
+# Each input and output is 16 INT32 values per batch entry.
+_tensor_byte_size = 64
+
+
+class SharedMemoryTest(unittest.TestCase):
+
+    def setUp(self):
+        self.input_region_ = SharedMemoryRegion("/qa_shm_input", 1024)
+        self.output_region_ = SharedMemoryRegion("/qa_shm_output", 1024)
+
+    def tearDown(self):
+        for config in _configs:
+            SharedMemoryControlContext(config[0], config[1]).unregister_all()
+        self.input_region_.close()
+        self.output_region_.close()
+
+    def _register(self, config):
+        ctx = SharedMemoryControlContext(config[0], config[1])
+        ctx.register("input", "/qa_shm_input", 0, 1024)
+        ctx.register("output", "/qa_shm_output", 0, 1024)
+        return ctx
+
+    def _infer(self, config, inputs, outputs, batch_size=1):
+        ctx = InferContext(config[0], config[1], _model_name, _model_version)
+        return ctx.run(inputs, outputs, batch_size)
+
+    def test_inputs_and_outputs(self):
+        # Both inputs read from, and OUTPUT0 written to, shared
+        # memory. OUTPUT1 is returned in the response.
+        for config in _configs:
+            self._register(config)
+            for batch_size in (1, 4):
+                input0 = [ np.arange(16, dtype=np.int32) + b
+                           for b in range(batch_size) ]
+                input1 = [ np.full(16, 2 + b, dtype=np.int32)
+                           for b in range(batch_size) ]
+                batch_byte_size = batch_size * _tensor_byte_size
+                self.input_region_.set(input0 + input1)
+                results = self._infer(
+                    config,
+                    { "INPUT0" : SharedMemoryRange("input", 0,
+                                                   batch_byte_size),
+                      "INPUT1" : SharedMemoryRange("input", batch_byte_size,
+                                                   batch_byte_size) },
+                    { "OUTPUT0" : SharedMemoryRange("output", 64,
+                                                    batch_byte_size),
+                      "OUTPUT1" : InferContext.ResultFormat.RAW },
+                    batch_size)
+
+                self.assertFalse("OUTPUT0" in results)
+                output0 = self.output_region_.get(
+                    np.int32, [ batch_size, 16 ], offset=64)
+                for b in range(batch_size):
+                    self.assertTrue(np.array_equal(output0[b],
+                                                   input0[b] + input1[b]))
+                    self.assertTrue(np.array_equal(results["OUTPUT1"][b],
+                                                   input0[b] - input1[b]))
+            SharedMemoryControlContext(config[0], config[1]).unregister_all()
+
+    def test_mixed_inputs(self):
+        # One input in shared memory and one in the request.
+        for config in _configs:
+            self._register(config)
+            input0 = np.arange(16, dtype=np.int32)
+            input1 = np.full(16, 9, dtype=np.int32)
+            self.input_region_.set([ input1 ], offset=128)
+            results = self._infer(
+                config,
+                { "INPUT0" : [ input0 ],
+                  "INPUT1" : SharedMemoryRange("input", 128,
+                                               _tensor_byte_size) },
+                { "OUTPUT0" : InferContext.ResultFormat.RAW,
+                  "OUTPUT1" : InferContext.ResultFormat.RAW })
+            self.assertTrue(np.array_equal(results["OUTPUT0"][0],
+                                           input0 + input1))
+            self.assertTrue(np.array_equal(results["OUTPUT1"][0],
+                                           input0 - input1))
+
+    def _expect_infer_error(self, config, inputs, outputs, batch_size=1):
+        try:
+            self._infer(config, inputs, outputs, batch_size)
+            self.assertTrue(False, "expected inference to fail")
+        except InferenceServerException as ex:
+            self.assertTrue(len(ex.message()) > 0)
+
+    def test_invalid_ranges(self):
+        raw = { "OUTPUT0" : InferContext.ResultFormat.RAW,
+                "OUTPUT1" : InferContext.ResultFormat.RAW }
+        for config in _configs:
+            ctx = self._register(config)
+
+            # Unknown region.
+            self._expect_infer_error(
+                config,
+                { "INPUT0" : SharedMemoryRange("unknown", 0, 64),
+                  "INPUT1" : SharedMemoryRange("input", 64, 64) }, raw)
+
+            # Range past the end of the region.
+            self._expect_infer_error(
+                config,
+                { "INPUT0" : SharedMemoryRange("input", 1000, 64),
+                  "INPUT1" : SharedMemoryRange("input", 64, 64) }, raw)
+
+            # Range smaller than the input.
+            self._expect_infer_error(
+                config,
+                { "INPUT0" : SharedMemoryRange("input", 0, 32),
+                  "INPUT1" : SharedMemoryRange("input", 64, 64) }, raw)
+
+            # Output range too small for the output.
+            self._expect_infer_error(
+                config,
+                { "INPUT0" : SharedMemoryRange("input", 0, 64),
+                  "INPUT1" : SharedMemoryRange("input", 64, 64) },
+                { "OUTPUT0" : SharedMemoryRange("output", 0, 32),
+                  "OUTPUT1" : InferContext.ResultFormat.RAW })
+
+            # A region can't be used once unregistered.
+            ctx.unregister("input")
+            self._expect_infer_error(
+                config,
+                { "INPUT0" : SharedMemoryRange("input", 0, 64),
+                  "INPUT1" : SharedMemoryRange("input", 64, 64) }, raw)
+            ctx.unregister_all()
+
+    def test_register_errors(self):
+        for config in _configs:
+            ctx = SharedMemoryControlContext(config[0], config[1])
+
+            # Unknown shared-memory object.
+            try:
+                ctx.register("missing", "/qa_shm_missing", 0, 64)
+                self.assertTrue(False, "expected register to fail")
+            except InferenceServerException:
+                pass
+
+            # Region past the end of the object.
+            try:
+                ctx.register("big", "/qa_shm_input", 512, 1024)
+                self.assertTrue(False, "expected register to fail")
+            except InferenceServerException:
+                pass
+
+            # Duplicate name.
+            ctx.register("input", "/qa_shm_input", 0, 1024)
+            try:
+                ctx.register("input", "/qa_shm_input", 0, 512)
+                self.assertTrue(False, "expected register to fail")
+            except InferenceServerException:
+                pass
+            ctx.unregister_all()
+
+
+if __name__ == '__main__':
+    unittest.main()
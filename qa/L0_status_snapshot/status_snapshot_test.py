@@ -0,0 +1,157 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import time
+import unittest
+import grpc
+import numpy as np
+import http_util as hu
+from tensorrtserver.api import grpc_service_pb2
+from tensorrtserver.api import grpc_service_pb2_grpc
+from tensorrtserver.api import server_status_pb2
+
+# The server is started with a status snapshot interval of 2 seconds.
+_interval_s = 2.0
+_model_name = "graphdef_int32_int32_int32"
+
+
+def _get_status(headers={}):
+    """Return the HTTP status, ETag and ServerStatus of a status
+    request."""
+    status, response_headers, content = hu.request(
+        "GET", "/api/status?format=binary", headers=headers)
+    server_status = None
+    if status == 200:
+        server_status = server_status_pb2.ServerStatus()
+        server_status.ParseFromString(content)
+    return status, response_headers.get("etag"), server_status, content
+
+
+def _get_current_status():
+    """Return the ETag and ServerStatus of a snapshot that was just
+    taken, so that further status requests made within the interval
+    get the same snapshot even if the statistics change."""
+    # An inference made more than the interval ago makes the next
+    # status request replace the snapshot.
+    assert _infer() == (200, "SUCCESS")
+    time.sleep(_interval_s)
+    _, etag, server_status, _ = _get_status()
+    return etag, server_status
+
+
+def _execution_count(server_status):
+    return server_status.model_status[_model_name].version_status[1] \
+        .model_execution_count
+
+
+def _infer():
+    request_header = \
+        'batch_size: 1 input { name: "INPUT0" } input { name: "INPUT1" } ' \
+        'output { name: "OUTPUT0" }'
+    body = np.arange(16, dtype=np.int32).tobytes() * 2
+    status, headers, _ = hu.infer(_model_name, request_header, body,
+                                  model_version=1)
+    return status, hu.status_code(headers)
+
+
+class StatusSnapshotTest(unittest.TestCase):
+
+    def test_etag(self):
+        etag, server_status = _get_current_status()
+        self.assertEqual(etag, 'W/"%d"' % server_status.generation)
+
+        # The client already has the current generation.
+        status, etag1, _, content = _get_status({ "If-None-Match" : etag })
+        self.assertEqual(status, 304)
+        self.assertEqual(etag1, etag)
+        self.assertEqual(len(content), 0)
+
+        # A status from a different generation is returned.
+        status, etag2, server_status2, _ = _get_status(
+            { "If-None-Match" : 'W/"%d"' % (server_status.generation + 1000) })
+        self.assertEqual(status, 200)
+        self.assertEqual(etag2, etag)
+        self.assertEqual(server_status2.generation, server_status.generation)
+
+    def test_stats_refresh(self):
+        etag0, server_status0 = _get_current_status()
+        cnt0 = _execution_count(server_status0)
+
+        self.assertEqual(_infer(), (200, "SUCCESS"))
+
+        # Within the interval the statistics are not refreshed, so the
+        # snapshot and its execution count are unchanged.
+        status, etag1, server_status1, _ = _get_status()
+        self.assertEqual(status, 200)
+        self.assertEqual(etag1, etag0)
+        self.assertEqual(_execution_count(server_status1), cnt0)
+
+        # After the interval the snapshot is replaced with a later
+        # generation that includes the inference. The stale ETag no
+        # longer matches.
+        time.sleep(_interval_s)
+        status, etag2, server_status2, _ = _get_status(
+            { "If-None-Match" : etag0 })
+        self.assertEqual(status, 200)
+        self.assertNotEqual(etag2, etag0)
+        self.assertGreater(server_status2.generation,
+                           server_status0.generation)
+        self.assertEqual(_execution_count(server_status2), cnt0 + 1)
+
+    def test_poll_after_interval(self):
+        # Status requests record the server's own statistics, which
+        # don't replace the snapshot. So a client polling less often
+        # than the interval still gets 304 while no model changed.
+        etag, _ = _get_current_status()
+        for _ in range(3):
+            time.sleep(_interval_s)
+            status, etag1, _, content = _get_status({ "If-None-Match" : etag })
+            self.assertEqual(status, 304)
+            self.assertEqual(etag1, etag)
+            self.assertEqual(len(content), 0)
+
+    def test_grpc_known_generation(self):
+        _, server_status = _get_current_status()
+
+        stub = grpc_service_pb2_grpc.GRPCServiceStub(
+            grpc.insecure_channel("localhost:8001"))
+        response = stub.Status(grpc_service_pb2.StatusRequest(
+            known_generation=server_status.generation))
+        self.assertTrue(response.not_modified)
+        self.assertEqual(response.server_status.generation,
+                         server_status.generation)
+        self.assertEqual(len(response.server_status.model_status), 0)
+
+        # Zero always returns the status.
+        response = stub.Status(grpc_service_pb2.StatusRequest())
+        self.assertFalse(response.not_modified)
+        self.assertTrue(_model_name in response.server_status.model_status)
+
+
+if __name__ == '__main__':
+    unittest.main()
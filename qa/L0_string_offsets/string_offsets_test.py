@@ -0,0 +1,195 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+import sys
+sys.path.append("../common")
+
+import struct
+import unittest
+import numpy as np
+import http_util as hu
+
+# Version 1 of each model converts STRING inputs to integers and
+# produces the sum (OUTPUT0) and difference (OUTPUT1) of its two
+# 16-element inputs, converted to STRING for STRING outputs.
+
+
+def _encode_offsets(elements):
+    offsets = [0]
+    for e in elements:
+        offsets.append(offsets[-1] + len(e))
+    return struct.pack("<%dI" % (len(offsets) + 1), len(elements),
+                       *offsets) + b"".join(elements)
+
+
+def _decode_offsets(data):
+    """Return the elements at the start of 'data' and the size of their
+    encoding."""
+    cnt = struct.unpack_from("<I", data)[0]
+    offsets = struct.unpack_from("<%dI" % (cnt + 1), data, 4)
+    start = 4 * (cnt + 2)
+    elements = [ data[start + offsets[i]:start + offsets[i + 1]]
+                 for i in range(cnt) ]
+    return elements, start + offsets[cnt]
+
+
+def _decode_prefixed(data, cnt):
+    elements = []
+    offset = 0
+    for _ in range(cnt):
+        length = struct.unpack_from("<I", data, offset)[0]
+        elements.append(data[offset + 4:offset + 4 + length])
+        offset += 4 + length
+    return elements, offset
+
+
+def _strings(values):
+    return [ str(v).encode('utf-8') for v in values ]
+
+
+def _infer(model_name, batch_size, input0, input1, encoding=None):
+    # The inputs are delivered back-to-back in the body so the size of
+    # each is given in the request header.
+    request_header = 'batch_size: %d ' % batch_size
+    if encoding is not None:
+        request_header += 'string_encoding: %s ' % encoding
+    request_header += \
+        'input { name: "INPUT0" batch_byte_size: %d } ' \
+        'input { name: "INPUT1" batch_byte_size: %d } ' \
+        'output { name: "OUTPUT0" } output { name: "OUTPUT1" }' % \
+        (len(input0), len(input1))
+    return hu.infer(model_name, request_header, input0 + input1,
+                    model_version=1)
+
+
+class StringOffsetsTest(unittest.TestCase):
+
+    def _infer_ok(self, model_name, batch_size, input0, input1,
+                  encoding=None):
+        status, headers, content = _infer(model_name, batch_size, input0,
+                                          input1, encoding)
+        self.assertEqual(status, 200, headers.get('nv-status'))
+        self.assertEqual(hu.status_code(headers), "SUCCESS")
+        return content
+
+    def _values(self, batch_size):
+        in0 = np.arange(batch_size * 16, dtype=np.int32) * 1000
+        in1 = np.arange(batch_size * 16, dtype=np.int32) - 7
+        return in0, in1
+
+    def test_string_inputs_outputs(self):
+        for batch_size in (1, 4):
+            in0, in1 = self._values(batch_size)
+            content = self._infer_ok("graphdef_object_object_object",
+                                     batch_size,
+                                     _encode_offsets(_strings(in0)),
+                                     _encode_offsets(_strings(in1)),
+                                     "STRING_OFFSETS")
+            output0, size0 = _decode_offsets(content)
+            output1, size1 = _decode_offsets(content[size0:])
+            self.assertEqual(size0 + size1, len(content))
+            self.assertEqual(output0, _strings(in0 + in1))
+            self.assertEqual(output1, _strings(in0 - in1))
+
+    def test_empty_elements(self):
+        # Empty strings convert to zero.
+        elements = [ b"" ] * 16
+        in1 = np.arange(16, dtype=np.int32)
+        content = self._infer_ok("graphdef_object_object_object", 1,
+                                 _encode_offsets(elements),
+                                 _encode_offsets(_strings(in1)),
+                                 "STRING_OFFSETS")
+        output0, _ = _decode_offsets(content)
+        self.assertEqual(output0, _strings(in1))
+
+    def test_string_inputs(self):
+        in0, in1 = self._values(2)
+        content = self._infer_ok("graphdef_object_int32_int32", 2,
+                                 _encode_offsets(_strings(in0)),
+                                 _encode_offsets(_strings(in1)),
+                                 "STRING_OFFSETS")
+        outputs = np.frombuffer(content, dtype=np.int32)
+        self.assertTrue(np.array_equal(outputs[:32], in0 + in1))
+        self.assertTrue(np.array_equal(outputs[32:], in0 - in1))
+
+    def test_string_outputs(self):
+        in0, in1 = self._values(2)
+        content = self._infer_ok("graphdef_int32_int32_object", 2,
+                                 in0.tobytes(), in1.tobytes(),
+                                 "STRING_OFFSETS")
+        output0, size0 = _decode_offsets(content)
+        output1, size1 = _decode_offsets(content[size0:])
+        self.assertEqual(size0 + size1, len(content))
+        self.assertEqual(output0, _strings(in0 + in1))
+        self.assertEqual(output1, _strings(in0 - in1))
+
+    def test_length_prefixed(self):
+        # The default encoding is unchanged.
+        in0, in1 = self._values(1)
+        content = self._infer_ok("graphdef_int32_int32_object", 1,
+                                 in0.tobytes(), in1.tobytes())
+        output0, size0 = _decode_prefixed(content, 16)
+        output1, size1 = _decode_prefixed(content[size0:], 16)
+        self.assertEqual(size0 + size1, len(content))
+        self.assertEqual(output0, _strings(in0 + in1))
+        self.assertEqual(output1, _strings(in0 - in1))
+
+    def _check_error(self, input0):
+        input1 = _encode_offsets(_strings(range(16)))
+        status, headers, _ = _infer("graphdef_object_object_object", 1,
+                                    input0, input1, "STRING_OFFSETS")
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+    def test_malformed(self):
+        elements = _strings(range(16))
+        valid = _encode_offsets(elements)
+
+        # Wrong element count.
+        self._check_error(_encode_offsets(elements[:15]))
+        # First offset not zero.
+        self._check_error(struct.pack("<18I", 16, *([ 1 ] * 17)) + b"x")
+        # Offsets decreasing.
+        offsets = list(range(17))
+        offsets[8] = 20
+        self._check_error(struct.pack("<18I", 16, *offsets) + b"x" * 16)
+        # Last offset does not match the element bytes.
+        self._check_error(valid + b"x")
+        # Too small to hold the offsets.
+        self._check_error(valid[:20])
+
+    def test_unsupported_platform(self):
+        input0 = _encode_offsets(_strings(range(16)))
+        status, headers, _ = hu.infer(
+            "custom_identity_object",
+            'batch_size: 1 string_encoding: STRING_OFFSETS '
+            'input { name: "INPUT0" batch_byte_size: %d } '
+            'output { name: "OUTPUT0" }' % len(input0), input0)
+        self.assertNotEqual(status, 200)
+        self.assertEqual(hu.status_code(headers), "INVALID_ARG")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,137 @@
+#!/bin/bash
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+
+SIMPLE_CLIENT=../clients/simple_client
+SIMPLE_CLIENT_PY=../clients/simple_client.py
+
+CLIENT_LOG="./client.log"
+
+HTTP_SOCKET=/tmp/trtserver_l0_http.sock
+GRPC_SOCKET=/tmp/trtserver_l0_grpc.sock
+NOT_SOCKET=/tmp/trtserver_l0_not_a_socket
+
+SERVER=/opt/tensorrtserver/bin/trtserver
+SERVER_ARGS="--model-store=`pwd`/models --http-unix-socket=$HTTP_SOCKET \
+             --grpc-unix-socket=$GRPC_SOCKET"
+SERVER_LOG="./inference_server.log"
+source ../common/util.sh
+
+# Arguments for a second server that doesn't conflict with the ports
+# of the first.
+SECOND_SERVER_ARGS="--model-store=`pwd`/models --http-port=8010 \
+                    --grpc-port=8011 --metrics-port=8012"
+SECOND_SERVER_LOG="./second_server.log"
+
+rm -f $CLIENT_LOG $SERVER_LOG $SECOND_SERVER_LOG
+rm -f $HTTP_SOCKET $GRPC_SOCKET $NOT_SOCKET
+
+RET=0
+
+# Run the simple clients through both sockets.
+function run_clients() {
+    set +e
+    for PROTOCOL in http grpc; do
+        if [ "$PROTOCOL" == "http" ]; then
+            URL=unix:$HTTP_SOCKET
+        else
+            URL=unix:$GRPC_SOCKET
+        fi
+        $SIMPLE_CLIENT -i $PROTOCOL -u $URL -v >>$CLIENT_LOG 2>&1
+        if [ $? -ne 0 ]; then
+            cat $CLIENT_LOG
+            echo -e "\n***\n*** Test Failed: $SIMPLE_CLIENT $URL\n***"
+            RET=1
+        fi
+        python $SIMPLE_CLIENT_PY -i $PROTOCOL -u $URL -v >>$CLIENT_LOG 2>&1
+        if [ $? -ne 0 ]; then
+            cat $CLIENT_LOG
+            echo -e "\n***\n*** Test Failed: $SIMPLE_CLIENT_PY $URL\n***"
+            RET=1
+        fi
+    done
+    set -e
+}
+
+# Leave socket files behind as a server that did not exit cleanly
+# would. The server replaces them.
+python -c "import socket, sys
+for path in sys.argv[1:]:
+    s = socket.socket(socket.AF_UNIX)
+    s.bind(path)
+    s.close()" $HTTP_SOCKET $GRPC_SOCKET
+
+run_server
+if [ "$SERVER_PID" == "0" ]; then
+    echo -e "\n***\n*** Failed to start $SERVER with stale sockets\n***"
+    cat $SERVER_LOG
+    exit 1
+fi
+
+run_clients
+
+# A second server must fail to start rather than take over a socket
+# that the first server is listening on, or remove a file that is not
+# a socket.
+touch $NOT_SOCKET
+for ARGS in "--http-unix-socket=$HTTP_SOCKET" \
+            "--grpc-unix-socket=$GRPC_SOCKET" \
+            "--http-unix-socket=$NOT_SOCKET"; do
+    set +e
+    timeout 120 $SERVER $SECOND_SERVER_ARGS $ARGS >$SECOND_SERVER_LOG 2>&1
+    SECOND_RET=$?
+    set -e
+    if [ $SECOND_RET -eq 0 ] || [ $SECOND_RET -eq 124 ]; then
+        cat $SECOND_SERVER_LOG
+        echo -e "\n***\n*** Test Failed: second server started with $ARGS\n***"
+        RET=1
+    fi
+done
+
+if [ ! -f $NOT_SOCKET ]; then
+    echo -e "\n***\n*** Test Failed: $NOT_SOCKET removed\n***"
+    RET=1
+fi
+
+# The first server still serves both sockets.
+run_clients
+
+kill $SERVER_PID
+wait $SERVER_PID
+
+# The server removes its HTTP socket file when it exits
+if [ -e $HTTP_SOCKET ]; then
+    echo -e "\n***\n*** Test Failed: $HTTP_SOCKET not removed\n***"
+    RET=1
+fi
+
+rm -f $GRPC_SOCKET $NOT_SOCKET
+
+if [ $RET -eq 0 ]; then
+  echo -e "\n***\n*** Test Passed\n***"
+fi
+
+exit $RET
@@ -0,0 +1,68 @@
+# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+# Helpers for tests that need to send HTTP requests directly to the
+# inference server, to control headers and body in ways the client
+# library does not.
+
+import re
+try:
+    import http.client as httplib
+except ImportError:
+    import httplib
+
+
+def request(method, path, body=None, headers={}, url="localhost:8000"):
+    """Send a request and return the (HTTP status, headers, body) of the
+    response. Header names are lower-cased."""
+    conn = httplib.HTTPConnection(url)
+    try:
+        conn.request(method, path, body, headers)
+        response = conn.getresponse()
+        content = response.read()
+        response_headers = dict((k.lower(), v) for k, v in response.getheaders())
+        return (response.status, response_headers, content)
+    finally:
+        conn.close()
+
+
+def status_code(headers):
+    """Return the RequestStatusCode name from the NV-Status header of a
+    response."""
+    match = re.search(r'code: (\w+)', headers.get('nv-status', ''))
+    return match.group(1) if match else None
+
+
+def infer(model_name, request_header, body, headers={}, model_version=None,
+          url="localhost:8000"):
+    """Send an infer request with 'request_header', an InferRequestHeader
+    in text format, and return the (HTTP status, headers, body) of the
+    response."""
+    path = "/api/infer/" + model_name
+    if model_version is not None:
+        path += "/" + str(model_version)
+    all_headers = { "NV-InferRequest" : request_header }
+    all_headers.update(headers)
+    return request("POST", path, body, all_headers, url)
@@ -445,9 +445,30 @@ CustomBackend::Context::GetNextInput(
   const std::string name(cname);
   Scheduler::Payload* payload = input_context->payload_;
 
-  Status status = payload->request_provider_->GetNextInputContent(
-      name, content, content_byte_size, false);
-  return status.IsOk();
+  auto itr = input_context->input_blocks_.find(name);
+  if (itr == input_context->input_blocks_.end()) {
+    itr = input_context->input_blocks_
+              .emplace(name, std::make_pair(std::vector<iovec>(), 0))
+              .first;
+    Status status =
+        payload->request_provider_->GetInputBlocks(name, &itr->second.first);
+    if (!status.IsOk()) {
+      return false;
+    }
+  }
+
+  std::vector<iovec>& blocks = itr->second.first;
+  size_t& next_block = itr->second.second;
+  if (next_block >= blocks.size()) {
+    *content = nullptr;
+    *content_byte_size = 0;
+  } else {
+    *content = blocks[next_block].iov_base;
+    *content_byte_size = blocks[next_block].iov_len;
+    next_block++;
+  }
+
+  return true;
 }
 
 bool
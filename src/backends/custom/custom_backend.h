@@ -25,6 +25,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include <sys/uio.h>
+#include <unordered_map>
 #include "src/backends/custom/custom.h"
 #include "src/core/backend.h"
 #include "src/core/model_config.pb.h"
@@ -105,6 +107,12 @@ class CustomBackend : public InferenceBackend {
       }
       CustomBackend::Context* context_;
       Scheduler::Payload* payload_;
+
+      // The blocks of each input, fetched from the request provider
+      // on the first request for the input, and the index of the
+      // next block to return.
+      std::unordered_map<std::string, std::pair<std::vector<iovec>, size_t>>
+          input_blocks_;
     };
 
     // Callback used by custom backends to get the next block of input
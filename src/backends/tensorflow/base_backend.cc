@@ -26,7 +26,7 @@
 
 #include "src/backends/tensorflow/base_backend.h"
 
-#include <set>
+#include <limits>
 #include "cuda/include/cuda_runtime_api.h"
 #include "src/backends/tensorflow/tf_utils.h"
 #include "src/core/constants.h"
@@ -35,6 +35,7 @@
 #include "src/core/model_config_utils.h"
 #include "src/core/provider.h"
 #include "src/core/server_status.h"
+#include "src/core/string_offsets.h"
 #include "tensorflow/c/c_api.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/default_device.h"
@@ -242,10 +243,28 @@ BaseBackend::Run(
 
 namespace {
 
+// Get the next chunk of content for an input. Inputs that are in the
+// model configuration are found by ordinal and others, like sequence
+// control inputs, by name.
+Status
+GetNextInputContent(
+    InferRequestProvider* provider, const std::string& input_name,
+    const int input_ordinal, const void** content, size_t* content_byte_size)
+{
+  if (input_ordinal < 0) {
+    return provider->GetNextInputContent(
+        input_name, content, content_byte_size, false);
+  }
+
+  return provider->GetNextInputContent(
+      (uint32_t)input_ordinal, content, content_byte_size, false);
+}
+
 void
 SetFixedSizedInputTensor(
     tensorflow::Tensor& tensor, const std::string& input_name,
-    const size_t batch1_byte_size, std::vector<Scheduler::Payload>* payloads)
+    const int input_ordinal, const size_t batch1_byte_size,
+    std::vector<Scheduler::Payload>* payloads)
 {
   auto flat = tensor.bit_casted_shaped<char, 1>(
       {tensor.NumElements() * tensorflow::DataTypeSize(tensor.dtype())});
@@ -264,8 +283,9 @@ SetFixedSizedInputTensor(
     while (payload.status_.IsOk()) {
       const void* content;
       size_t content_byte_size = expected_byte_size - copied_byte_size;
-      payload.status_ = payload.request_provider_->GetNextInputContent(
-          input_name, &content, &content_byte_size, false);
+      payload.status_ = GetNextInputContent(
+          payload.request_provider_.get(), input_name, input_ordinal, &content,
+          &content_byte_size);
       if (!payload.status_.IsOk()) {
         break;
       }
@@ -317,10 +337,80 @@ FillStringTensor(tensorflow::Tensor& tensor, const size_t idx, const size_t cnt)
   }
 }
 
+// Copy 'byte_size' bytes starting at 'block_idx' and 'block_offset'
+// in 'blocks' into 'dst', advancing 'block_idx' and 'block_offset'
+// past the copied bytes. The bytes must be available in 'blocks'.
+void
+CopyFromBlocks(
+    const std::vector<struct iovec>& blocks, size_t* block_idx,
+    size_t* block_offset, size_t byte_size, char* dst)
+{
+  while (byte_size > 0) {
+    const struct iovec& block = blocks[*block_idx];
+    const size_t cnt = std::min(byte_size, block.iov_len - *block_offset);
+    memcpy(dst, static_cast<const char*>(block.iov_base) + *block_offset, cnt);
+    dst += cnt;
+    byte_size -= cnt;
+    *block_offset += cnt;
+    if (*block_offset == block.iov_len) {
+      (*block_idx)++;
+      *block_offset = 0;
+    }
+  }
+}
+
+// Assign the 'element_cnt' strings of the input of 'payload', encoded
+// with STRING_OFFSETS, to 'tensor' starting at 'tensor_element_idx'.
+// Each element is located directly from its offsets.
+Status
+SetStringInputElementsFromOffsets(
+    tensorflow::Tensor& tensor, const size_t tensor_element_idx,
+    const size_t element_cnt, const std::string& input_name,
+    const int input_ordinal, Scheduler::Payload& payload)
+{
+  // The offsets can only be indexed if the whole input is contiguous,
+  // the provider copies it only if it is split across blocks.
+  const void* content;
+  size_t content_byte_size = std::numeric_limits<size_t>::max();
+  RETURN_IF_ERROR(
+      (input_ordinal < 0)
+          ? payload.request_provider_->GetNextInputContent(
+                input_name, &content, &content_byte_size,
+                true /* force_contiguous */)
+          : payload.request_provider_->GetNextInputContent(
+                (uint32_t)input_ordinal, &content, &content_byte_size,
+                true /* force_contiguous */));
+  if (content == nullptr) {
+    content = "";
+    content_byte_size = 0;
+  }
+
+  const char* offsets;
+  const char* data;
+  Status status = ParseStringOffsets(
+      static_cast<const char*>(content), content_byte_size, element_cnt,
+      &offsets, &data);
+  if (!status.IsOk()) {
+    return Status(
+        status.Code(),
+        status.Message() + " for inference input '" + input_name + "'");
+  }
+
+  auto flat = tensor.flat<std::string>();
+  for (size_t e = 0; e < element_cnt; ++e) {
+    const uint32_t start = StringOffsetAt(offsets, e);
+    flat(tensor_element_idx + e)
+        .assign(data + start, StringOffsetAt(offsets, e + 1) - start);
+  }
+
+  return Status::Success;
+}
+
 void
 SetStringInputTensor(
     tensorflow::Tensor& tensor, const std::string& input_name,
-    const size_t batch1_element_cnt, std::vector<Scheduler::Payload>* payloads)
+    const int input_ordinal, const size_t batch1_element_cnt,
+    std::vector<Scheduler::Payload>* payloads)
 {
   auto flat = tensor.flat<std::string>();
   size_t tensor_element_idx = 0;
@@ -335,10 +425,27 @@ SetStringInputTensor(
         request_header.batch_size() * batch1_element_cnt;
     size_t element_idx = 0;
 
-    const void* vcontent;
-    size_t content_byte_size = expected_element_cnt * sizeof(uint32_t);
-    payload.status_ = payload.request_provider_->GetNextInputContent(
-        input_name, &vcontent, &content_byte_size, true);
+    if (request_header.string_encoding() ==
+        InferRequestHeader::STRING_OFFSETS) {
+      payload.status_ = SetStringInputElementsFromOffsets(
+          tensor, tensor_element_idx, expected_element_cnt, input_name,
+          input_ordinal, payload);
+      if (!payload.status_.IsOk()) {
+        FillStringTensor(tensor, tensor_element_idx, expected_element_cnt);
+      }
+      tensor_element_idx += expected_element_cnt;
+      continue;
+    }
+
+    // The content may be split across multiple blocks and a string
+    // may span a block boundary, so parse the blocks in place rather
+    // than copying them into a single contiguous buffer.
+    std::vector<struct iovec> blocks;
+    payload.status_ =
+        (input_ordinal < 0)
+            ? payload.request_provider_->GetInputBlocks(input_name, &blocks)
+            : payload.request_provider_->GetInputBlocks(
+                  (uint32_t)input_ordinal, &blocks);
     if (!payload.status_.IsOk()) {
       FillStringTensor(
           tensor, tensor_element_idx + element_idx,
@@ -346,7 +453,13 @@ SetStringInputTensor(
       continue;
     }
 
-    const char* content = reinterpret_cast<const char*>(vcontent);
+    size_t content_byte_size = 0;
+    for (const auto& block : blocks) {
+      content_byte_size += block.iov_len;
+    }
+
+    size_t block_idx = 0;
+    size_t block_offset = 0;
 
     // Parse content and assign them to the 'tensor'. Each string
     // in 'content' is a 4-byte length followed by the string
@@ -365,8 +478,10 @@ SetStringInputTensor(
         break;
       }
 
-      const uint32_t len = *(reinterpret_cast<const uint32_t*>(content));
-      content += sizeof(uint32_t);
+      uint32_t len;
+      CopyFromBlocks(
+          blocks, &block_idx, &block_offset, sizeof(uint32_t),
+          reinterpret_cast<char*>(&len));
       content_byte_size -= sizeof(uint32_t);
 
       if (content_byte_size < len) {
@@ -382,11 +497,13 @@ SetStringInputTensor(
         break;
       }
 
-      std::string str(content, len);
-      content += len;
+      std::string& str = flat(tensor_element_idx + element_idx);
+      str.resize(len);
+      if (len > 0) {
+        CopyFromBlocks(blocks, &block_idx, &block_offset, len, &str[0]);
+      }
       content_byte_size -= len;
 
-      flat(tensor_element_idx + element_idx) = str;
       element_idx++;
     }
 
@@ -408,7 +525,8 @@ SetStringInputTensor(
 void
 ReadFixedSizedOutputTensor(
     tensorflow::Tensor& tensor, const std::string& output_name,
-    const std::vector<int64_t>& shape, const size_t batch1_byte_size,
+    const uint32_t output_ordinal, const std::vector<int64_t>& shape,
+    const size_t batch1_byte_size,
     std::vector<Scheduler::Payload>* payloads)
 {
   const auto& flat = tensor.bit_casted_shaped<char, 1>(
@@ -425,7 +543,7 @@ ReadFixedSizedOutputTensor(
     // GPU. If it did not request this output then just skip it in
     // the output buffer.
     if ((payload.response_provider_ != nullptr) &&
-        payload.response_provider_->RequiresOutput(output_name)) {
+        payload.response_provider_->RequiresOutput(output_ordinal)) {
       void* content = nullptr;
       Status status = payload.response_provider_->AllocateOutputBuffer(
           output_name, &content, expected_byte_size, shape);
@@ -454,7 +572,8 @@ ReadFixedSizedOutputTensor(
 void
 ReadStringOutputTensor(
     tensorflow::Tensor& tensor, const std::string& output_name,
-    const std::vector<int64_t>& shape, const size_t batch1_element_cnt,
+    const uint32_t output_ordinal, const std::vector<int64_t>& shape,
+    const size_t batch1_element_cnt,
     std::vector<Scheduler::Payload>* payloads)
 {
   auto flat = tensor.flat<std::string>();
@@ -470,28 +589,54 @@ ReadStringOutputTensor(
     // GPU. If it did not request this output then just skip it in
     // the output tensor.
     if ((payload.response_provider_ != nullptr) &&
-        payload.response_provider_->RequiresOutput(output_name)) {
-      // Serialize the output tensor strings. Each string is
-      // serialized as a 4-byte length followed by the string itself
-      // with no null-terminator.
-      std::string serialized;
+        payload.response_provider_->RequiresOutput(output_ordinal)) {
+      // Size the output so that the strings can be serialized
+      // directly into the output buffer.
+      size_t data_byte_size = 0;
       for (size_t e = 0; e < expected_element_cnt; ++e) {
-        std::string& str = flat(tensor_element_idx + e);
-        const uint32_t len = str.size();
-        serialized.append(
-            reinterpret_cast<const char*>(&len), sizeof(uint32_t));
-        serialized.append(str);
+        data_byte_size += flat(tensor_element_idx + e).size();
       }
 
+      const bool use_offsets = (request_header.string_encoding() ==
+                                InferRequestHeader::STRING_OFFSETS);
+      const size_t byte_size =
+          (use_offsets)
+              ? StringOffsetsByteSize(expected_element_cnt, data_byte_size)
+              : (expected_element_cnt * sizeof(uint32_t)) + data_byte_size;
+
       void* content;
       Status status = payload.response_provider_->AllocateOutputBuffer(
-          output_name, &content, serialized.size(), shape);
-      if (status.IsOk()) {
-        memcpy(
-            content, reinterpret_cast<const void*>(serialized.c_str()),
-            serialized.size());
-      } else {
+          output_name, &content, byte_size, shape);
+      if (!status.IsOk()) {
         payload.status_ = status;
+      } else if (content != nullptr) {
+        char* buffer = static_cast<char*>(content);
+        if (use_offsets) {
+          // Element count, then the offsets of all elements, then the
+          // bytes of all elements.
+          SetStringOffsetAt(buffer, 0, expected_element_cnt);
+          char* offsets = buffer + sizeof(uint32_t);
+          char* data = buffer + StringOffsetsByteSize(expected_element_cnt, 0);
+          uint32_t offset = 0;
+          for (size_t e = 0; e < expected_element_cnt; ++e) {
+            const std::string& str = flat(tensor_element_idx + e);
+            SetStringOffsetAt(offsets, e, offset);
+            memcpy(data + offset, str.data(), str.size());
+            offset += str.size();
+          }
+          SetStringOffsetAt(offsets, expected_element_cnt, offset);
+        } else {
+          // Each string is serialized as a 4-byte length followed by
+          // the string itself with no null-terminator.
+          for (size_t e = 0; e < expected_element_cnt; ++e) {
+            const std::string& str = flat(tensor_element_idx + e);
+            const uint32_t len = str.size();
+            memcpy(buffer, &len, sizeof(uint32_t));
+            buffer += sizeof(uint32_t);
+            memcpy(buffer, str.data(), len);
+            buffer += len;
+          }
+        }
       }
     }
 
@@ -503,9 +648,9 @@ ReadStringOutputTensor(
 
 void
 BaseBackend::Context::SetInput(
-    const std::string& name, const DataType datatype, const DimsList& dims,
-    const size_t total_batch_size, std::vector<Scheduler::Payload>* payloads,
-    TensorVec* input_tensors)
+    const std::string& name, const int ordinal, const DataType datatype,
+    const DimsList& dims, const size_t total_batch_size,
+    std::vector<Scheduler::Payload>* payloads, TensorVec* input_tensors)
 {
   const tensorflow::DataType dtype = ConvertDataType(datatype);
 
@@ -538,9 +683,10 @@ BaseBackend::Context::SetInput(
   if (dtype != tensorflow::DT_STRING) {
     const size_t batch1_byte_size =
         batch1_element_cnt * tensorflow::DataTypeSize(dtype);
-    SetFixedSizedInputTensor(tensor, name, batch1_byte_size, payloads);
+    SetFixedSizedInputTensor(
+        tensor, name, ordinal, batch1_byte_size, payloads);
   } else {
-    SetStringInputTensor(tensor, name, batch1_element_cnt, payloads);
+    SetStringInputTensor(tensor, name, ordinal, batch1_element_cnt, payloads);
   }
 }
 
@@ -594,16 +740,16 @@ BaseBackend::Context::Run(
   // into the corresponding tensor.
   TensorVec input_tensors;
 
-  // Inputs from the request...
-  for (const auto& input : input_request_provider->RequestHeader().input()) {
-    const std::string& name = input.name();
-
-    const ModelInput* input_config;
-    RETURN_IF_ERROR(base->GetInput(name, &input_config));
+  // Inputs from the request. Every payload resolves its inputs to
+  // the same model configuration ordinals.
+  for (const uint32_t ordinal : input_request_provider->Ordinals().inputs_) {
+    const ModelInput& input_config = base->Config().input(ordinal);
+    const InferRequestHeader::Input* input =
+        input_request_provider->RequestInput(ordinal);
 
     SetInput(
-        name, input_config->data_type(), input.dims(), total_batch_size,
-        payloads, &input_tensors);
+        input_config.name(), ordinal, input_config.data_type(), input->dims(),
+        total_batch_size, payloads, &input_tensors);
   }
 
   // Additional inputs added to the provider...
@@ -615,28 +761,32 @@ BaseBackend::Context::Run(
       const std::shared_ptr<InferRequestProvider::InputOverride>& override =
           pr.second;
       SetInput(
-          name, override->datatype_, override->dims_, total_batch_size,
-          payloads, &input_tensors);
+          name, NO_ORDINAL, override->datatype_, override->dims_,
+          total_batch_size, payloads, &input_tensors);
     }
   }
 
-  // Collect the names of outputs requested by any request
-  // payload. Skip payloads that have an error.
-  std::set<std::string> required_outputs;
+  // Collect the ordinals of outputs requested by any request
+  // payload.
+  std::vector<bool> required_outputs(base->Config().output_size(), false);
   for (auto& payload : *payloads) {
-    const InferRequestHeader& request_header =
-        payload.request_provider_->RequestHeader();
-    for (const auto& output : request_header.output()) {
-      required_outputs.insert(output.name());
+    for (const uint32_t ordinal :
+         payload.request_provider_->Ordinals().outputs_) {
+      required_outputs[ordinal] = true;
     }
   }
 
   // Create the vector of required output names using the names
   // expected by the model.
-  std::vector<std::string> model_output_names;
+  std::vector<uint32_t> model_output_ordinals;
   std::vector<std::string> output_names;
-  for (const auto& name : required_outputs) {
-    model_output_names.push_back(name);
+  for (size_t ordinal = 0; ordinal < required_outputs.size(); ++ordinal) {
+    if (!required_outputs[ordinal]) {
+      continue;
+    }
+
+    model_output_ordinals.push_back(ordinal);
+    const std::string& name = base->Config().output(ordinal).name();
     const auto& tn_itr = output_name_map_.find(name);
     if (tn_itr == output_name_map_.end()) {
       output_names.push_back(name);
@@ -652,9 +802,9 @@ BaseBackend::Context::Run(
   // Make sure each output is of the expected size and copy it into
   // the appropriate response providers.
   int output_idx = 0;
-  for (const auto& name : model_output_names) {
-    const ModelOutput* output_config;
-    RETURN_IF_ERROR(base->GetOutput(name, &output_config));
+  for (const uint32_t ordinal : model_output_ordinals) {
+    const ModelOutput* output_config = &base->Config().output(ordinal);
+    const std::string& name = output_config->name();
 
     // Get the shape of the output from the output tensor.
     std::vector<int64_t> shape;
@@ -684,10 +834,12 @@ BaseBackend::Context::Run(
       const size_t batch1_byte_size =
           batch1_element_cnt * tensorflow::DataTypeSize(dtype);
       ReadFixedSizedOutputTensor(
-          outputs[output_idx], name, shape, batch1_byte_size, payloads);
+          outputs[output_idx], name, ordinal, shape, batch1_byte_size,
+          payloads);
     } else {
       ReadStringOutputTensor(
-          outputs[output_idx], name, shape, batch1_element_cnt, payloads);
+          outputs[output_idx], name, ordinal, shape, batch1_element_cnt,
+          payloads);
     }
 
     output_idx++;
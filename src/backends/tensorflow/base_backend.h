@@ -70,6 +70,10 @@ class BaseBackend : public InferenceBackend {
     // Max batch size value that indicates batching is not supported.
     static constexpr int NO_BATCHING = 0;
 
+    // Input ordinal that indicates an input is not in the model
+    // configuration, for example a sequence control input.
+    static constexpr int NO_ORDINAL = -1;
+
     Context(
         const std::string& name, const int gpu_device,
         const int max_batch_size);
@@ -81,10 +85,11 @@ class BaseBackend : public InferenceBackend {
     // Create TF tensor for an input.
     using TensorVec = std::vector<std::pair<std::string, tensorflow::Tensor>>;
 
-    // Set an input tensor data from payloads.
+    // Set an input tensor data from payloads. 'ordinal' is the
+    // model configuration ordinal of the input or NO_ORDINAL.
     void SetInput(
-        const std::string& name, const DataType datatype, const DimsList& dims,
-        const size_t total_batch_size,
+        const std::string& name, const int ordinal, const DataType datatype,
+        const DimsList& dims, const size_t total_batch_size,
         std::vector<Scheduler::Payload>* payloads, TensorVec* input_tensors);
 
     // Run model to execute for one or more requests. This function
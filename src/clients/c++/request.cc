@@ -33,6 +33,7 @@ namespace nvidia { namespace inferenceserver { namespace client {
 ProfileContext::~ProfileContext() {}
 ServerHealthContext::~ServerHealthContext() {}
 ServerStatusContext::~ServerStatusContext() {}
+SharedMemoryControlContext::~SharedMemoryControlContext() {}
 InferContext::Input::~Input() {}
 InferContext::Output::~Output() {}
 InferContext::Result::~Result() {}
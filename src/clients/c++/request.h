@@ -318,6 +318,22 @@ class InferContext {
     /// \param input The vector holding tensor string values.
     /// \return Error object indicating success or failure.
     virtual Error SetFromString(const std::vector<std::string>& input) = 0;
+
+    /// Set tensor values for this input to be read by the server
+    /// directly from a shared-memory region registered with
+    /// SharedMemoryControlContext::RegisterSharedMemory(). The region
+    /// must hold the tensor values for the entire batch of this input
+    /// and so this function is called once instead of batch-size
+    /// times. Calling SetRaw() or SetFromString() after this function
+    /// switches the input back to sending its values in the request.
+    /// \param name The name of the registered shared-memory region.
+    /// \param offset The offset, in bytes, of the tensor values from
+    /// the start of the region.
+    /// \param byte_size The size, in bytes, of the tensor values for
+    /// the entire batch.
+    /// \return Error object indicating success or failure.
+    virtual Error SetSharedMemory(
+        const std::string& name, size_t offset, size_t byte_size) = 0;
   };
 
   //==============
@@ -504,6 +520,22 @@ class InferContext {
     /// \return Error object indicating success or failure.
     virtual Error AddClassResult(
         const std::shared_ptr<InferContext::Output>& output, uint64_t k) = 0;
+
+    /// Add 'output' to the list of requested results that the server
+    /// writes directly into a shared-memory region registered with
+    /// SharedMemoryControlContext::RegisterSharedMemory(). The
+    /// output's full tensor for the entire batch is written into the
+    /// region and Run() does not return a result for the output.
+    /// \param output The output.
+    /// \param name The name of the registered shared-memory region.
+    /// \param offset The offset, in bytes, at which to write the
+    /// tensor values from the start of the region.
+    /// \param byte_size The size, in bytes, of the space available for
+    /// the tensor values.
+    /// \return Error object indicating success or failure.
+    virtual Error AddSharedMemoryResult(
+        const std::shared_ptr<InferContext::Output>& output,
+        const std::string& name, size_t offset, size_t byte_size) = 0;
   };
 
   //==============
@@ -678,6 +710,66 @@ class ProfileContext {
   virtual Error StopProfile() = 0;
 };
 
+//==============================================================================
+/// A SharedMemoryControlContext object is used to register and
+/// unregister system shared-memory regions with the inference
+/// server. A registered region can then be used by inputs and outputs
+/// of inference requests to exchange tensor values with the server
+/// without copying them into the request or response (see
+/// InferContext::Input::SetSharedMemory() and
+/// InferContext::Options::AddSharedMemoryResult()). Shared-memory
+/// regions can only be used when the client and server are on the
+/// same host. Once created a SharedMemoryControlContext object can be
+/// used repeatedly.
+///
+/// A SharedMemoryControlContext object can use either HTTP protocol
+/// or GRPC protocol depending on the Create function
+/// (SharedMemoryControlHttpContext::Create or
+/// SharedMemoryControlGrpcContext::Create). For example:
+///
+/// \code
+///   int shm_fd;
+///   CreateSharedMemoryRegion("/input_data", 1024, &shm_fd);
+///   std::unique_ptr<SharedMemoryControlContext> ctx;
+///   SharedMemoryControlGrpcContext::Create(&ctx, "localhost:8001");
+///   ctx->RegisterSharedMemory("input_data", "/input_data", 0, 1024);
+///   ...
+///   ctx->UnregisterSharedMemory("input_data");
+/// \endcode
+///
+/// \note
+///   SharedMemoryControlContext::Create methods are thread-safe. The
+///   register and unregister methods are not thread-safe. For a given
+///   SharedMemoryControlContext, calls to these methods must be
+///   serialized.
+///
+class SharedMemoryControlContext {
+ public:
+  virtual ~SharedMemoryControlContext() = 0;
+
+  /// Register a shared-memory region with the inference server.
+  /// \param name The name used to refer to the region in inference
+  /// requests.
+  /// \param shm_key The key of the POSIX shared-memory object that
+  /// holds the region, as given to shm_open().
+  /// \param offset The offset, in bytes, of the region from the start
+  /// of the shared-memory object.
+  /// \param byte_size The size, in bytes, of the region.
+  /// \return Error object indicating success or failure.
+  virtual Error RegisterSharedMemory(
+      const std::string& name, const std::string& shm_key, size_t offset,
+      size_t byte_size) = 0;
+
+  /// Unregister a shared-memory region from the inference server.
+  /// \param name The name of the region to unregister.
+  /// \return Error object indicating success or failure.
+  virtual Error UnregisterSharedMemory(const std::string& name) = 0;
+
+  /// Unregister all shared-memory regions from the inference server.
+  /// \return Error object indicating success or failure.
+  virtual Error UnregisterAllSharedMemory() = 0;
+};
+
 //==============================================================================
 
 std::ostream& operator<<(std::ostream&, const Error&);
@@ -118,6 +118,26 @@ OptionsImpl::AddClassResult(
   return Error::Success;
 }
 
+Error
+OptionsImpl::AddSharedMemoryResult(
+    const std::shared_ptr<InferContext::Output>& output,
+    const std::string& name, size_t offset, size_t byte_size)
+{
+  if (name.empty()) {
+    return Error(
+        RequestStatusCode::INVALID_ARG,
+        "shared memory region name must be specified for output '" +
+            output->Name() + "'");
+  }
+
+  OutputOptions ooptions(InferContext::Result::ResultFormat::RAW);
+  ooptions.shm_name = name;
+  ooptions.shm_offset = offset;
+  ooptions.shm_byte_size = byte_size;
+  outputs_.emplace_back(std::make_pair(output, ooptions));
+  return Error::Success;
+}
+
 Error
 InferContext::Options::Create(std::unique_ptr<InferContext::Options>* options)
 {
@@ -129,7 +149,7 @@ InferContext::Options::Create(std::unique_ptr<InferContext::Options>* options)
 
 InputImpl::InputImpl(const ModelInput& mio)
     : mio_(mio), total_byte_size_(0), needs_shape_(false), batch_size_(0),
-      bufs_idx_(0), buf_pos_(0)
+      bufs_idx_(0), buf_pos_(0), shm_offset_(0)
 {
   if (GetElementCount(mio) == -1) {
     byte_size_ = -1;
@@ -144,7 +164,8 @@ InputImpl::InputImpl(const InputImpl& obj)
       total_byte_size_(obj.total_byte_size_), needs_shape_(obj.needs_shape_),
       shape_(obj.shape_), batch_size_(obj.batch_size_), bufs_idx_(0),
       buf_pos_(0), bufs_(obj.bufs_), buf_byte_sizes_(obj.buf_byte_sizes_),
-      str_bufs_(obj.str_bufs_)
+      str_bufs_(obj.str_bufs_), shm_name_(obj.shm_name_),
+      shm_offset_(obj.shm_offset_)
 {
 }
 
@@ -172,6 +193,13 @@ InputImpl::SetShape(const std::vector<int64_t>& dims)
 Error
 InputImpl::SetRaw(const uint8_t* input, size_t input_byte_size)
 {
+  // Values set in the request replace any shared-memory region.
+  if (UsesSharedMemory()) {
+    shm_name_.clear();
+    shm_offset_ = 0;
+    total_byte_size_ = 0;
+  }
+
   if (needs_shape_) {
     bufs_.clear();
     buf_byte_sizes_.clear();
@@ -264,6 +292,44 @@ InputImpl::SetFromString(const std::vector<std::string>& input)
   return SetRaw(reinterpret_cast<const uint8_t*>(&sbuf[0]), sbuf.size());
 }
 
+Error
+InputImpl::SetSharedMemory(
+    const std::string& name, size_t offset, size_t byte_size)
+{
+  if (name.empty()) {
+    return Error(
+        RequestStatusCode::INVALID_ARG,
+        "shared memory region name must be specified for input '" + Name() +
+            "'");
+  }
+
+  if (needs_shape_) {
+    return Error(
+        RequestStatusCode::INVALID_ARG,
+        "must set shape for variable-size input '" + Name() +
+            "' before setting input data");
+  }
+
+  if (IsFixedSizeDataType(DType()) &&
+      (byte_size != (size_t)byte_size_ * batch_size_)) {
+    return Error(
+        RequestStatusCode::INVALID_ARG,
+        "invalid size " + std::to_string(byte_size) + " bytes for input '" +
+            Name() + "', expects " +
+            std::to_string(byte_size_ * batch_size_) + " bytes");
+  }
+
+  bufs_.clear();
+  buf_byte_sizes_.clear();
+  str_bufs_.clear();
+
+  shm_name_ = name;
+  shm_offset_ = offset;
+  total_byte_size_ = byte_size;
+
+  return Error::Success;
+}
+
 Error
 InputImpl::GetNext(
     uint8_t* buf, size_t size, size_t* input_bytes, bool* end_of_input)
@@ -320,6 +386,8 @@ InputImpl::Reset()
   bufs_idx_ = 0;
   buf_pos_ = 0;
   total_byte_size_ = 0;
+  shm_name_.clear();
+  shm_offset_ = 0;
 
   return Error::Success;
 }
@@ -327,7 +395,7 @@ InputImpl::Reset()
 Error
 InputImpl::PrepareForRequest()
 {
-  if (bufs_.size() != batch_size_) {
+  if (!UsesSharedMemory() && (bufs_.size() != batch_size_)) {
     return Error(
         RequestStatusCode::INVALID_ARG,
         "expecting " + std::to_string(batch_size_) +
@@ -848,11 +916,18 @@ InferContextImpl::SetRunOptions(const InferContext::Options& boptions)
 
     reinterpret_cast<OutputImpl*>(output.get())
         ->SetResultFormat(ooptions.result_format);
+    reinterpret_cast<OutputImpl*>(output.get())
+        ->SetUsesSharedMemory(!ooptions.shm_name.empty());
 
     auto routput = infer_request_.add_output();
     routput->set_name(output->Name());
     if (ooptions.result_format == Result::ResultFormat::CLASS) {
       routput->mutable_cls()->set_count(ooptions.u64);
+    } else if (!ooptions.shm_name.empty()) {
+      auto range = routput->mutable_shared_memory();
+      range->set_name(ooptions.shm_name);
+      range->set_offset(ooptions.shm_offset);
+      range->set_byte_size(ooptions.shm_byte_size);
     }
   }
 
@@ -101,15 +101,23 @@ class OptionsImpl : public InferContext::Options {
       const std::shared_ptr<InferContext::Output>& output) override;
   Error AddClassResult(
       const std::shared_ptr<InferContext::Output>& output, uint64_t k) override;
+  Error AddSharedMemoryResult(
+      const std::shared_ptr<InferContext::Output>& output,
+      const std::string& name, size_t offset, size_t byte_size) override;
 
   // Options for an output
   struct OutputOptions {
     OutputOptions(InferContext::Result::ResultFormat f, uint64_t n = 0)
-        : result_format(f), u64(n)
+        : result_format(f), u64(n), shm_offset(0), shm_byte_size(0)
     {
     }
     InferContext::Result::ResultFormat result_format;
     uint64_t u64;
+
+    // Non-empty if the output is written into a shared-memory region.
+    std::string shm_name;
+    size_t shm_offset;
+    size_t shm_byte_size;
   };
 
   using OutputOptionsPair =
@@ -147,6 +155,14 @@ class InputImpl : public InferContext::Input {
   Error SetRaw(const std::vector<uint8_t>& input) override;
   Error SetRaw(const uint8_t* input, size_t input_byte_size) override;
   Error SetFromString(const std::vector<std::string>& input) override;
+  Error SetSharedMemory(
+      const std::string& name, size_t offset, size_t byte_size) override;
+
+  // Return true if this input's values are read from a shared-memory
+  // region instead of being sent in the request.
+  bool UsesSharedMemory() const { return !shm_name_.empty(); }
+  const std::string& SharedMemoryName() const { return shm_name_; }
+  size_t SharedMemoryOffset() const { return shm_offset_; }
 
   // Copy into 'buf' up to 'size' bytes of this input's data. Return
   // the actual amount copied in 'input_bytes' and if the end of input
@@ -180,6 +196,10 @@ class InputImpl : public InferContext::Input {
   // reallocs that could invalidate the pointer references into the
   // std::string objects.
   std::list<std::string> str_bufs_;
+
+  // The shared-memory region holding the input values, if any.
+  std::string shm_name_;
+  size_t shm_offset_;
 };
 
 //==============================================================================
@@ -187,7 +207,8 @@ class InputImpl : public InferContext::Input {
 class OutputImpl : public InferContext::Output {
  public:
   OutputImpl(const ModelOutput& mio)
-      : mio_(mio), result_format_(InferContext::Result::ResultFormat::RAW)
+      : mio_(mio), result_format_(InferContext::Result::ResultFormat::RAW),
+        uses_shared_memory_(false)
   {
   }
   ~OutputImpl() = default;
@@ -205,9 +226,15 @@ class OutputImpl : public InferContext::Output {
     result_format_ = result_format;
   }
 
+  // Return true if this output is written into a shared-memory region
+  // instead of being returned in the response.
+  bool UsesSharedMemory() const { return uses_shared_memory_; }
+  void SetUsesSharedMemory(bool uses) { uses_shared_memory_ = uses; }
+
  private:
   const ModelOutput mio_;
   InferContext::Result::ResultFormat result_format_;
+  bool uses_shared_memory_;
 };
 
 //==============================================================================
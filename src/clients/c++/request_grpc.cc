@@ -289,6 +289,94 @@ ProfileGrpcContext::Create(
   return Error::Success;
 }
 
+//==============================================================================
+
+class SharedMemoryControlGrpcContextImpl : public SharedMemoryControlContext {
+ public:
+  SharedMemoryControlGrpcContextImpl(const std::string& url, bool verbose);
+  Error RegisterSharedMemory(
+      const std::string& name, const std::string& shm_key, size_t offset,
+      size_t byte_size) override;
+  Error UnregisterSharedMemory(const std::string& name) override;
+  Error UnregisterAllSharedMemory() override;
+
+ private:
+  Error SendRequest(const SharedMemoryControlRequest& request);
+
+  // GRPC end point.
+  std::unique_ptr<GRPCService::Stub> stub_;
+
+  // Enable verbose output
+  const bool verbose_;
+};
+
+SharedMemoryControlGrpcContextImpl::SharedMemoryControlGrpcContextImpl(
+    const std::string& url, bool verbose)
+    : stub_(GRPCService::NewStub(GetChannel(url))), verbose_(verbose)
+{
+}
+
+Error
+SharedMemoryControlGrpcContextImpl::RegisterSharedMemory(
+    const std::string& name, const std::string& shm_key, size_t offset,
+    size_t byte_size)
+{
+  SharedMemoryControlRequest request;
+  auto region = request.mutable_register_region();
+  region->set_name(name);
+  region->set_shared_memory_key(shm_key);
+  region->set_offset(offset);
+  region->set_byte_size(byte_size);
+  return SendRequest(request);
+}
+
+Error
+SharedMemoryControlGrpcContextImpl::UnregisterSharedMemory(
+    const std::string& name)
+{
+  SharedMemoryControlRequest request;
+  request.mutable_unregister_region()->set_name(name);
+  return SendRequest(request);
+}
+
+Error
+SharedMemoryControlGrpcContextImpl::UnregisterAllSharedMemory()
+{
+  SharedMemoryControlRequest request;
+  request.mutable_unregister_all_regions();
+  return SendRequest(request);
+}
+
+Error
+SharedMemoryControlGrpcContextImpl::SendRequest(
+    const SharedMemoryControlRequest& request)
+{
+  SharedMemoryControlResponse response;
+  grpc::ClientContext context;
+
+  grpc::Status status =
+      stub_->SharedMemoryControl(&context, request, &response);
+  if (status.ok()) {
+    return Error(response.request_status());
+  } else {
+    // Something wrong with the GRPC conncection
+    return Error(
+        RequestStatusCode::INTERNAL,
+        "GRPC client failed: " + std::to_string(status.error_code()) + ": " +
+            status.error_message());
+  }
+}
+
+Error
+SharedMemoryControlGrpcContext::Create(
+    std::unique_ptr<SharedMemoryControlContext>* ctx,
+    const std::string& server_url, bool verbose)
+{
+  ctx->reset(static_cast<SharedMemoryControlContext*>(
+      new SharedMemoryControlGrpcContextImpl(server_url, verbose)));
+  return Error::Success;
+}
+
 //==============================================================================
 class GrpcResultImpl : public ResultImpl {
  public:
@@ -447,6 +535,13 @@ GrpcRequestImpl::GetResults(
       return err;
     }
 
+    // Outputs written into shared memory are not returned as results.
+    if (reinterpret_cast<OutputImpl*>(infer_output.get())
+            ->UsesSharedMemory()) {
+      ++idx;
+      continue;
+    }
+
     std::unique_ptr<GrpcResultImpl> result(
         new GrpcResultImpl(grpc_response_, infer_output));
     err = InitResult(infer_output, output, idx, result.get());
@@ -632,7 +727,8 @@ InferGrpcContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
   infer_request_.mutable_input()->Clear();
   infer_request_.set_id(request->Id());
   for (auto& io : inputs_) {
-    reinterpret_cast<InputImpl*>(io.get())->PrepareForRequest();
+    InputImpl* input = reinterpret_cast<InputImpl*>(io.get());
+    input->PrepareForRequest();
 
     auto rinput = infer_request_.add_input();
     rinput->set_name(io->Name());
@@ -640,7 +736,13 @@ InferGrpcContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
     for (const auto s : io->Shape()) {
       rinput->add_dims(s);
     }
-    if (!IsFixedSizeDataType(io->DType())) {
+    if (input->UsesSharedMemory()) {
+      auto range = rinput->mutable_shared_memory();
+      range->set_name(input->SharedMemoryName());
+      range->set_offset(input->SharedMemoryOffset());
+      range->set_byte_size(io->TotalByteSize());
+      rinput->set_batch_byte_size(io->TotalByteSize());
+    } else if (!IsFixedSizeDataType(io->DType())) {
       rinput->set_batch_byte_size(io->TotalByteSize());
     }
   }
@@ -653,6 +755,13 @@ InferGrpcContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
   size_t input_pos_idx = 0;
   while (input_pos_idx < inputs_.size()) {
     InputImpl* io = reinterpret_cast<InputImpl*>(inputs_[input_pos_idx].get());
+
+    // Values in a shared-memory region are not sent in the request.
+    if (io->UsesSharedMemory()) {
+      input_pos_idx++;
+      continue;
+    }
+
     std::string* new_input = request_.add_raw_input();
 
     // Append all batches of one input together
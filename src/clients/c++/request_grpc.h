@@ -39,7 +39,9 @@ class ServerHealthGrpcContext {
  public:
   /// Create a context that returns health information about server.
   /// \param ctx Returns a new ServerHealthGrpcContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -57,7 +59,9 @@ class ServerStatusGrpcContext {
   /// Create a context that returns information about an inference
   /// server and all models on the server using GRPC protocol.
   /// \param ctx Returns a new ServerStatusGrpcContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -68,7 +72,9 @@ class ServerStatusGrpcContext {
   /// Create a context that returns information about an inference
   /// server and one model on the sever using GRPC protocol.
   /// \param ctx Returns a new ServerStatusGrpcContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
@@ -86,7 +92,9 @@ class ProfileGrpcContext {
   /// Create context that controls profiling on a server using GRPC
   /// protocol.
   /// \param ctx Returns the new ProfileContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -95,6 +103,26 @@ class ProfileGrpcContext {
       bool verbose = false);
 };
 
+//==============================================================================
+/// SharedMemoryControlGrpcContext is the GRPC instantiation of
+/// SharedMemoryControlContext.
+///
+class SharedMemoryControlGrpcContext {
+ public:
+  /// Create context that registers and unregisters shared-memory
+  /// regions on a server using GRPC protocol.
+  /// \param ctx Returns the new SharedMemoryControlContext object.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
+  /// \param verbose If true generate verbose output when contacting
+  /// the inference server.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<SharedMemoryControlContext>* ctx,
+      const std::string& server_url, bool verbose = false);
+};
+
 //==============================================================================
 /// InferGrpcContext is the GRPC instantiation of InferContext.
 ///
@@ -104,7 +132,9 @@ class InferGrpcContext {
   /// using the GRPC protocol.
   ///
   /// \param ctx Returns a new InferGrpcContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -124,7 +154,9 @@ class InferGrpcContext {
   /// \param correlation_id The correlation ID to use for all
   /// inferences performed with this context. A value of 0 (zero)
   /// indicates that no correlation ID should be used.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -149,7 +181,9 @@ class InferGrpcStreamContext {
   /// using the GRPC protocol.
   ///
   /// \param ctx Returns a new InferGrpcContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -169,7 +203,9 @@ class InferGrpcStreamContext {
   /// \param correlation_id The correlation ID to use for all
   /// inferences performed with this context. A value of 0 (zero)
   /// indicates that no correlation ID should be used.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -28,6 +28,7 @@
 
 #include <curl/curl.h>
 #include <google/protobuf/text_format.h>
+#include <zlib.h>
 #include "src/clients/c++/request_common.h"
 
 namespace nvidia { namespace inferenceserver { namespace client {
@@ -69,6 +70,90 @@ CurlGlobal::~CurlGlobal()
 
 static CurlGlobal curl_global;
 
+//==============================================================================
+
+// A server URL of the form "unix:<path>" reaches the server through
+// the Unix domain socket at <path> instead of over TCP.
+const std::string kUnixSocketUrlPrefix = "unix:";
+
+// Return the path of the Unix domain socket in 'server_url', empty if
+// the server is reached over TCP.
+std::string
+UnixSocketPath(const std::string& server_url)
+{
+  if (server_url.compare(
+          0, kUnixSocketUrlPrefix.size(), kUnixSocketUrlPrefix) == 0) {
+    return server_url.substr(kUnixSocketUrlPrefix.size());
+  }
+
+  return std::string();
+}
+
+// Return the URL that the endpoint paths of 'server_url' are appended
+// to. Through a Unix domain socket the host is only used for the
+// Host header.
+std::string
+ServerApiUrl(const std::string& server_url)
+{
+  return UnixSocketPath(server_url).empty() ? server_url : "localhost";
+}
+
+// Make 'curl' connect through the Unix domain socket at
+// 'socket_path' unless it is empty.
+void
+SetUnixSocketPath(CURL* curl, const std::string& socket_path)
+{
+  if (!socket_path.empty()) {
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, socket_path.c_str());
+  }
+}
+
+//==============================================================================
+
+// Return the base64 encoding of 'data' (RFC 4648, with padding).
+std::string
+Base64Encode(const std::string& data)
+{
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string encoded;
+  encoded.reserve(((data.size() + 2) / 3) * 4);
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  size_t i = 0;
+  for (; i + 2 < data.size(); i += 3) {
+    const uint32_t triple =
+        (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+    encoded.push_back(kAlphabet[(triple >> 18) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 12) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 6) & 0x3f]);
+    encoded.push_back(kAlphabet[triple & 0x3f]);
+  }
+
+  if (i < data.size()) {
+    uint32_t triple = bytes[i] << 16;
+    if (i + 1 < data.size()) {
+      triple |= bytes[i + 1] << 8;
+    }
+    encoded.push_back(kAlphabet[(triple >> 18) & 0x3f]);
+    encoded.push_back(kAlphabet[(triple >> 12) & 0x3f]);
+    encoded.push_back(
+        (i + 1 < data.size()) ? kAlphabet[(triple >> 6) & 0x3f] : '=');
+    encoded.push_back('=');
+  }
+
+  return encoded;
+}
+
+// Return the 4-byte little-endian value at 'offset' in 'buf'.
+uint32_t
+ReadLittleEndian32(const std::string& buf, size_t offset)
+{
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(buf.data()) + offset;
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
 }  // namespace
 
 //==============================================================================
@@ -86,13 +171,17 @@ class ServerHealthHttpContextImpl : public ServerHealthContext {
   // URL for health endpoint on inference server.
   const std::string url_;
 
+  // Path of the Unix domain socket to the server, empty for TCP.
+  const std::string socket_path_;
+
   // Enable verbose output
   const bool verbose_;
 };
 
 ServerHealthHttpContextImpl::ServerHealthHttpContextImpl(
     const std::string& url, bool verbose)
-    : url_(url + "/" + kHealthRESTEndpoint), verbose_(verbose)
+    : url_(ServerApiUrl(url) + "/" + kHealthRESTEndpoint),
+      socket_path_(UnixSocketPath(url)), verbose_(verbose)
 {
 }
 
@@ -110,6 +199,7 @@ ServerHealthHttpContextImpl::GetHealth(const std::string& url, bool* health)
   }
 
   curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  SetUnixSocketPath(curl, socket_path_);
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
@@ -172,6 +262,9 @@ class ServerStatusHttpContextImpl : public ServerStatusContext {
   // URL for status endpoint on inference server.
   const std::string url_;
 
+  // Path of the Unix domain socket to the server, empty for TCP.
+  const std::string socket_path_;
+
   // Enable verbose output
   const bool verbose_;
 
@@ -184,14 +277,15 @@ class ServerStatusHttpContextImpl : public ServerStatusContext {
 
 ServerStatusHttpContextImpl::ServerStatusHttpContextImpl(
     const std::string& url, bool verbose)
-    : url_(url + "/" + kStatusRESTEndpoint), verbose_(verbose)
+    : url_(ServerApiUrl(url) + "/" + kStatusRESTEndpoint),
+      socket_path_(UnixSocketPath(url)), verbose_(verbose)
 {
 }
 
 ServerStatusHttpContextImpl::ServerStatusHttpContextImpl(
     const std::string& url, const std::string& model_name, bool verbose)
-    : url_(url + "/" + kStatusRESTEndpoint + "/" + model_name),
-      verbose_(verbose)
+    : url_(ServerApiUrl(url) + "/" + kStatusRESTEndpoint + "/" + model_name),
+      socket_path_(UnixSocketPath(url)), verbose_(verbose)
 {
 }
 
@@ -215,6 +309,7 @@ ServerStatusHttpContextImpl::GetServerStatus(ServerStatus* server_status)
   // Want binary representation of the status.
   std::string full_url = url_ + "?format=binary";
   curl_easy_setopt(curl, CURLOPT_URL, full_url.c_str());
+  SetUnixSocketPath(curl, socket_path_);
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
@@ -344,6 +439,9 @@ class ProfileHttpContextImpl : public ProfileContext {
   // URL for profile endpoint on inference server.
   const std::string url_;
 
+  // Path of the Unix domain socket to the server, empty for TCP.
+  const std::string socket_path_;
+
   // RequestStatus received in server response
   RequestStatus request_status_;
 
@@ -353,7 +451,8 @@ class ProfileHttpContextImpl : public ProfileContext {
 
 ProfileHttpContextImpl::ProfileHttpContextImpl(
     const std::string& url, bool verbose)
-    : url_(url + "/" + kProfileRESTEndpoint), verbose_(verbose)
+    : url_(ServerApiUrl(url) + "/" + kProfileRESTEndpoint),
+      socket_path_(UnixSocketPath(url)), verbose_(verbose)
 {
 }
 
@@ -387,6 +486,7 @@ ProfileHttpContextImpl::SendCommand(const std::string& cmd_str)
   // Want binary representation of the status.
   std::string full_url = url_ + "?cmd=" + cmd_str;
   curl_easy_setopt(curl, CURLOPT_URL, full_url.c_str());
+  SetUnixSocketPath(curl, socket_path_);
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
@@ -461,6 +561,157 @@ ProfileHttpContext::Create(
 
 //==============================================================================
 
+class SharedMemoryControlHttpContextImpl : public SharedMemoryControlContext {
+ public:
+  SharedMemoryControlHttpContextImpl(const std::string& url, bool verbose);
+  Error RegisterSharedMemory(
+      const std::string& name, const std::string& shm_key, size_t offset,
+      size_t byte_size) override;
+  Error UnregisterSharedMemory(const std::string& name) override;
+  Error UnregisterAllSharedMemory() override;
+
+ private:
+  static size_t ResponseHeaderHandler(void*, size_t, size_t, void*);
+  Error SendCommand(const std::string& cmd_str);
+
+  // URL for shared-memory endpoint on inference server.
+  const std::string url_;
+
+  // Path of the Unix domain socket to the server, empty for TCP.
+  const std::string socket_path_;
+
+  // RequestStatus received in server response
+  RequestStatus request_status_;
+
+  // Enable verbose output
+  const bool verbose_;
+};
+
+SharedMemoryControlHttpContextImpl::SharedMemoryControlHttpContextImpl(
+    const std::string& url, bool verbose)
+    : url_(ServerApiUrl(url) + "/" + kSharedMemoryRESTEndpoint),
+      socket_path_(UnixSocketPath(url)), verbose_(verbose)
+{
+}
+
+Error
+SharedMemoryControlHttpContextImpl::RegisterSharedMemory(
+    const std::string& name, const std::string& shm_key, size_t offset,
+    size_t byte_size)
+{
+  // The key travels as a single path segment so drop the leading '/',
+  // shm_open() treats both forms of the key the same.
+  const std::string key =
+      (!shm_key.empty() && (shm_key[0] == '/')) ? shm_key.substr(1) : shm_key;
+  return SendCommand(
+      "register/" + name + "/" + key + "/" + std::to_string(offset) + "/" +
+      std::to_string(byte_size));
+}
+
+Error
+SharedMemoryControlHttpContextImpl::UnregisterSharedMemory(
+    const std::string& name)
+{
+  return SendCommand("unregister/" + name);
+}
+
+Error
+SharedMemoryControlHttpContextImpl::UnregisterAllSharedMemory()
+{
+  return SendCommand("unregisterall");
+}
+
+Error
+SharedMemoryControlHttpContextImpl::SendCommand(const std::string& cmd_str)
+{
+  request_status_.Clear();
+
+  if (!curl_global.Status().IsOk()) {
+    return curl_global.Status();
+  }
+
+  CURL* curl = curl_easy_init();
+  if (!curl) {
+    return Error(
+        RequestStatusCode::INTERNAL, "failed to initialize HTTP client");
+  }
+
+  std::string full_url = url_ + "/" + cmd_str;
+  curl_easy_setopt(curl, CURLOPT_URL, full_url.c_str());
+  SetUnixSocketPath(curl, socket_path_);
+  curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  curl_easy_setopt(curl, CURLOPT_POST, 1L);
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
+  if (verbose_) {
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+  }
+
+  // response headers handled by ResponseHeaderHandler()
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, ResponseHeaderHandler);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
+
+  CURLcode res = curl_easy_perform(curl);
+  if (res != CURLE_OK) {
+    curl_easy_cleanup(curl);
+    return Error(
+        RequestStatusCode::INTERNAL,
+        "HTTP client failed: " + std::string(curl_easy_strerror(res)));
+  }
+
+  curl_easy_cleanup(curl);
+
+  // Should have a request status, if not then create an error status.
+  if (request_status_.code() == RequestStatusCode::INVALID) {
+    request_status_.Clear();
+    request_status_.set_code(RequestStatusCode::INTERNAL);
+    request_status_.set_msg("shared memory request did not return status");
+  }
+
+  return Error(request_status_);
+}
+
+size_t
+SharedMemoryControlHttpContextImpl::ResponseHeaderHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  SharedMemoryControlHttpContextImpl* ctx =
+      reinterpret_cast<SharedMemoryControlHttpContextImpl*>(userp);
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t byte_size = size * nmemb;
+
+  size_t idx = strlen(kStatusHTTPHeader);
+  if ((idx < byte_size) && !strncasecmp(buf, kStatusHTTPHeader, idx)) {
+    while ((idx < byte_size) && (buf[idx] != ':')) {
+      ++idx;
+    }
+
+    if (idx < byte_size) {
+      std::string hdr(buf + idx + 1, byte_size - idx - 1);
+
+      if (!google::protobuf::TextFormat::ParseFromString(
+              hdr, &ctx->request_status_)) {
+        ctx->request_status_.Clear();
+      }
+    }
+  }
+
+  return byte_size;
+}
+
+Error
+SharedMemoryControlHttpContext::Create(
+    std::unique_ptr<SharedMemoryControlContext>* ctx,
+    const std::string& server_url, bool verbose)
+{
+  ctx->reset(static_cast<SharedMemoryControlContext*>(
+      new SharedMemoryControlHttpContextImpl(server_url, verbose)));
+  return Error::Success;
+}
+
+//==============================================================================
+
 class HttpRequestImpl : public RequestImpl {
  public:
   HttpRequestImpl(
@@ -475,11 +726,31 @@ class HttpRequestImpl : public RequestImpl {
   // actual amount copied in 'input_bytes'.
   Error GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes);
 
+  // Compress all the input data with 'compression' so that it is
+  // sent from 'compressed_input_' instead.
+  Error CompressInput(InferHttpContext::CompressionType compression);
+
+  // Copy into 'buf' up to 'size' bytes of the compressed input
+  // data. Return the actual amount copied in 'input_bytes'.
+  size_t GetNextCompressedInput(uint8_t* buf, size_t size);
+
   // Create a result object for this request.
   Error CreateResult(
       const InferHttpContextImpl& ctx,
       const InferResponseHeader::Output& output, const size_t batch_size);
 
+  // Consume up to 'size' bytes of 'buf' as the request status and
+  // response header at the start of the response body. Return the
+  // number of bytes consumed in 'prefix_bytes'. Once the prefix is
+  // complete create the results described by the response header.
+  Error SetNextResponsePrefix(
+      const InferHttpContextImpl& ctx, const uint8_t* buf, size_t size,
+      size_t* prefix_bytes);
+
+  // Return the byte size of the response prefix, as far as it is
+  // known from the bytes received so far.
+  size_t ResponsePrefixByteSize() const;
+
   // Copy into the context 'size' bytes of result data from
   // 'buf'. Return the actual amount copied in 'result_bytes'.
   Error SetNextRawResult(const uint8_t* buf, size_t size, size_t* result_bytes);
@@ -503,13 +774,18 @@ class HttpRequestImpl : public RequestImpl {
   // RequestStatus received in server response.
   RequestStatus request_status_;
 
-  // The partial InferResponseHeader delivered via HTTP header.
+  // The InferResponseHeader delivered at the start of the body.
   InferResponseHeader response_header_;
 
-  // Buffer that accumulates the serialized InferResponseHeader at the
-  // end of the body.
+  // Buffer that accumulates the serialized RequestStatus and
+  // InferResponseHeader at the start of the body, each preceded by
+  // its 4-byte little-endian size.
   std::string infer_response_buffer_;
 
+  // Whether the request status and response header have been
+  // received.
+  bool response_prefix_complete_;
+
   // The inputs for the request. For asynchronous request, it should
   // be a deep copy of the inputs set by the user in case the user modifies
   // them for another request during the HTTP transfer.
@@ -521,6 +797,11 @@ class HttpRequestImpl : public RequestImpl {
   // Current positions within input vectors when sending request.
   size_t input_pos_idx_;
 
+  // The compressed input data and the position within it when
+  // sending the request. Empty if the input is not compressed.
+  std::string compressed_input_;
+  size_t compressed_input_pos_;
+
   // Current positions within output vectors when processing response.
   size_t result_pos_idx_;
 
@@ -537,7 +818,9 @@ class HttpRequestImpl : public RequestImpl {
 class InferHttpContextImpl : public InferContextImpl {
  public:
   InferHttpContextImpl(
-      const std::string&, const std::string&, int64_t, CorrelationID, bool);
+      const std::string&, const std::string&, int64_t, CorrelationID,
+      InferHttpContext::CompressionType, InferHttpContext::CompressionType,
+      bool);
   virtual ~InferHttpContextImpl();
 
   Error InitHttp(const std::string& server_url);
@@ -550,7 +833,6 @@ class InferHttpContextImpl : public InferContextImpl {
 
  private:
   static size_t RequestProvider(void*, size_t, size_t, void*);
-  static size_t ResponseHeaderHandler(void*, size_t, size_t, void*);
   static size_t ResponseHandler(void*, size_t, size_t, void*);
 
   void AsyncTransfer();
@@ -562,11 +844,18 @@ class InferHttpContextImpl : public InferContextImpl {
   // URL to POST to
   std::string url_;
 
+  // Path of the Unix domain socket to the server, empty for TCP.
+  const std::string socket_path_;
+
   // Serialized InferRequestHeader
   std::string infer_request_str_;
 
   // Keep an easy handle alive to reuse the connection
   CURL* curl_;
+
+  // The compression of the request and response bodies.
+  const InferHttpContext::CompressionType request_compression_;
+  const InferHttpContext::CompressionType response_compression_;
 };
 
 //==============================================================================
@@ -594,6 +883,7 @@ HttpRequestImpl::InitializeRequest()
 {
   ordered_results_.clear();
   infer_response_buffer_.clear();
+  response_prefix_complete_ = false;
 
   request_status_.Clear();
   response_header_.Clear();
@@ -605,6 +895,8 @@ HttpRequestImpl::InitializeRequest()
   total_input_byte_size_ = 0;
   input_pos_idx_ = 0;
   result_pos_idx_ = 0;
+  compressed_input_.clear();
+  compressed_input_pos_ = 0;
 
   return Error::Success;
 }
@@ -643,6 +935,139 @@ HttpRequestImpl::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
   return Error::Success;
 }
 
+Error
+HttpRequestImpl::CompressInput(InferHttpContext::CompressionType compression)
+{
+  // Adding 16 to the window bits selects the gzip format.
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  const int window_bits =
+      (compression == InferHttpContext::CompressionType::GZIP)
+          ? MAX_WBITS + 16
+          : MAX_WBITS;
+  if (deflateInit2(
+          &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits,
+          8 /* memLevel */, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return Error(
+        RequestStatusCode::INTERNAL, "failed to initialize compression");
+  }
+
+  // The bound allows compressing in a single pass, reading the input
+  // in chunks.
+  compressed_input_.resize(deflateBound(&stream, total_input_byte_size_));
+  stream.next_out = reinterpret_cast<Bytef*>(&compressed_input_[0]);
+  stream.avail_out = compressed_input_.size();
+
+  std::vector<uint8_t> chunk(64 * 1024);
+  int ret = Z_OK;
+  while (ret == Z_OK) {
+    size_t input_bytes = 0;
+    Error err = GetNextInput(&chunk[0], chunk.size(), &input_bytes);
+    if (!err.IsOk()) {
+      deflateEnd(&stream);
+      compressed_input_.clear();
+      return err;
+    }
+
+    stream.next_in = &chunk[0];
+    stream.avail_in = input_bytes;
+    ret = deflate(&stream, (input_bytes == 0) ? Z_FINISH : Z_NO_FLUSH);
+  }
+
+  compressed_input_.resize(compressed_input_.size() - stream.avail_out);
+  deflateEnd(&stream);
+  if (ret != Z_STREAM_END) {
+    compressed_input_.clear();
+    return Error(RequestStatusCode::INTERNAL, "failed to compress input");
+  }
+
+  return Error::Success;
+}
+
+size_t
+HttpRequestImpl::GetNextCompressedInput(uint8_t* buf, size_t size)
+{
+  const size_t input_bytes =
+      std::min(size, compressed_input_.size() - compressed_input_pos_);
+  memcpy(buf, compressed_input_.data() + compressed_input_pos_, input_bytes);
+  compressed_input_pos_ += input_bytes;
+
+  // Sent all input bytes
+  if (compressed_input_pos_ == compressed_input_.size()) {
+    Timer().Record(RequestTimers::Kind::SEND_END);
+  }
+
+  return input_bytes;
+}
+
+size_t
+HttpRequestImpl::ResponsePrefixByteSize() const
+{
+  const size_t received = infer_response_buffer_.size();
+  size_t byte_size = sizeof(uint32_t);
+  if (received >= byte_size) {
+    byte_size += ReadLittleEndian32(infer_response_buffer_, 0);
+    byte_size += sizeof(uint32_t);
+    if (received >= byte_size) {
+      byte_size += ReadLittleEndian32(
+          infer_response_buffer_, byte_size - sizeof(uint32_t));
+    }
+  }
+
+  return byte_size;
+}
+
+Error
+HttpRequestImpl::SetNextResponsePrefix(
+    const InferHttpContextImpl& ctx, const uint8_t* buf, size_t size,
+    size_t* prefix_bytes)
+{
+  *prefix_bytes = 0;
+
+  // Take only the bytes of the prefix, the rest of the body holds
+  // the raw results.
+  while (!response_prefix_complete_ && (size > 0)) {
+    const size_t take = std::min(
+        size, ResponsePrefixByteSize() - infer_response_buffer_.size());
+    infer_response_buffer_.append(reinterpret_cast<const char*>(buf), take);
+    *prefix_bytes += take;
+    size -= take;
+    buf += take;
+
+    response_prefix_complete_ =
+        (infer_response_buffer_.size() == ResponsePrefixByteSize());
+  }
+
+  // Parse the prefix once, when it is completed.
+  if (!response_prefix_complete_ || (*prefix_bytes == 0)) {
+    return Error::Success;
+  }
+
+  const size_t status_byte_size =
+      ReadLittleEndian32(infer_response_buffer_, 0);
+  const size_t header_offset = 2 * sizeof(uint32_t) + status_byte_size;
+  if (!request_status_.ParseFromArray(
+          infer_response_buffer_.data() + sizeof(uint32_t),
+          status_byte_size) ||
+      !response_header_.ParseFromArray(
+          infer_response_buffer_.data() + header_offset,
+          infer_response_buffer_.size() - header_offset)) {
+    request_status_.Clear();
+    response_header_.Clear();
+    return Error::Success;
+  }
+
+  for (const auto& output : response_header_.output()) {
+    Error err = CreateResult(ctx, output, response_header_.batch_size());
+    if (!err.IsOk()) {
+      response_header_.Clear();
+      break;
+    }
+  }
+
+  return Error::Success;
+}
+
 Error
 HttpRequestImpl::SetNextRawResult(
     const uint8_t* buf, size_t size, size_t* result_bytes)
@@ -671,12 +1096,8 @@ HttpRequestImpl::SetNextRawResult(
     }
   }
 
-  // If there is any bytes left then they belong to the response
-  // header, since all the RAW results have been filled.
-  if (size > 0) {
-    infer_response_buffer_.append(reinterpret_cast<const char*>(buf), size);
-    *result_bytes += size;
-  }
+  // Any bytes left don't belong to a result and are ignored.
+  *result_bytes += size;
 
   return Error::Success;
 }
@@ -692,6 +1113,12 @@ HttpRequestImpl::CreateResult(
     return err;
   }
 
+  // Outputs written into shared memory have no bytes in the response
+  // body and are not returned as results.
+  if (reinterpret_cast<OutputImpl*>(infer_output.get())->UsesSharedMemory()) {
+    return Error::Success;
+  }
+
   std::unique_ptr<ResultImpl> result(new ResultImpl(infer_output, batch_size));
   result->SetBatch1Shape(output.raw().dims());
   if (IsFixedSizeDataType(infer_output->DType())) {
@@ -706,8 +1133,6 @@ HttpRequestImpl::CreateResult(
 Error
 HttpRequestImpl::GetResults(InferContext::ResultMap* results)
 {
-  InferResponseHeader infer_response;
-
   if (http_status_ != CURLE_OK) {
     curl_slist_free_all(header_list_);
     ordered_results_.clear();
@@ -729,8 +1154,8 @@ HttpRequestImpl::GetResults(InferContext::ResultMap* results)
     request_status_.set_msg("infer request did not return status");
   }
 
-  // Should have response header from HTTP header, if not then create
-  // an error status.
+  // Should have response header from the body, if not then create an
+  // error status.
   if ((request_status_.code() == RequestStatusCode::SUCCESS) &&
       response_header_.model_name().empty()) {
     request_status_.Clear();
@@ -746,23 +1171,13 @@ HttpRequestImpl::GetResults(InferContext::ResultMap* results)
     return Error(request_status_);
   }
 
-  // The infer response header should be available...
-  if (infer_response_buffer_.empty()) {
-    ordered_results_.clear();
-    return Error(
-        RequestStatusCode::INTERNAL,
-        "infer request did not return result header");
-  }
-
-  infer_response.ParseFromString(infer_response_buffer_);
-
   results->clear();
   for (auto& r : ordered_results_) {
     const std::string& name = r->GetOutput()->Name();
     results->insert(std::make_pair(name, std::move(r)));
   }
 
-  PostRunProcessing(infer_response, results);
+  PostRunProcessing(response_header_, results);
 
   return Error(request_status_);
 }
@@ -771,13 +1186,18 @@ HttpRequestImpl::GetResults(InferContext::ResultMap* results)
 
 InferHttpContextImpl::InferHttpContextImpl(
     const std::string& server_url, const std::string& model_name,
-    int64_t model_version, CorrelationID correlation_id, bool verbose)
+    int64_t model_version, CorrelationID correlation_id,
+    InferHttpContext::CompressionType request_compression,
+    InferHttpContext::CompressionType response_compression, bool verbose)
     : InferContextImpl(model_name, model_version, correlation_id, verbose),
-      multi_handle_(curl_multi_init())
+      multi_handle_(curl_multi_init()),
+      socket_path_(UnixSocketPath(server_url)),
+      request_compression_(request_compression),
+      response_compression_(response_compression)
 {
   // Process url for HTTP request
   // URL doesn't contain the version portion if using the latest version.
-  url_ = server_url + "/" + kInferRESTEndpoint + "/" + model_name;
+  url_ = ServerApiUrl(server_url) + "/" + kInferRESTEndpoint + "/" + model_name;
   if (model_version >= 0) {
     url_ += "/" + std::to_string(model_version);
   }
@@ -948,6 +1368,11 @@ InferHttpContextImpl::RequestProvider(
 {
   HttpRequestImpl* request = reinterpret_cast<HttpRequestImpl*>(userp);
 
+  if (!request->compressed_input_.empty()) {
+    return request->GetNextCompressedInput(
+        reinterpret_cast<uint8_t*>(contents), size * nmemb);
+  }
+
   size_t input_bytes = 0;
   Error err = request->GetNextInput(
       reinterpret_cast<uint8_t*>(contents), size * nmemb, &input_bytes);
@@ -960,7 +1385,7 @@ InferHttpContextImpl::RequestProvider(
 }
 
 size_t
-InferHttpContextImpl::ResponseHeaderHandler(
+InferHttpContextImpl::ResponseHandler(
     void* contents, size_t size, size_t nmemb, void* userp)
 {
   ResponseHandlerUserP* pr = reinterpret_cast<ResponseHandlerUserP*>(userp);
@@ -968,72 +1393,31 @@ InferHttpContextImpl::ResponseHeaderHandler(
       reinterpret_cast<InferHttpContextImpl*>(pr->first);
   HttpRequestImpl* request = reinterpret_cast<HttpRequestImpl*>(pr->second);
 
-  char* buf = reinterpret_cast<char*>(contents);
-  size_t byte_size = size * nmemb;
-  size_t idx;
-
-  // Status header
-  idx = strlen(kStatusHTTPHeader);
-  if ((idx < byte_size) && !strncasecmp(buf, kStatusHTTPHeader, idx)) {
-    while ((idx < byte_size) && (buf[idx] != ':')) {
-      ++idx;
-    }
-
-    if (idx < byte_size) {
-      std::string hdr(buf + idx + 1, byte_size - idx - 1);
-      if (!google::protobuf::TextFormat::ParseFromString(
-              hdr, &request->request_status_)) {
-        request->request_status_.Clear();
-      }
-    }
+  if (request->Timer().receive_start_.tv_sec == 0) {
+    request->Timer().Record(RequestTimers::Kind::RECEIVE_START);
   }
 
-  // Response header
-  idx = strlen(kInferResponseHTTPHeader);
-  if ((idx < byte_size) && !strncasecmp(buf, kInferResponseHTTPHeader, idx)) {
-    while ((idx < byte_size) && (buf[idx] != ':')) {
-      ++idx;
-    }
-
-    if (idx < byte_size) {
-      std::string hdr(buf + idx + 1, byte_size - idx - 1);
-      if (!google::protobuf::TextFormat::ParseFromString(
-              hdr, &request->response_header_)) {
-        request->response_header_.Clear();
-      } else {
-        for (const auto& output : request->response_header_.output()) {
-          Error err = request->CreateResult(
-              *ctx, output, request->response_header_.batch_size());
-          if (!err.IsOk()) {
-            request->response_header_.Clear();
-          }
-        }
-      }
-    }
+  // The body starts with the request status and response header,
+  // which describe the raw results that follow.
+  uint8_t* buf = reinterpret_cast<uint8_t*>(contents);
+  size_t byte_size = size * nmemb;
+  size_t prefix_bytes = 0;
+  Error err =
+      request->SetNextResponsePrefix(*ctx, buf, byte_size, &prefix_bytes);
+  if (!err.IsOk()) {
+    std::cerr << "ResponseHandler: " << err << std::endl;
+    return 0;
   }
 
-  return byte_size;
-}
-
-size_t
-InferHttpContextImpl::ResponseHandler(
-    void* contents, size_t size, size_t nmemb, void* userp)
-{
-  HttpRequestImpl* request = reinterpret_cast<HttpRequestImpl*>(userp);
   size_t result_bytes = 0;
-
-  if (request->Timer().receive_start_.tv_sec == 0) {
-    request->Timer().Record(RequestTimers::Kind::RECEIVE_START);
-  }
-
-  Error err = request->SetNextRawResult(
-      reinterpret_cast<uint8_t*>(contents), size * nmemb, &result_bytes);
+  err = request->SetNextRawResult(
+      buf + prefix_bytes, byte_size - prefix_bytes, &result_bytes);
   if (!err.IsOk()) {
     std::cerr << "ResponseHandler: " << err << std::endl;
     return 0;
   }
 
-  return result_bytes;
+  return prefix_bytes + result_bytes;
 }
 
 Error
@@ -1050,8 +1434,9 @@ InferHttpContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
         RequestStatusCode::INTERNAL, "failed to initialize HTTP client");
   }
 
-  std::string full_url = url_ + "?format=binary";
+  std::string full_url = url_ + "?format=binary_header";
   curl_easy_setopt(curl, CURLOPT_URL, full_url.c_str());
+  SetUnixSocketPath(curl, socket_path_);
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_POST, 1L);
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
@@ -1063,16 +1448,23 @@ InferHttpContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
   curl_easy_setopt(curl, CURLOPT_READFUNCTION, RequestProvider);
   curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
 
-  // response headers handled by ResponseHeaderHandler()
+  // response data handled by ResponseHandler(). The request status
+  // and response header are at the start of the body so the response
+  // headers are not needed.
   http_request->response_handler_userp_ =
       std::make_pair(this, http_request.get());
-  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, ResponseHeaderHandler);
-  curl_easy_setopt(
-      curl, CURLOPT_HEADERDATA, &http_request->response_handler_userp_);
-
-  // response data handled by ResponseHandler()
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, ResponseHandler);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
+  curl_easy_setopt(
+      curl, CURLOPT_WRITEDATA, &http_request->response_handler_userp_);
+
+  // Curl decompresses the response before passing it to
+  // ResponseHandler().
+  if (response_compression_ == InferHttpContext::CompressionType::GZIP) {
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
+  } else if (
+      response_compression_ == InferHttpContext::CompressionType::DEFLATE) {
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
+  }
 
   // Create the input metadata for the request now that all input
   // sizes are known. For non-fixed-sized datatypes the
@@ -1082,7 +1474,7 @@ InferHttpContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
   infer_request_.mutable_input()->Clear();
   infer_request_.set_id(request->Id());
   for (const auto& io : inputs_) {
-    http_request->total_input_byte_size_ += io->TotalByteSize();
+    const InputImpl* input = reinterpret_cast<const InputImpl*>(io.get());
 
     auto rinput = infer_request_.add_input();
     rinput->set_name(io->Name());
@@ -1090,24 +1482,59 @@ InferHttpContextImpl::PreRunProcessing(std::shared_ptr<Request>& request)
     for (const auto s : io->Shape()) {
       rinput->add_dims(s);
     }
-    if (!IsFixedSizeDataType(io->DType())) {
+
+    // Values in a shared-memory region are not sent in the request
+    // body.
+    if (input->UsesSharedMemory()) {
+      auto range = rinput->mutable_shared_memory();
+      range->set_name(input->SharedMemoryName());
+      range->set_offset(input->SharedMemoryOffset());
+      range->set_byte_size(io->TotalByteSize());
       rinput->set_batch_byte_size(io->TotalByteSize());
+    } else {
+      http_request->total_input_byte_size_ += io->TotalByteSize();
+      if (!IsFixedSizeDataType(io->DType())) {
+        rinput->set_batch_byte_size(io->TotalByteSize());
+      }
+    }
+  }
+
+  // Compress the input data up front, its compressed size is the
+  // POST size.
+  const bool compress_input =
+      (request_compression_ != InferHttpContext::CompressionType::NONE) &&
+      (http_request->total_input_byte_size_ > 0);
+  if (compress_input) {
+    Error err = http_request->CompressInput(request_compression_);
+    if (!err.IsOk()) {
+      return err;
     }
   }
 
   // Set the expected POST size. If you want to POST large amounts of
   // data, consider CURLOPT_POSTFIELDSIZE_LARGE
   curl_easy_setopt(
-      curl, CURLOPT_POSTFIELDSIZE, http_request->total_input_byte_size_);
-
-  // Headers to specify input and output tensors
-  infer_request_str_.clear();
-  infer_request_str_ = std::string(kInferRequestHTTPHeader) + ":" +
-                       infer_request_.ShortDebugString();
+      curl, CURLOPT_POSTFIELDSIZE,
+      compress_input ? http_request->compressed_input_.size()
+                     : http_request->total_input_byte_size_);
+
+  // Headers to specify input and output tensors. The request header
+  // is sent serialized, which the server parses much faster than the
+  // text format.
+  std::string serialized_request;
+  infer_request_.SerializeToString(&serialized_request);
+  infer_request_str_ = std::string(kInferRequestBinaryHTTPHeader) + ":" +
+                       Base64Encode(serialized_request);
   struct curl_slist* list = nullptr;
   list = curl_slist_append(list, "Expect:");
   list = curl_slist_append(list, "Content-Type: application/octet-stream");
   list = curl_slist_append(list, infer_request_str_.c_str());
+  if (compress_input) {
+    list = curl_slist_append(
+        list, (request_compression_ == InferHttpContext::CompressionType::GZIP)
+                  ? "Content-Encoding: gzip"
+                  : "Content-Encoding: deflate");
+  }
   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
 
   // The list should be freed after the request
@@ -1191,9 +1618,22 @@ InferHttpContext::Create(
     std::unique_ptr<InferContext>* ctx, CorrelationID correlation_id,
     const std::string& server_url, const std::string& model_name,
     int64_t model_version, bool verbose)
+{
+  return Create(
+      ctx, correlation_id, server_url, model_name, model_version,
+      CompressionType::NONE, CompressionType::NONE, verbose);
+}
+
+Error
+InferHttpContext::Create(
+    std::unique_ptr<InferContext>* ctx, CorrelationID correlation_id,
+    const std::string& server_url, const std::string& model_name,
+    int64_t model_version, CompressionType request_compression,
+    CompressionType response_compression, bool verbose)
 {
   InferHttpContextImpl* ctx_ptr = new InferHttpContextImpl(
-      server_url, model_name, model_version, correlation_id, verbose);
+      server_url, model_name, model_version, correlation_id,
+      request_compression, response_compression, verbose);
   ctx->reset(static_cast<InferContext*>(ctx_ptr));
 
   Error err = ctx_ptr->InitHttp(server_url);
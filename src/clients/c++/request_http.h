@@ -39,7 +39,9 @@ class ServerHealthHttpContext {
  public:
   /// Create a context that returns health information.
   /// \param ctx Returns a new ServerHealthHttpContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -57,7 +59,9 @@ class ServerStatusHttpContext {
   /// Create a context that returns information about an inference
   /// server and all models on the server using HTTP protocol.
   /// \param ctx Returns a new ServerStatusHttpContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -68,7 +72,9 @@ class ServerStatusHttpContext {
   /// Create a context that returns information about an inference
   /// server and one model on the sever using HTTP protocol.
   /// \param ctx Returns a new ServerStatusHttpContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
@@ -86,7 +92,9 @@ class ProfileHttpContext {
   /// Create context that controls profiling on a server using HTTP
   /// protocol.
   /// \param ctx Returns the new ProfileContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \return Error object indicating success or failure.
@@ -95,16 +103,51 @@ class ProfileHttpContext {
       bool verbose = false);
 };
 
+//==============================================================================
+/// SharedMemoryControlHttpContext is the HTTP instantiation of
+/// SharedMemoryControlContext.
+///
+class SharedMemoryControlHttpContext {
+ public:
+  /// Create context that registers and unregisters shared-memory
+  /// regions on a server using HTTP protocol.
+  /// \param ctx Returns the new SharedMemoryControlContext object.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
+  /// \param verbose If true generate verbose output when contacting
+  /// the inference server.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<SharedMemoryControlContext>* ctx,
+      const std::string& server_url, bool verbose = false);
+};
+
 //==============================================================================
 /// InferHttpContext is the HTTP instantiation of InferContext.
 ///
 class InferHttpContext {
  public:
+  /// The encodings that can be used to compress the body of
+  /// inference requests and responses.
+  enum CompressionType {
+    /// The body is not compressed.
+    NONE = 0,
+
+    /// The body is compressed with deflate (RFC 1950).
+    DEFLATE = 1,
+
+    /// The body is compressed with gzip (RFC 1952).
+    GZIP = 2
+  };
+
   /// Create context that performs inference for a non-sequence model
   /// using HTTP protocol.
   ///
   /// \param ctx Returns a new InferHttpContext object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -124,7 +167,9 @@ class InferHttpContext {
   /// \param correlation_id The correlation ID to use for all
   /// inferences performed with this context. A value of 0 (zero)
   /// indicates that no correlation ID should be used.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
   /// \param model_name The name of the model to get status for.
   /// \param model_version The version of the model to use for inference,
   /// or -1 to indicate that the latest (i.e. highest version number)
@@ -136,6 +181,38 @@ class InferHttpContext {
       std::unique_ptr<InferContext>* ctx, CorrelationID correlation_id,
       const std::string& server_url, const std::string& model_name,
       int64_t model_version = -1, bool verbose = false);
+
+  /// Create context that performs inference using the HTTP protocol
+  /// and compresses the bodies of the inference requests and/or
+  /// responses. Compression reduces the bytes on the network at the
+  /// cost of CPU time on both the client and the server, so it is
+  /// worthwhile for large inputs or outputs on a bandwidth-limited
+  /// network.
+  ///
+  /// \param ctx Returns a new InferHttpContext object.
+  /// \param correlation_id The correlation ID to use for all
+  /// inferences performed with this context. A value of 0 (zero)
+  /// indicates that no correlation ID should be used.
+  /// \param server_url The inference server name and port, or
+  /// unix:/path/to/socket for a server listening on that Unix domain
+  /// socket.
+  /// \param model_name The name of the model to get status for.
+  /// \param model_version The version of the model to use for inference,
+  /// or -1 to indicate that the latest (i.e. highest version number)
+  /// version should be used.
+  /// \param request_compression The encoding used to compress the
+  /// input data sent to the server.
+  /// \param response_compression The encoding the server is asked to
+  /// use for the response. The server only compresses responses that
+  /// exceed its --http-compression-threshold.
+  /// \param verbose If true generate verbose output when contacting
+  /// the inference server.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<InferContext>* ctx, CorrelationID correlation_id,
+      const std::string& server_url, const std::string& model_name,
+      int64_t model_version, CompressionType request_compression,
+      CompressionType response_compression, bool verbose = false);
 };
 
 }}}  // namespace nvidia::inferenceserver::client
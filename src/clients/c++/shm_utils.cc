@@ -0,0 +1,111 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/clients/c++/shm_utils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nvidia { namespace inferenceserver { namespace client {
+
+Error
+CreateSharedMemoryRegion(
+    const std::string& shm_key, size_t byte_size, int* shm_fd)
+{
+  *shm_fd = shm_open(shm_key.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  if (*shm_fd == -1) {
+    return Error(
+        RequestStatusCode::INTERNAL, "unable to create shared memory '" +
+                                         shm_key + "': " + strerror(errno));
+  }
+
+  if (ftruncate(*shm_fd, byte_size) == -1) {
+    const int err = errno;
+    close(*shm_fd);
+    *shm_fd = -1;
+    return Error(
+        RequestStatusCode::INTERNAL, "unable to resize shared memory '" +
+                                         shm_key + "': " + strerror(err));
+  }
+
+  return Error::Success;
+}
+
+Error
+MapSharedMemory(int shm_fd, size_t offset, size_t byte_size, void** shm_addr)
+{
+  *shm_addr = mmap(
+      nullptr, byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, offset);
+  if (*shm_addr == MAP_FAILED) {
+    *shm_addr = nullptr;
+    return Error(
+        RequestStatusCode::INTERNAL,
+        "unable to map shared memory: " + std::string(strerror(errno)));
+  }
+
+  return Error::Success;
+}
+
+Error
+UnmapSharedMemory(void* shm_addr, size_t byte_size)
+{
+  if (munmap(shm_addr, byte_size) == -1) {
+    return Error(
+        RequestStatusCode::INTERNAL,
+        "unable to unmap shared memory: " + std::string(strerror(errno)));
+  }
+
+  return Error::Success;
+}
+
+Error
+CloseSharedMemory(int shm_fd)
+{
+  if (close(shm_fd) == -1) {
+    return Error(
+        RequestStatusCode::INTERNAL,
+        "unable to close shared memory: " + std::string(strerror(errno)));
+  }
+
+  return Error::Success;
+}
+
+Error
+UnlinkSharedMemoryRegion(const std::string& shm_key)
+{
+  if (shm_unlink(shm_key.c_str()) == -1) {
+    return Error(
+        RequestStatusCode::INTERNAL, "unable to unlink shared memory '" +
+                                         shm_key + "': " + strerror(errno));
+  }
+
+  return Error::Success;
+}
+
+}}}  // namespace nvidia::inferenceserver::client
@@ -0,0 +1,78 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+/// \file
+
+#include <string>
+#include "src/clients/c++/request.h"
+
+namespace nvidia { namespace inferenceserver { namespace client {
+
+//==============================================================================
+// Helpers for managing the POSIX shared-memory objects that back the
+// regions registered with a SharedMemoryControlContext.
+
+/// Create a POSIX shared-memory object and size it to hold
+/// 'byte_size' bytes. The object is created if it does not exist.
+/// \param shm_key The key of the shared-memory object, for example
+/// "/input_data".
+/// \param byte_size The size, in bytes, of the object.
+/// \param shm_fd Returns the file descriptor of the object.
+/// \return Error object indicating success or failure.
+Error CreateSharedMemoryRegion(
+    const std::string& shm_key, size_t byte_size, int* shm_fd);
+
+/// Map a range of a shared-memory object into the address space of
+/// the calling process.
+/// \param shm_fd The file descriptor of the object.
+/// \param offset The offset, in bytes, of the range from the start of
+/// the object. Must be a multiple of the page size.
+/// \param byte_size The size, in bytes, of the range.
+/// \param shm_addr Returns the address of the mapped range.
+/// \return Error object indicating success or failure.
+Error MapSharedMemory(
+    int shm_fd, size_t offset, size_t byte_size, void** shm_addr);
+
+/// Unmap a range previously mapped with MapSharedMemory().
+/// \param shm_addr The address of the mapped range.
+/// \param byte_size The size, in bytes, of the mapped range.
+/// \return Error object indicating success or failure.
+Error UnmapSharedMemory(void* shm_addr, size_t byte_size);
+
+/// Close the file descriptor of a shared-memory object. Mapped ranges
+/// remain valid after the descriptor is closed.
+/// \param shm_fd The file descriptor of the object.
+/// \return Error object indicating success or failure.
+Error CloseSharedMemory(int shm_fd);
+
+/// Remove a shared-memory object. The memory is released once every
+/// process, including the inference server, has unmapped it.
+/// \param shm_key The key of the shared-memory object.
+/// \return Error object indicating success or failure.
+Error UnlinkSharedMemoryRegion(const std::string& shm_key);
+
+}}}  // namespace nvidia::inferenceserver::client
@@ -88,6 +88,34 @@ _crequest_status_ctx_get = _crequest.ServerStatusContextGetServerStatus
 _crequest_status_ctx_get.restype = c_void_p
 _crequest_status_ctx_get.argtypes = [c_void_p, POINTER(c_char_p), POINTER(c_uint32)]
 
+_crequest_shm_control_ctx_new = _crequest.SharedMemoryControlContextNew
+_crequest_shm_control_ctx_new.restype = c_void_p
+_crequest_shm_control_ctx_new.argtypes = [POINTER(c_void_p), _utf8, c_int, c_bool]
+_crequest_shm_control_ctx_del = _crequest.SharedMemoryControlContextDelete
+_crequest_shm_control_ctx_del.argtypes = [c_void_p]
+_crequest_shm_control_ctx_register = _crequest.SharedMemoryControlContextRegister
+_crequest_shm_control_ctx_register.restype = c_void_p
+_crequest_shm_control_ctx_register.argtypes = [c_void_p, _utf8, _utf8, c_uint64, c_uint64]
+_crequest_shm_control_ctx_unregister = _crequest.SharedMemoryControlContextUnregister
+_crequest_shm_control_ctx_unregister.restype = c_void_p
+_crequest_shm_control_ctx_unregister.argtypes = [c_void_p, _utf8]
+_crequest_shm_control_ctx_unregister_all = _crequest.SharedMemoryControlContextUnregisterAll
+_crequest_shm_control_ctx_unregister_all.restype = c_void_p
+_crequest_shm_control_ctx_unregister_all.argtypes = [c_void_p]
+
+_crequest_shm_region_new = _crequest.SharedMemoryRegionNew
+_crequest_shm_region_new.restype = c_void_p
+_crequest_shm_region_new.argtypes = [POINTER(c_void_p), _utf8, c_uint64]
+_crequest_shm_region_del = _crequest.SharedMemoryRegionDelete
+_crequest_shm_region_del.restype = c_void_p
+_crequest_shm_region_del.argtypes = [c_void_p]
+_crequest_shm_region_set = _crequest.SharedMemoryRegionSet
+_crequest_shm_region_set.restype = c_void_p
+_crequest_shm_region_set.argtypes = [c_void_p, c_uint64, c_uint64, c_void_p]
+_crequest_shm_region_get = _crequest.SharedMemoryRegionGet
+_crequest_shm_region_get.restype = c_void_p
+_crequest_shm_region_get.argtypes = [c_void_p, c_uint64, c_uint64, POINTER(c_char_p)]
+
 _crequest_infer_ctx_new = _crequest.InferContextNew
 _crequest_infer_ctx_new.restype = c_void_p
 _crequest_infer_ctx_new.argtypes = [POINTER(c_void_p), _utf8, c_int, _utf8, c_int64, c_uint64, c_bool, c_bool]
@@ -120,6 +148,9 @@ _crequest_infer_ctx_options_add_raw.argtypes = [c_void_p, c_void_p, _utf8]
 _crequest_infer_ctx_options_add_class = _crequest.InferContextOptionsAddClass
 _crequest_infer_ctx_options_add_class.restype = c_void_p
 _crequest_infer_ctx_options_add_class.argtypes = [c_void_p, c_void_p, _utf8, c_uint64]
+_crequest_infer_ctx_options_add_shm = _crequest.InferContextOptionsAddSharedMemory
+_crequest_infer_ctx_options_add_shm.restype = c_void_p
+_crequest_infer_ctx_options_add_shm.argtypes = [c_void_p, c_void_p, _utf8, _utf8, c_uint64, c_uint64]
 
 _crequest_infer_ctx_input_new = _crequest.InferContextInputNew
 _crequest_infer_ctx_input_new.restype = c_void_p
@@ -134,6 +165,9 @@ _crequest_infer_ctx_input_set_shape.argtypes = [c_void_p,
 _crequest_infer_ctx_input_set_raw = _crequest.InferContextInputSetRaw
 _crequest_infer_ctx_input_set_raw.restype = c_void_p
 _crequest_infer_ctx_input_set_raw.argtypes = [c_void_p, c_void_p, c_uint64]
+_crequest_infer_ctx_input_set_shm = _crequest.InferContextInputSetSharedMemory
+_crequest_infer_ctx_input_set_shm.restype = c_void_p
+_crequest_infer_ctx_input_set_shm.argtypes = [c_void_p, _utf8, c_uint64, c_uint64]
 
 _crequest_infer_ctx_result_new = _crequest.InferContextResultNew
 _crequest_infer_ctx_result_new.restype = c_void_p
@@ -297,7 +331,9 @@ class ServerHealthContext:
     Parameters
     ----------
     url : str
-        The inference server URL, e.g. localhost:8000.
+        The inference server URL, e.g. localhost:8000, or
+        unix:/path/to/socket for a server listening on that Unix
+        domain socket.
 
     protocol : ProtocolType
         The protocol used to communicate with the server.
@@ -403,7 +439,9 @@ class ServerStatusContext:
     Parameters
     ----------
     url : str
-        The inference server URL, e.g. localhost:8000.
+        The inference server URL, e.g. localhost:8000, or
+        unix:/path/to/socket for a server listening on that Unix
+        domain socket.
 
     protocol : ProtocolType
         The protocol used to communicate with the server.
@@ -486,6 +524,334 @@ class ServerStatusContext:
         return self._last_request_id
 
 
+class SharedMemoryControlContext:
+    """Registers and unregisters system shared-memory regions with an
+    inference server.
+
+    A registered region can be used by InferContext to pass input
+    values to the server and to receive output values from the server
+    without copying them into the request or response. Shared-memory
+    regions can only be used when the client and server are on the
+    same host.
+
+    Parameters
+    ----------
+    url : str
+        The inference server URL, e.g. localhost:8000, or
+        unix:/path/to/socket for a server listening on that Unix
+        domain socket.
+
+    protocol : ProtocolType
+        The protocol used to communicate with the server.
+
+    verbose : bool
+        If True generate verbose output.
+
+    """
+    def __init__(self, url, protocol, verbose=False):
+        self._last_request_id = 0
+        self._ctx = c_void_p()
+        _raise_if_error(
+            c_void_p(
+                _crequest_shm_control_ctx_new(
+                    byref(self._ctx), url, int(protocol), verbose)))
+
+    def __del__(self):
+        # when module is unloading may get called after
+        # _crequest_shm_control_ctx_del has been released
+        if _crequest_shm_control_ctx_del is not None:
+            self.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self.close()
+
+    def close(self):
+        """Close the context. Any future calls to register(),
+        unregister() or unregister_all() will result in an Error.
+
+        """
+        _crequest_shm_control_ctx_del(self._ctx)
+        self._ctx = None
+
+    def register(self, name, shm_key, offset, byte_size):
+        """Register a shared-memory region with the inference server.
+
+        Parameters
+        ----------
+        name : str
+            The name used to refer to the region in inference requests.
+
+        shm_key : str
+            The key of the POSIX shared-memory object that holds the
+            region, e.g. /input_data.
+
+        offset : int
+            The offset, in bytes, of the region from the start of the
+            shared-memory object.
+
+        byte_size : int
+            The size, in bytes, of the region.
+
+        Raises
+        ------
+        InferenceServerException
+            If unable to register the region.
+
+        """
+        self._last_request_id = None
+        if self._ctx is None:
+            _raise_error("SharedMemoryControlContext is closed")
+
+        self._last_request_id = _raise_if_error(
+            c_void_p(
+                _crequest_shm_control_ctx_register(
+                    self._ctx, name, shm_key, c_uint64(offset),
+                    c_uint64(byte_size))))
+
+    def unregister(self, name):
+        """Unregister a shared-memory region from the inference server.
+
+        Parameters
+        ----------
+        name : str
+            The name of the region to unregister.
+
+        Raises
+        ------
+        InferenceServerException
+            If unable to unregister the region.
+
+        """
+        self._last_request_id = None
+        if self._ctx is None:
+            _raise_error("SharedMemoryControlContext is closed")
+
+        self._last_request_id = _raise_if_error(
+            c_void_p(_crequest_shm_control_ctx_unregister(self._ctx, name)))
+
+    def unregister_all(self):
+        """Unregister all shared-memory regions from the inference server.
+
+        Raises
+        ------
+        InferenceServerException
+            If unable to unregister the regions.
+
+        """
+        self._last_request_id = None
+        if self._ctx is None:
+            _raise_error("SharedMemoryControlContext is closed")
+
+        self._last_request_id = _raise_if_error(
+            c_void_p(_crequest_shm_control_ctx_unregister_all(self._ctx)))
+
+    def get_last_request_id(self):
+        """Get the request ID of the most recent register(), unregister()
+        or unregister_all() request.
+
+        Returns
+        -------
+        int
+            The request ID, or None if a request has not yet been made
+            or if the last request was not successful.
+
+        """
+        return self._last_request_id
+
+
+class SharedMemoryRegion:
+    """A POSIX shared-memory object created and mapped by this process.
+
+    The object is created when the SharedMemoryRegion is created and
+    is removed when it is closed. Use SharedMemoryControlContext to
+    register the object, or ranges of it, with the inference server.
+
+    Parameters
+    ----------
+    shm_key : str
+        The key of the shared-memory object, e.g. /input_data.
+
+    byte_size : int
+        The size, in bytes, of the shared-memory object.
+
+    """
+    def __init__(self, shm_key, byte_size):
+        self._shm_key = shm_key
+        self._byte_size = byte_size
+        self._ctx = c_void_p()
+        _raise_if_error(
+            c_void_p(
+                _crequest_shm_region_new(
+                    byref(self._ctx), shm_key, c_uint64(byte_size))))
+
+    def __del__(self):
+        # when module is unloading may get called after
+        # _crequest_shm_region_del has been released
+        if _crequest_shm_region_del is not None:
+            self.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self.close()
+
+    def close(self):
+        """Unmap and remove the shared-memory object. The inference server
+        keeps its own mapping until the region is unregistered.
+
+        """
+        if self._ctx is not None:
+            ctx = self._ctx
+            self._ctx = None
+            _raise_if_error(c_void_p(_crequest_shm_region_del(ctx)))
+
+    def shm_key(self):
+        """Get the key of the shared-memory object.
+
+        Returns
+        -------
+        str
+            The key.
+
+        """
+        return self._shm_key
+
+    def byte_size(self):
+        """Get the size of the shared-memory object.
+
+        Returns
+        -------
+        int
+            The size, in bytes.
+
+        """
+        return self._byte_size
+
+    def set(self, values, offset=0):
+        """Copy numpy arrays into the shared-memory object. The arrays are
+        copied back-to-back in order starting at 'offset'.
+
+        Parameters
+        ----------
+        values : list
+            The numpy arrays to copy. Arrays of string objects are not
+            supported.
+
+        offset : int
+            The offset, in bytes, from the start of the object at
+            which to copy the first array.
+
+        Returns
+        -------
+        int
+            The total number of bytes copied.
+
+        Raises
+        ------
+        InferenceServerException
+            If the arrays do not fit in the shared-memory object.
+
+        """
+        if self._ctx is None:
+            _raise_error("SharedMemoryRegion is closed")
+
+        total_byte_size = 0
+        for value in values:
+            if value.dtype == np.object:
+                _raise_error("string tensors cannot be set in shared memory")
+            if not value.flags['C_CONTIGUOUS']:
+                value = np.ascontiguousarray(value)
+            byte_size = value.size * value.itemsize
+            _raise_if_error(
+                c_void_p(
+                    _crequest_shm_region_set(
+                        self._ctx, c_uint64(offset + total_byte_size),
+                        c_uint64(byte_size), value.ctypes.data_as(c_void_p))))
+            total_byte_size += byte_size
+
+        return total_byte_size
+
+    def get(self, dtype, shape, offset=0):
+        """Get a copy of the contents of the shared-memory object as a
+        numpy array.
+
+        Parameters
+        ----------
+        dtype : numpy.dtype
+            The datatype of the array.
+
+        shape : list
+            The shape of the array.
+
+        offset : int
+            The offset, in bytes, from the start of the object of the
+            array values.
+
+        Returns
+        -------
+        numpy.ndarray
+            The array.
+
+        Raises
+        ------
+        InferenceServerException
+            If the array does not fit in the shared-memory object.
+
+        """
+        if self._ctx is None:
+            _raise_error("SharedMemoryRegion is closed")
+
+        dtype = np.dtype(dtype)
+        byte_size = int(np.prod(shape)) * dtype.itemsize
+        cval = c_char_p()
+        _raise_if_error(
+            c_void_p(
+                _crequest_shm_region_get(
+                    self._ctx, c_uint64(offset), c_uint64(byte_size),
+                    byref(cval))))
+        if byte_size == 0:
+            return np.empty(shape, dtype=dtype)
+
+        val_buf = cast(cval, POINTER(c_byte * byte_size))[0]
+        return np.reshape(np.copy(np.frombuffer(val_buf, dtype=dtype)), shape)
+
+
+class SharedMemoryRange:
+    """A range of a shared-memory region registered with
+    SharedMemoryControlContext. Used in place of the input values or
+    result format when running an InferContext to have the server read
+    an input from, or write an output to, shared memory.
+
+    Parameters
+    ----------
+    name : str
+        The name of the registered region.
+
+    offset : int
+        The offset, in bytes, of the range from the start of the
+        region.
+
+    byte_size : int
+        The size, in bytes, of the range. For an input this is the
+        size of the values for the entire batch.
+
+    shape : list
+        For an input, the shape of one batch entry of the input. Must
+        be given for inputs that have variable-size dimensions and is
+        ignored for outputs.
+
+    """
+    def __init__(self, name, offset, byte_size, shape=None):
+        self.name = name
+        self.offset = offset
+        self.byte_size = byte_size
+        self.shape = shape
+
+
 class InferContext:
     """An InferContext object is used to run inference on an inference
     server for a specific model.
@@ -496,7 +862,9 @@ class InferContext:
     Parameters
     ----------
     url : str
-        The inference server URL, e.g. localhost:8000.
+        The inference server URL, e.g. localhost:8000, or
+        unix:/path/to/socket for a server listening on that Unix
+        domain socket.
 
     protocol : ProtocolType
         The protocol used to communicate with the server.
@@ -603,7 +971,7 @@ class InferContext:
         # specify an input directly as an array instead of as a list
         # containing one array.
         for inp_name, inp in inputs.items():
-            if not isinstance(inp, (list, tuple)):
+            if not isinstance(inp, (list, tuple, SharedMemoryRange)):
                 _raise_error("input '" + inp_name +
                              "' values must be specified as a list of numpy arrays")
 
@@ -624,6 +992,13 @@ class InferContext:
                         c_void_p(
                             _crequest_infer_ctx_options_add_class(
                                 self._ctx, options, output_name, c_uint64(output_format[1]))))
+                elif isinstance(output_format, SharedMemoryRange):
+                    _raise_if_error(
+                        c_void_p(
+                            _crequest_infer_ctx_options_add_shm(
+                                self._ctx, options, output_name, output_format.name,
+                                c_uint64(output_format.offset),
+                                c_uint64(output_format.byte_size))))
                 else:
                     _raise_error("unrecognized output format")
 
@@ -639,6 +1014,23 @@ class InferContext:
                 _raise_if_error(
                     c_void_p(_crequest_infer_ctx_input_new(byref(input), self._ctx, input_name)))
 
+                # Values in shared memory are read by the server
+                # directly from the region.
+                if isinstance(input_values, SharedMemoryRange):
+                    if input_values.shape is not None:
+                        shape_value = np.asarray(input_values.shape, dtype=np.int64)
+                        _raise_if_error(
+                            c_void_p(
+                                _crequest_infer_ctx_input_set_shape(
+                                    input, shape_value, c_uint64(shape_value.size))))
+                    _raise_if_error(
+                        c_void_p(
+                            _crequest_infer_ctx_input_set_shm(
+                                input, input_values.name,
+                                c_uint64(input_values.offset),
+                                c_uint64(input_values.byte_size))))
+                    continue
+
                 # Set the input shape
                 if len(input_values) > 0:
                     shape_value = np.asarray(input_values[0].shape, dtype=np.int64)
@@ -692,6 +1084,10 @@ class InferContext:
         # Create the result map.
         results = dict()
         for (output_name, output_format) in iteritems(outputs):
+            # Outputs written into shared memory have no result.
+            if isinstance(output_format, SharedMemoryRange):
+                continue
+
             result = c_void_p()
             try:
                 _raise_if_error(
@@ -822,7 +1218,9 @@ class InferContext:
             input. An input value is specified as a numpy array. Each
             input in the dictionary maps to a list of values (i.e. a
             list of numpy array objects), where the length of the list
-            must equal the 'batch_size'.
+            must equal the 'batch_size'. An input can instead map to
+            a SharedMemoryRange to have the server read the values
+            for the entire batch from shared memory.
 
         outputs : dict
             Dictionary from output name to a value indicating the
@@ -830,7 +1228,10 @@ class InferContext:
             the value should be ResultFormat.RAW. For CLASS the value
             should be a tuple (ResultFormat.CLASS, k), where 'k'
             indicates how many classification results should be
-            returned for the output.
+            returned for the output. An output can instead map to a
+            SharedMemoryRange to have the server write the output into
+            shared memory, in which case no value is returned for the
+            output.
 
         batch_size : int
             The batch size of the inference. Each input must provide
@@ -893,7 +1294,9 @@ class InferContext:
             input. An input value is specified as a numpy array. Each
             input in the dictionary maps to a list of values (i.e. a
             list of numpy array objects), where the length of the list
-            must equal the 'batch_size'.
+            must equal the 'batch_size'. An input can instead map to
+            a SharedMemoryRange to have the server read the values
+            for the entire batch from shared memory.
 
         outputs : dict
             Dictionary from output name to a value indicating the
@@ -901,7 +1304,10 @@ class InferContext:
             the value should be ResultFormat.RAW. For CLASS the value
             should be a tuple (ResultFormat.CLASS, k), where 'k'
             indicates how many classification results should be
-            returned for the output.
+            returned for the output. An output can instead map to a
+            SharedMemoryRange to have the server write the output into
+            shared memory, in which case no value is returned for the
+            output.
 
         batch_size : int
             The batch size of the inference. Each input must provide
@@ -26,9 +26,11 @@
 
 #include "src/clients/python/crequest.h"
 
+#include <string.h>
 #include <iostream>
 #include "src/clients/c++/request_grpc.h"
 #include "src/clients/c++/request_http.h"
+#include "src/clients/c++/shm_utils.h"
 
 namespace ni = nvidia::inferenceserver;
 namespace nic = nvidia::inferenceserver::client;
@@ -228,6 +230,159 @@ ServerStatusContextGetServerStatus(
   return new nic::Error(err);
 }
 
+//==============================================================================
+struct SharedMemoryControlContextCtx {
+  std::unique_ptr<nic::SharedMemoryControlContext> ctx;
+};
+
+nic::Error*
+SharedMemoryControlContextNew(
+    SharedMemoryControlContextCtx** ctx, const char* url, int protocol_int,
+    bool verbose)
+{
+  nic::Error err;
+  ProtocolType protocol;
+  err = ParseProtocol(&protocol, protocol_int);
+  if (err.IsOk()) {
+    SharedMemoryControlContextCtx* lctx = new SharedMemoryControlContextCtx;
+    if (protocol == ProtocolType::HTTP) {
+      err = nic::SharedMemoryControlHttpContext::Create(
+          &(lctx->ctx), std::string(url), verbose);
+    } else {
+      err = nic::SharedMemoryControlGrpcContext::Create(
+          &(lctx->ctx), std::string(url), verbose);
+    }
+
+    if (err.IsOk()) {
+      *ctx = lctx;
+      return nullptr;
+    }
+
+    delete lctx;
+  }
+
+  *ctx = nullptr;
+  return new nic::Error(err);
+}
+
+void
+SharedMemoryControlContextDelete(SharedMemoryControlContextCtx* ctx)
+{
+  delete ctx;
+}
+
+nic::Error*
+SharedMemoryControlContextRegister(
+    SharedMemoryControlContextCtx* ctx, const char* name, const char* shm_key,
+    uint64_t offset, uint64_t byte_size)
+{
+  nic::Error err = ctx->ctx->RegisterSharedMemory(
+      std::string(name), std::string(shm_key), offset, byte_size);
+  return new nic::Error(err);
+}
+
+nic::Error*
+SharedMemoryControlContextUnregister(
+    SharedMemoryControlContextCtx* ctx, const char* name)
+{
+  nic::Error err = ctx->ctx->UnregisterSharedMemory(std::string(name));
+  return new nic::Error(err);
+}
+
+nic::Error*
+SharedMemoryControlContextUnregisterAll(SharedMemoryControlContextCtx* ctx)
+{
+  nic::Error err = ctx->ctx->UnregisterAllSharedMemory();
+  return new nic::Error(err);
+}
+
+//==============================================================================
+struct SharedMemoryRegionCtx {
+  std::string shm_key;
+  int shm_fd;
+  void* base;
+  uint64_t byte_size;
+};
+
+nic::Error*
+SharedMemoryRegionNew(
+    SharedMemoryRegionCtx** ctx, const char* shm_key, uint64_t byte_size)
+{
+  SharedMemoryRegionCtx* lctx = new SharedMemoryRegionCtx;
+  lctx->shm_key = std::string(shm_key);
+  lctx->base = nullptr;
+  lctx->byte_size = byte_size;
+
+  nic::Error err =
+      nic::CreateSharedMemoryRegion(lctx->shm_key, byte_size, &lctx->shm_fd);
+  if (err.IsOk()) {
+    err = nic::MapSharedMemory(lctx->shm_fd, 0, byte_size, &lctx->base);
+    if (err.IsOk()) {
+      *ctx = lctx;
+      return nullptr;
+    }
+
+    nic::CloseSharedMemory(lctx->shm_fd);
+    nic::UnlinkSharedMemoryRegion(lctx->shm_key);
+  }
+
+  delete lctx;
+  *ctx = nullptr;
+  return new nic::Error(err);
+}
+
+nic::Error*
+SharedMemoryRegionDelete(SharedMemoryRegionCtx* ctx)
+{
+  nic::Error err = nic::UnmapSharedMemory(ctx->base, ctx->byte_size);
+  nic::Error close_err = nic::CloseSharedMemory(ctx->shm_fd);
+  nic::Error unlink_err = nic::UnlinkSharedMemoryRegion(ctx->shm_key);
+  delete ctx;
+
+  if (!err.IsOk()) {
+    return new nic::Error(err);
+  }
+  if (!close_err.IsOk()) {
+    return new nic::Error(close_err);
+  }
+  return new nic::Error(unlink_err);
+}
+
+nic::Error*
+SharedMemoryRegionSet(
+    SharedMemoryRegionCtx* ctx, uint64_t offset, uint64_t byte_size,
+    const void* data)
+{
+  if ((offset > ctx->byte_size) || (byte_size > (ctx->byte_size - offset))) {
+    return new nic::Error(
+        ni::RequestStatusCode::INVALID_ARG,
+        "unable to write " + std::to_string(byte_size) +
+            " bytes at offset " + std::to_string(offset) +
+            " into shared memory '" + ctx->shm_key + "' of size " +
+            std::to_string(ctx->byte_size));
+  }
+
+  memcpy(reinterpret_cast<char*>(ctx->base) + offset, data, byte_size);
+  return new nic::Error(nic::Error::Success);
+}
+
+nic::Error*
+SharedMemoryRegionGet(
+    SharedMemoryRegionCtx* ctx, uint64_t offset, uint64_t byte_size,
+    const char** data)
+{
+  if ((offset > ctx->byte_size) || (byte_size > (ctx->byte_size - offset))) {
+    return new nic::Error(
+        ni::RequestStatusCode::INVALID_ARG,
+        "unable to read " + std::to_string(byte_size) + " bytes at offset " +
+            std::to_string(offset) + " from shared memory '" + ctx->shm_key +
+            "' of size " + std::to_string(ctx->byte_size));
+  }
+
+  *data = reinterpret_cast<const char*>(ctx->base) + offset;
+  return new nic::Error(nic::Error::Success);
+}
+
 //==============================================================================
 struct InferContextCtx {
   std::unique_ptr<nic::InferContext> ctx;
@@ -394,6 +549,22 @@ InferContextOptionsAddClass(
   return new nic::Error(err);
 }
 
+nic::Error*
+InferContextOptionsAddSharedMemory(
+    InferContextCtx* infer_ctx, nic::InferContext::Options* ctx,
+    const char* output_name, const char* shm_name, uint64_t offset,
+    uint64_t byte_size)
+{
+  std::shared_ptr<nic::InferContext::Output> output;
+  nic::Error err = infer_ctx->ctx->GetOutput(std::string(output_name), &output);
+  if (err.IsOk()) {
+    err = ctx->AddSharedMemoryResult(
+        output, std::string(shm_name), offset, byte_size);
+  }
+
+  return new nic::Error(err);
+}
+
 //==============================================================================
 struct InferContextInputCtx {
   std::shared_ptr<nic::InferContext::Input> input;
@@ -443,6 +614,16 @@ InferContextInputSetRaw(
   return new nic::Error(err);
 }
 
+nic::Error*
+InferContextInputSetSharedMemory(
+    InferContextInputCtx* ctx, const char* shm_name, uint64_t offset,
+    uint64_t byte_size)
+{
+  nic::Error err =
+      ctx->input->SetSharedMemory(std::string(shm_name), offset, byte_size);
+  return new nic::Error(err);
+}
+
 //==============================================================================
 struct InferContextResultCtx {
   std::unique_ptr<nic::InferContext::Result> result;
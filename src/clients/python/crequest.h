@@ -67,6 +67,34 @@ void ServerStatusContextDelete(ServerStatusContextCtx* ctx);
 nic::Error* ServerStatusContextGetServerStatus(
     ServerStatusContextCtx* ctx, char** status, uint32_t* status_len);
 
+//==============================================================================
+// SharedMemoryControlContext
+typedef struct SharedMemoryControlContextCtx SharedMemoryControlContextCtx;
+nic::Error* SharedMemoryControlContextNew(
+    SharedMemoryControlContextCtx** ctx, const char* url, int protocol_int,
+    bool verbose);
+void SharedMemoryControlContextDelete(SharedMemoryControlContextCtx* ctx);
+nic::Error* SharedMemoryControlContextRegister(
+    SharedMemoryControlContextCtx* ctx, const char* name, const char* shm_key,
+    uint64_t offset, uint64_t byte_size);
+nic::Error* SharedMemoryControlContextUnregister(
+    SharedMemoryControlContextCtx* ctx, const char* name);
+nic::Error* SharedMemoryControlContextUnregisterAll(
+    SharedMemoryControlContextCtx* ctx);
+
+//==============================================================================
+// Shared-memory region
+typedef struct SharedMemoryRegionCtx SharedMemoryRegionCtx;
+nic::Error* SharedMemoryRegionNew(
+    SharedMemoryRegionCtx** ctx, const char* shm_key, uint64_t byte_size);
+nic::Error* SharedMemoryRegionDelete(SharedMemoryRegionCtx* ctx);
+nic::Error* SharedMemoryRegionSet(
+    SharedMemoryRegionCtx* ctx, uint64_t offset, uint64_t byte_size,
+    const void* data);
+nic::Error* SharedMemoryRegionGet(
+    SharedMemoryRegionCtx* ctx, uint64_t offset, uint64_t byte_size,
+    const char** data);
+
 //==============================================================================
 // InferContext
 typedef struct InferContextCtx InferContextCtx;
@@ -95,6 +123,10 @@ nic::Error* InferContextOptionsAddRaw(
 nic::Error* InferContextOptionsAddClass(
     InferContextCtx* infer_ctx, nic::InferContext::Options* ctx,
     const char* output_name, uint64_t count);
+nic::Error* InferContextOptionsAddSharedMemory(
+    InferContextCtx* infer_ctx, nic::InferContext::Options* ctx,
+    const char* output_name, const char* shm_name, uint64_t offset,
+    uint64_t byte_size);
 
 //==============================================================================
 // InferContext::Input
@@ -107,6 +139,9 @@ nic::Error* InferContextInputSetShape(
     InferContextInputCtx* ctx, const int64_t* dims, uint64_t size);
 nic::Error* InferContextInputSetRaw(
     InferContextInputCtx* ctx, const void* data, uint64_t byte_size);
+nic::Error* InferContextInputSetSharedMemory(
+    InferContextInputCtx* ctx, const char* shm_name, uint64_t offset,
+    uint64_t byte_size);
 
 //==============================================================================
 // InferContext::Result
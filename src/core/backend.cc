@@ -33,6 +33,8 @@
 #include "src/core/logging.h"
 #include "src/core/metric_model_reporter.h"
 #include "src/core/model_config_utils.h"
+#include "src/core/request_coalescer.h"
+#include "src/core/response_cache.h"
 #include "src/core/sequence_batch_scheduler.h"
 #include "tensorflow/core/lib/io/path.h"
 
@@ -41,6 +43,28 @@ namespace nvidia { namespace inferenceserver {
 Status
 InferenceBackend::GetInput(
     const std::string& name, const ModelInput** input) const
+{
+  uint32_t ordinal;
+  RETURN_IF_ERROR(GetInputOrdinal(name, &ordinal));
+
+  *input = &config_.input(ordinal);
+  return Status::Success;
+}
+
+Status
+InferenceBackend::GetOutput(
+    const std::string& name, const ModelOutput** output) const
+{
+  uint32_t ordinal;
+  RETURN_IF_ERROR(GetOutputOrdinal(name, &ordinal));
+
+  *output = &config_.output(ordinal);
+  return Status::Success;
+}
+
+Status
+InferenceBackend::GetInputOrdinal(
+    const std::string& name, uint32_t* ordinal) const
 {
   const auto itr = input_map_.find(name);
   if (itr == input_map_.end()) {
@@ -49,13 +73,13 @@ InferenceBackend::GetInput(
         "unexpected inference input '" + name + "' for model '" + Name() + "'");
   }
 
-  *input = &itr->second;
+  *ordinal = itr->second;
   return Status::Success;
 }
 
 Status
-InferenceBackend::GetOutput(
-    const std::string& name, const ModelOutput** output) const
+InferenceBackend::GetOutputOrdinal(
+    const std::string& name, uint32_t* ordinal) const
 {
   const auto itr = output_map_.find(name);
   if (itr == output_map_.end()) {
@@ -64,7 +88,7 @@ InferenceBackend::GetOutput(
                                             "' for model '" + Name() + "'");
   }
 
-  *output = &itr->second;
+  *ordinal = itr->second;
   return Status::Success;
 }
 
@@ -86,15 +110,16 @@ InferenceBackend::SetModelConfig(
       Name(), version_, config_.metric_tags());
 
   // Initialize the input map
-  for (const auto& io : config.input()) {
-    input_map_.insert(std::make_pair(io.name(), io));
+  for (int i = 0; i < config_.input_size(); ++i) {
+    input_map_.insert(std::make_pair(config_.input(i).name(), i));
   }
 
   // Initialize the output map and label provider for each output
   label_provider_ = std::make_shared<LabelProvider>();
   const auto model_dir = DirName(path);
-  for (const auto& io : config.output()) {
-    output_map_.insert(std::make_pair(io.name(), io));
+  for (int i = 0; i < config_.output_size(); ++i) {
+    const auto& io = config_.output(i);
+    output_map_.insert(std::make_pair(io.name(), i));
 
     if (!io.label_filename().empty()) {
       const auto label_path = JoinPath({model_dir, io.label_filename()});
@@ -102,6 +127,14 @@ InferenceBackend::SetModelConfig(
     }
   }
 
+  if (config_.has_response_cache()) {
+    response_cache_ = std::make_shared<ResponseCache>(
+        config_.response_cache(), metric_reporter_);
+  }
+  if (config_.has_request_coalescing()) {
+    request_coalescer_ = std::make_shared<RequestCoalescer>();
+  }
+
   return Status::Success;
 }
 
@@ -137,6 +170,22 @@ InferenceBackend::SetConfiguredScheduler(
   return SetScheduler(std::move(scheduler));
 }
 
+void
+InferenceBackend::BeginRunGroup()
+{
+  if (scheduler_ != nullptr) {
+    scheduler_->BeginEnqueueGroup();
+  }
+}
+
+void
+InferenceBackend::EndRunGroup()
+{
+  if (scheduler_ != nullptr) {
+    scheduler_->EndEnqueueGroup();
+  }
+}
+
 void
 InferenceBackend::Run(
     std::shared_ptr<ModelInferStats> stats,
@@ -144,6 +193,52 @@ InferenceBackend::Run(
     std::shared_ptr<InferResponseProvider> response_provider,
     std::function<void(Status)> OnCompleteHandleInfer)
 {
+  // If the model has a response cache then respond from the cache if
+  // possible, otherwise cache the response once it is complete. If
+  // the model coalesces requests then a request identical to one
+  // already in flight waits for that request's response. Responses
+  // are captured from the request's own response provider so it
+  // doesn't matter how the request is batched.
+  if (((response_cache_ != nullptr) || (request_coalescer_ != nullptr)) &&
+      (response_provider != nullptr)) {
+    RequestKey key;
+    Status status = RequestKey::Create(*request_provider, &key);
+    if (status.IsOk()) {
+      std::shared_ptr<const ResponseCache::Response> response;
+      if ((response_cache_ != nullptr) &&
+          response_cache_->Lookup(key, &response)) {
+        OnCompleteHandleInfer(
+            ResponseCache::Respond(*response, response_provider.get()));
+        return;
+      }
+
+      if ((request_coalescer_ != nullptr) &&
+          request_coalescer_->Join(
+              key, response_provider, OnCompleteHandleInfer)) {
+        return;
+      }
+
+      std::shared_ptr<ResponseCache> cache = response_cache_;
+      std::shared_ptr<RequestCoalescer> coalescer = request_coalescer_;
+      scheduler_->Enqueue(
+          stats, request_provider, response_provider,
+          [cache, coalescer, key, response_provider,
+           OnCompleteHandleInfer](Status status) {
+            if ((cache != nullptr) && status.IsOk()) {
+              cache->Insert(key, *response_provider);
+            }
+            if (coalescer != nullptr) {
+              coalescer->Complete(key, status, *response_provider);
+            }
+            OnCompleteHandleInfer(status);
+          });
+      return;
+    }
+
+    LOG_VERBOSE(1) << "failed to compute request key for '" << Name()
+                   << "': " << status.AsString();
+  }
+
   scheduler_->Enqueue(
       stats, request_provider, response_provider, OnCompleteHandleInfer);
 }
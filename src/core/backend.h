@@ -35,6 +35,8 @@ namespace nvidia { namespace inferenceserver {
 class InferRequestProvider;
 class InferResponseProvider;
 class MetricModelReporter;
+class RequestCoalescer;
+class ResponseCache;
 
 //
 // Interface for backends that handle inference requests.
@@ -68,6 +70,16 @@ class InferenceBackend {
   // Get the model configuration for a named output.
   Status GetOutput(const std::string& name, const ModelOutput** output) const;
 
+  // Get the ordinal of a named input within the model
+  // configuration. The configuration of the input is
+  // Config().input(ordinal).
+  Status GetInputOrdinal(const std::string& name, uint32_t* ordinal) const;
+
+  // Get the ordinal of a named output within the model
+  // configuration. The configuration of the output is
+  // Config().output(ordinal).
+  Status GetOutputOrdinal(const std::string& name, uint32_t* ordinal) const;
+
   // Get a label provider for the model.
   const std::shared_ptr<LabelProvider>& GetLabelProvider() const
   {
@@ -83,6 +95,11 @@ class InferenceBackend {
       std::shared_ptr<InferResponseProvider> response_provider,
       std::function<void(Status)> OnCompleteHandleInfer);
 
+  // Mark the beginning and end of a group of requests that are run
+  // together. \see Scheduler::BeginEnqueueGroup()
+  void BeginRunGroup();
+  void EndRunGroup();
+
  protected:
   // Set the configuration of the model being served.
   Status SetModelConfig(const std::string& path, const ModelConfig& config);
@@ -116,11 +133,21 @@ class InferenceBackend {
   // The scheduler to use for this backend.
   std::unique_ptr<Scheduler> scheduler_;
 
-  // Map from input name to the model configuration for that input.
-  std::unordered_map<std::string, ModelInput> input_map_;
+  // The response cache for this backend, or nullptr if responses are
+  // not cached.
+  std::shared_ptr<ResponseCache> response_cache_;
+
+  // The coalescer of identical in-flight requests for this backend,
+  // or nullptr if requests are not coalesced.
+  std::shared_ptr<RequestCoalescer> request_coalescer_;
+
+  // Map from input name to the ordinal of that input in the model
+  // configuration.
+  std::unordered_map<std::string, uint32_t> input_map_;
 
-  // Map from output name to the model configuration for that output.
-  std::unordered_map<std::string, ModelOutput> output_map_;
+  // Map from output name to the ordinal of that output in the model
+  // configuration.
+  std::unordered_map<std::string, uint32_t> output_map_;
 };
 
 }}  // namespace nvidia::inferenceserver
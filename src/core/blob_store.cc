@@ -0,0 +1,291 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "src/core/blob_store.h"
+
+#include <string.h>
+#include <list>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include "src/core/fingerprint.h"
+#include "src/core/logging.h"
+#include "src/core/provider.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+constexpr size_t kKeyLength = 32;
+
+// The seed for blob key fingerprints, chosen randomly once per
+// process. Fingerprints are not cryptographic, so with a fixed seed a
+// client could build content colliding with the key of a blob another
+// client will upload later, and so make that upload fail.
+uint64_t
+KeySeed()
+{
+  static const uint64_t seed = []() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }();
+  return seed;
+}
+
+std::string
+KeyString(const Fingerprint& fp)
+{
+  static const char kHexDigits[] = "0123456789abcdef";
+
+  std::string key(kKeyLength, '0');
+  for (size_t i = 0; i < 16; ++i) {
+    key[15 - i] = kHexDigits[(fp.hi_ >> (i * 4)) & 0xf];
+    key[31 - i] = kHexDigits[(fp.lo_ >> (i * 4)) & 0xf];
+  }
+
+  return key;
+}
+
+bool
+ParseKey(const std::string& key, Fingerprint* fp)
+{
+  if (key.size() != kKeyLength) {
+    return false;
+  }
+
+  uint64_t words[2] = {0, 0};
+  for (size_t i = 0; i < kKeyLength; ++i) {
+    const char c = key[i];
+    uint64_t digit;
+    if ((c >= '0') && (c <= '9')) {
+      digit = c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+      digit = c - 'a' + 10;
+    } else if ((c >= 'A') && (c <= 'F')) {
+      digit = c - 'A' + 10;
+    } else {
+      return false;
+    }
+
+    words[i / 16] = (words[i / 16] << 4) | digit;
+  }
+
+  fp->hi_ = words[0];
+  fp->lo_ = words[1];
+  return true;
+}
+
+//
+// The blobs held by the store, shared by all server endpoints.
+//
+class Store {
+ public:
+  static Store* Get()
+  {
+    static Store* store = new Store();
+    return store;
+  }
+
+  void Configure(size_t max_byte_size);
+  Status CheckByteSize(size_t byte_size);
+  Status Add(
+      const std::shared_ptr<AllocatedSystemMemory>& blob, std::string* key);
+  Status Get(const std::string& key, std::shared_ptr<SystemMemory>* blob);
+
+ private:
+  struct Entry {
+    std::shared_ptr<AllocatedSystemMemory> blob_;
+    std::list<Fingerprint>::iterator lru_itr_;
+  };
+
+  using EntryMap = std::unordered_map<Fingerprint, Entry, FingerprintHash>;
+
+  Store() : max_byte_size_(0), byte_size_(0) {}
+
+  // Check that a blob of 'byte_size' bytes fits in the store. Must
+  // be called with 'mu_' held.
+  Status CheckByteSizeLocked(size_t byte_size) const;
+
+  // Remove entries until 'byte_size' more bytes fit within the
+  // limit. Must be called with 'mu_' held.
+  void MakeRoom(size_t byte_size);
+
+  std::mutex mu_;
+  size_t max_byte_size_;
+  EntryMap entries_;
+
+  // Keys ordered from most to least recently used.
+  std::list<Fingerprint> lru_;
+
+  // Bytes of all stored blobs.
+  size_t byte_size_;
+};
+
+void
+Store::Configure(size_t max_byte_size)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  max_byte_size_ = max_byte_size;
+  MakeRoom(0);
+}
+
+Status
+Store::CheckByteSize(size_t byte_size)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  return CheckByteSizeLocked(byte_size);
+}
+
+Status
+Store::CheckByteSizeLocked(size_t byte_size) const
+{
+  if (max_byte_size_ == 0) {
+    return Status(RequestStatusCode::UNSUPPORTED, "blob store not enabled");
+  }
+  if (byte_size > max_byte_size_) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "blob of " + std::to_string(byte_size) +
+            " bytes exceeds blob store size of " +
+            std::to_string(max_byte_size_) + " bytes");
+  }
+
+  return Status::Success;
+}
+
+Status
+Store::Add(
+    const std::shared_ptr<AllocatedSystemMemory>& blob, std::string* key)
+{
+  size_t byte_size;
+  const char* content = blob->BufferAt(0, &byte_size);
+
+  // Fingerprint the content before taking the lock so that large
+  // uploads don't block requests that reference other blobs.
+  Fingerprinter fper(KeySeed());
+  fper.Update(content, byte_size);
+  const Fingerprint fp = fper.Finish();
+
+  std::shared_ptr<AllocatedSystemMemory> existing;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    RETURN_IF_ERROR(CheckByteSizeLocked(byte_size));
+
+    auto itr = entries_.find(fp);
+    if (itr == entries_.end()) {
+      MakeRoom(byte_size);
+      lru_.push_front(fp);
+      Entry& entry = entries_[fp];
+      entry.blob_ = blob;
+      entry.lru_itr_ = lru_.begin();
+      byte_size_ += byte_size;
+
+      *key = KeyString(fp);
+      return Status::Success;
+    }
+
+    lru_.splice(lru_.begin(), lru_, itr->second.lru_itr_);
+    existing = itr->second.blob_;
+  }
+
+  // Different content with the same key is very unlikely with a
+  // random seed, but compare the content anyway so that a blob can
+  // never be replaced by, or confused with, other content.
+  size_t existing_byte_size;
+  const char* existing_content = existing->BufferAt(0, &existing_byte_size);
+  if ((existing_byte_size != byte_size) ||
+      (memcmp(existing_content, content, byte_size) != 0)) {
+    LOG_ERROR << "blob store fingerprint collision for key " << KeyString(fp);
+    return Status(
+        RequestStatusCode::ALREADY_EXISTS,
+        "blob store already holds different content with the same key");
+  }
+
+  *key = KeyString(fp);
+  return Status::Success;
+}
+
+Status
+Store::Get(const std::string& key, std::shared_ptr<SystemMemory>* blob)
+{
+  Fingerprint fp;
+  if (!ParseKey(key, &fp)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG, "invalid blob key '" + key + "'");
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto itr = entries_.find(fp);
+  if (itr == entries_.end()) {
+    return Status(
+        RequestStatusCode::BLOB_NOT_FOUND,
+        "blob '" + key + "' not found in blob store");
+  }
+
+  lru_.splice(lru_.begin(), lru_, itr->second.lru_itr_);
+  *blob = itr->second.blob_;
+  return Status::Success;
+}
+
+void
+Store::MakeRoom(size_t byte_size)
+{
+  while (!lru_.empty() && ((byte_size_ + byte_size) > max_byte_size_)) {
+    auto itr = entries_.find(lru_.back());
+    byte_size_ -= itr->second.blob_->TotalByteSize();
+    lru_.pop_back();
+    entries_.erase(itr);
+  }
+}
+
+}  // namespace
+
+void
+BlobStore::Configure(size_t max_byte_size)
+{
+  Store::Get()->Configure(max_byte_size);
+}
+
+Status
+BlobStore::CheckByteSize(size_t byte_size)
+{
+  return Store::Get()->CheckByteSize(byte_size);
+}
+
+Status
+BlobStore::Add(
+    const std::shared_ptr<AllocatedSystemMemory>& blob, std::string* key)
+{
+  return Store::Get()->Add(blob, key);
+}
+
+Status
+BlobStore::Get(const std::string& key, std::shared_ptr<SystemMemory>* blob)
+{
+  return Store::Get()->Get(key, blob);
+}
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,74 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include <string>
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+class AllocatedSystemMemory;
+class SystemMemory;
+
+//
+// Content-addressed store of input tensor data. A client uploads a
+// blob once and then references it from any number of inference
+// requests by the key returned from Add(), so that large tensors
+// shared by many requests only cross the network once. The store
+// holds at most a configured number of bytes and evicts the least
+// recently used blobs to make room. A request holds a reference to
+// any blob it uses, so eviction never invalidates in-flight requests.
+//
+class BlobStore {
+ public:
+  // Set the maximum number of bytes held by the store. A value of
+  // zero disables the store. Blobs in excess of the new limit are
+  // evicted.
+  static void Configure(size_t max_byte_size);
+
+  // Check that a blob of 'byte_size' bytes can be added to the
+  // store. Returns UNSUPPORTED if the store is disabled and
+  // INVALID_ARG if the blob is larger than the store. Used to reject
+  // an upload before its content is copied.
+  static Status CheckByteSize(size_t byte_size);
+
+  // Add 'blob' to the store and return the key that identifies its
+  // content in 'key'. Adding content that the store already holds
+  // returns the key of the existing blob. The store takes shared
+  // ownership of 'blob', which must not be modified afterwards.
+  static Status Add(
+      const std::shared_ptr<AllocatedSystemMemory>& blob, std::string* key);
+
+  // Get the blob identified by 'key'. Returns BLOB_NOT_FOUND if the
+  // store does not hold the blob, either because it was never added
+  // or because it has been evicted.
+  static Status Get(
+      const std::string& key, std::shared_ptr<SystemMemory>* blob);
+};
+
+}}  // namespace nvidia::inferenceserver
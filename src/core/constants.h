@@ -30,13 +30,22 @@
 namespace nvidia { namespace inferenceserver {
 
 constexpr char kInferRequestHTTPHeader[] = "NV-InferRequest";
+constexpr char kInferRequestBinaryHTTPHeader[] = "NV-InferRequest-Binary";
+constexpr char kMultiInferRequestHTTPHeader[] = "NV-MultiInferRequest";
+constexpr char kMultiInferRequestBinaryHTTPHeader[] =
+    "NV-MultiInferRequest-Binary";
 constexpr char kInferResponseHTTPHeader[] = "NV-InferResponse";
 constexpr char kStatusHTTPHeader[] = "NV-Status";
+constexpr char kStatusCodeHTTPHeader[] = "NV-Status-Code";
+constexpr char kBlobKeyHTTPHeader[] = "NV-BlobKey";
 
 constexpr char kInferRESTEndpoint[] = "api/infer";
+constexpr char kMultiInferRESTEndpoint[] = "api/multiinfer";
 constexpr char kStatusRESTEndpoint[] = "api/status";
 constexpr char kProfileRESTEndpoint[] = "api/profile";
 constexpr char kHealthRESTEndpoint[] = "api/health";
+constexpr char kBlobRESTEndpoint[] = "api/blob";
+constexpr char kSharedMemoryRESTEndpoint[] = "api/sharedmemory";
 
 constexpr char kTensorFlowGraphDefPlatform[] = "tensorflow_graphdef";
 constexpr char kTensorFlowSavedModelPlatform[] = "tensorflow_savedmodel";
@@ -61,8 +70,10 @@ constexpr char kMetricsLabelGpuUuid[] = "gpu_uuid";
 
 constexpr uint64_t NANOS_PER_SECOND = 1000000000;
 constexpr int MAX_GRPC_MESSAGE_SIZE = INT32_MAX;
+constexpr size_t MAX_HTTP_DECOMPRESSED_BODY_SIZE = INT32_MAX;
 constexpr int SCHEDULER_DEFAULT_NICE = 5;
 constexpr uint64_t SEQUENCE_IDLE_DEFAULT_MICROSECONDS = 1000 * 1000;
+constexpr uint64_t STATUS_SNAPSHOT_DEFAULT_INTERVAL_MS = 0;
 
 #define DISALLOW_MOVE(TypeName) TypeName(Context&& o) = delete;
 #define DISALLOW_COPY(TypeName) TypeName(const TypeName&) = delete;
@@ -44,6 +44,7 @@ DynamicBatchScheduler::DynamicBatchScheduler(
     StandardInitFunc OnInit, StandardRunFunc OnSchedule)
     : OnInit_(OnInit), OnSchedule_(OnSchedule),
       scheduler_thread_cnt_(runner_cnt), idle_scheduler_thread_cnt_(0),
+      enqueue_group_cnt_(0), enqueue_group_flush_cnt_(0),
       pending_batch_size_(0), pending_batch_queue_cnt_(0)
 {
   dynamic_batching_enabled_ = config.has_dynamic_batching();
@@ -142,6 +143,35 @@ DynamicBatchScheduler::Enqueue(
   }
 }
 
+void
+DynamicBatchScheduler::BeginEnqueueGroup()
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  enqueue_group_cnt_++;
+}
+
+void
+DynamicBatchScheduler::EndEnqueueGroup()
+{
+  bool wake_runner = false;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    enqueue_group_cnt_--;
+
+    // Once the last group is completely enqueued there is no reason
+    // to keep waiting for more requests, so send the requests queued
+    // so far without waiting for the rest of the queuing delay.
+    if ((enqueue_group_cnt_ == 0) && !queue_.empty()) {
+      enqueue_group_flush_cnt_ = queue_.size();
+      wake_runner = (idle_scheduler_thread_cnt_ > 0);
+    }
+  }
+
+  if (wake_runner) {
+    cv_.notify_one();
+  }
+}
+
 void
 DynamicBatchScheduler::SchedulerThread(const uint32_t runner_id, const int nice)
 {
@@ -203,6 +233,9 @@ DynamicBatchScheduler::SchedulerThread(const uint32_t runner_id, const int nice)
             queue_.pop_front();
           }
 
+          enqueue_group_flush_cnt_ -=
+              std::min(enqueue_group_flush_cnt_, pending_batch_queue_cnt_);
+
           pending_batch_size_ = 0;
           pending_batch_queue_cnt_ = 0;
           pending_batch_shapes_.clear();
@@ -372,10 +405,14 @@ DynamicBatchScheduler::GetDynamicBatch()
     return 0;
   }
 
-  // If there is no batch queuing delay or if the current batch can't
-  // grow any larger then just immediately execute whatever is
-  // pending.
-  if (send_now || (pending_batch_delay_ns_ == 0) ||
+  // If there is no batch queuing delay, if the current batch can't
+  // grow any larger, or if the batch holds requests that were queued
+  // when an enqueue group completed, then just immediately execute
+  // whatever is pending. An enqueue group in progress is waited for
+  // only as long as the queuing delay below allows, so a group can't
+  // hold back requests longer than max_queue_delay_microseconds.
+  if (send_now || (enqueue_group_flush_cnt_ > 0) ||
+      (pending_batch_delay_ns_ == 0) ||
       (pending_batch_size_ >= max_preferred_batch_size_)) {
     return 0;
   }
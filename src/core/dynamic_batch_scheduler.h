@@ -56,6 +56,12 @@ class DynamicBatchScheduler : public Scheduler {
       const std::shared_ptr<InferResponseProvider>& response_provider,
       std::function<void(Status)> OnComplete) override;
 
+  // \see Scheduler::BeginEnqueueGroup()
+  void BeginEnqueueGroup() override;
+
+  // \see Scheduler::EndEnqueueGroup()
+  void EndEnqueueGroup() override;
+
  private:
   DynamicBatchScheduler(
       const ModelConfig& config, const uint32_t runner_cnt,
@@ -89,6 +95,13 @@ class DynamicBatchScheduler : public Scheduler {
   // this servable.
   std::deque<Scheduler::Payload> queue_;
 
+  // The number of enqueue groups in progress, and the number of
+  // requests at the front of the queue that were queued when the
+  // last group in progress ended. Batches holding those requests are
+  // sent without waiting for the rest of the queuing delay.
+  size_t enqueue_group_cnt_;
+  size_t enqueue_group_flush_cnt_;
+
   std::vector<std::unique_ptr<std::thread>> scheduler_threads_;
   std::atomic<bool> scheduler_threads_exit_;
 
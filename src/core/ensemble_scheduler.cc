@@ -194,6 +194,10 @@ EnsembleContext::EnsembleContext(
       if (it != info_->ensemble_input_to_tensor_.end()) {
         auto& tensor_data = tensor_data_[it->second];
         tensor_data.first = input;
+        // A blob or shared-memory input has already been resolved to
+        // its data, so the steps use that data directly.
+        tensor_data.first.clear_blob_key();
+        tensor_data.first.clear_shared_memory();
         request_provider_->GetSystemMemory(it->first, &(tensor_data.second));
       } else {
         ensemble_status_ = Status(
@@ -208,8 +212,7 @@ EnsembleContext::EnsembleContext(
     const std::shared_ptr<LabelProvider>& label_provider =
         response_provider_->GetLabelProvider();
     for (const auto& pair : info_->ensemble_output_to_tensor_) {
-      const auto& label = label_provider->GetLabel(pair.first, 0);
-      if (label == "") {
+      if (label_provider->GetLabel(pair.first, 0).empty()) {
         no_label_tensors_[pair.second] = pair.first;
       }
     }
@@ -371,37 +374,35 @@ EnsembleContext::GetNextSteps(
 Status
 EnsembleContext::InitStep(size_t step_idx, std::shared_ptr<Step>* step)
 {
-  std::unordered_map<std::string, std::shared_ptr<SystemMemory>> input_map;
-  InferRequestHeader request_header;
+  InputMemoryList input_map;
+  RequestOrdinals ordinals;
+  auto request_header = std::make_shared<InferRequestHeader>();
   auto& version_map = handles_[info_->steps_[step_idx].model_name_];
   auto& backend = version_map[info_->steps_[step_idx].model_version_];
 
-  request_header.set_correlation_id(correlation_id_);
-  request_header.set_batch_size(batch_size_);
-  request_header.set_flags(flags_);
+  request_header->set_correlation_id(correlation_id_);
+  request_header->set_batch_size(batch_size_);
+  request_header->set_flags(flags_);
   for (const auto& pair : info_->steps_[step_idx].input_to_tensor_) {
-    auto input = request_header.add_input();
+    auto input = request_header->add_input();
     *input = tensor_data_[pair.second].first;
     input->set_name(pair.first);
-    input_map[pair.first] = tensor_data_[pair.second].second;
+    input_map.push_back(tensor_data_[pair.second].second);
   }
   for (const auto& pair : info_->steps_[step_idx].output_to_tensor_) {
-    request_header.add_output()->set_name(pair.first);
+    request_header->add_output()->set_name(pair.first);
   }
-  RETURN_IF_ERROR(
-      NormalizeRequestHeader(*backend->GetInferenceBackend(), request_header));
+  RETURN_IF_ERROR(NormalizeRequestHeader(
+      *backend->GetInferenceBackend(), *request_header, &ordinals));
 
   step->reset(new Step(step_idx));
   (*step)->backend_ = backend;
   RETURN_IF_ERROR(InferRequestProvider::Create(
       info_->steps_[step_idx].model_name_,
-      info_->steps_[step_idx].model_version_, request_header, input_map,
-      &((*step)->request_provider_)));
-  // Request header is stored in response provider as reference, so use
-  // header from request provider as the providers have same lifetime
+      info_->steps_[step_idx].model_version_, request_header, ordinals,
+      input_map, &((*step)->request_provider_)));
   RETURN_IF_ERROR(InternalInferResponseProvider::Create(
-      *((*step)->backend_->GetInferenceBackend()),
-      (*step)->request_provider_->RequestHeader(),
+      *((*step)->backend_->GetInferenceBackend()), request_header, ordinals,
       (*step)->backend_->GetInferenceBackend()->GetLabelProvider(),
       &((*step)->response_provider_)));
 
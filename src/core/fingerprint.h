@@ -0,0 +1,188 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+namespace nvidia { namespace inferenceserver {
+
+// A 128-bit fingerprint of a sequence of bytes. Fingerprints are
+// fast to compute and well distributed but are not cryptographic, so
+// they must only be used to identify content that is not adversarial
+// or where a collision is harmless.
+struct Fingerprint {
+  uint64_t hi_;
+  uint64_t lo_;
+
+  bool operator==(const Fingerprint& o) const
+  {
+    return (hi_ == o.hi_) && (lo_ == o.lo_);
+  }
+  bool operator!=(const Fingerprint& o) const { return !(*this == o); }
+};
+
+// Hash functor so that a Fingerprint can be used as the key of an
+// unordered container.
+struct FingerprintHash {
+  size_t operator()(const Fingerprint& fp) const { return fp.lo_; }
+};
+
+// Incrementally compute the Fingerprint of a sequence of bytes. The
+// bytes can be provided in any number of Update() calls, the
+// fingerprint depends only on the concatenation of the bytes. Data is
+// consumed in 32-byte stripes by four independent accumulators so
+// that large tensors hash at close to memory bandwidth.
+class Fingerprinter {
+ public:
+  // Create a fingerprinter. Fingerprints computed with different
+  // 'seed' values are unrelated, so a fingerprint that is used to
+  // find content supplied by clients should use a secret seed.
+  explicit Fingerprinter(uint64_t seed = kSeed) : byte_size_(0), tail_size_(0)
+  {
+    acc_[0] = seed + kPrime1 + kPrime2;
+    acc_[1] = seed + kPrime2;
+    acc_[2] = seed;
+    acc_[3] = seed - kPrime1;
+  }
+
+  // Add 'byte_size' bytes starting at 'data'.
+  void Update(const void* data, size_t byte_size)
+  {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    byte_size_ += byte_size;
+
+    if (tail_size_ > 0) {
+      const size_t n = std::min(kStripeSize - tail_size_, byte_size);
+      memcpy(tail_ + tail_size_, p, n);
+      tail_size_ += n;
+      p += n;
+      byte_size -= n;
+      if (tail_size_ < kStripeSize) {
+        return;
+      }
+
+      Stripe(tail_);
+      tail_size_ = 0;
+    }
+
+    while (byte_size >= kStripeSize) {
+      Stripe(p);
+      p += kStripeSize;
+      byte_size -= kStripeSize;
+    }
+
+    if (byte_size > 0) {
+      memcpy(tail_, p, byte_size);
+      tail_size_ = byte_size;
+    }
+  }
+
+  // Add the bytes of a trivially-copyable 'value'.
+  template <typename T>
+  void UpdateValue(const T& value)
+  {
+    Update(&value, sizeof(T));
+  }
+
+  // Add a string, prefixed by its length so that adjacent strings
+  // can't be confused with each other.
+  void UpdateString(const std::string& str)
+  {
+    UpdateValue<uint64_t>(str.size());
+    Update(str.data(), str.size());
+  }
+
+  // Return the fingerprint of all bytes added so far.
+  Fingerprint Finish() const
+  {
+    uint64_t acc[4] = {acc_[0], acc_[1], acc_[2], acc_[3]};
+
+    // Fold the partial stripe into the accumulators a word at a
+    // time, zero-padding the final word. The total length is mixed
+    // in below so padding can't cause collisions.
+    size_t idx = 0;
+    for (size_t offset = 0; offset < tail_size_; offset += 8, ++idx) {
+      uint64_t word = 0;
+      memcpy(&word, tail_ + offset, std::min<size_t>(8, tail_size_ - offset));
+      acc[idx] = Round(acc[idx], word);
+    }
+
+    Fingerprint fp;
+    fp.lo_ = Avalanche(
+        Rotl(acc[0], 1) + Rotl(acc[1], 7) + Rotl(acc[2], 12) +
+        Rotl(acc[3], 18) + byte_size_);
+    fp.hi_ = Avalanche(
+        Rotl(acc[0], 18) + Rotl(acc[1], 12) + Rotl(acc[2], 7) +
+        Rotl(acc[3], 1) + (byte_size_ * kPrime3) + fp.lo_);
+    return fp;
+  }
+
+ private:
+  static constexpr size_t kStripeSize = 32;
+  static constexpr uint64_t kSeed = 0x9e3779b97f4a7c15ULL;
+  static constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+  static constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+  static constexpr uint64_t kPrime3 = 0x165667b19e3779f9ULL;
+
+  static uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+  static uint64_t Round(uint64_t acc, uint64_t word)
+  {
+    acc += word * kPrime2;
+    acc = Rotl(acc, 31);
+    return acc * kPrime1;
+  }
+
+  static uint64_t Avalanche(uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  void Stripe(const uint8_t* p)
+  {
+    for (size_t i = 0; i < 4; ++i) {
+      uint64_t word;
+      memcpy(&word, p + (i * 8), sizeof(word));
+      acc_[i] = Round(acc_[i], word);
+    }
+  }
+
+  uint64_t acc_[4];
+  uint64_t byte_size_;
+  uint8_t tail_[kStripeSize];
+  size_t tail_size_;
+};
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,152 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+namespace nvidia { namespace inferenceserver {
+
+// An IEEE 754 half-precision value as stored in an FP16 tensor.
+struct Float16 {
+  uint16_t bits_;
+};
+
+// Convert a half-precision value to single precision.
+inline float
+Float16ToFloat(Float16 h)
+{
+  const uint32_t sign = static_cast<uint32_t>(h.bits_ & 0x8000) << 16;
+  uint32_t exponent = (h.bits_ >> 10) & 0x1f;
+  uint32_t mantissa = h.bits_ & 0x3ff;
+
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    // Inf or NaN
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal, normalize the mantissa
+    exponent = 127 - 15 + 1;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+// Convert a single-precision value to half precision, rounding to
+// nearest even. Values too large for half precision become Inf.
+inline Float16
+FloatToFloat16(float f)
+{
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const uint32_t exponent = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  Float16 h;
+  if (exponent == 0xff) {
+    // Inf or NaN, keep NaN quiet
+    h.bits_ = sign | 0x7c00 | ((mantissa != 0) ? 0x200 : 0);
+  } else if (exponent > (127 + 15)) {
+    // Overflow
+    h.bits_ = sign | 0x7c00;
+  } else if (exponent >= (127 - 14)) {
+    // Normal, round the mantissa to 10 bits. A carry out of the
+    // mantissa correctly increments the exponent.
+    uint32_t hbits = ((exponent - (127 - 15)) << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1fff;
+    if ((rest > 0x1000) || ((rest == 0x1000) && ((hbits & 1) != 0))) {
+      hbits++;
+    }
+    h.bits_ = sign | static_cast<uint16_t>(hbits);
+  } else if (exponent >= (127 - 25)) {
+    // Subnormal, shift in the implicit leading bit and round.
+    mantissa |= 0x800000;
+    const uint32_t shift = (127 - 14) - exponent + 13;
+    uint32_t hbits = mantissa >> shift;
+    const uint32_t rest = mantissa & ((1u << shift) - 1);
+    const uint32_t half = 1u << (shift - 1);
+    if ((rest > half) || ((rest == half) && ((hbits & 1) != 0))) {
+      hbits++;
+    }
+    h.bits_ = sign | static_cast<uint16_t>(hbits);
+  } else {
+    // Underflow to zero
+    h.bits_ = sign;
+  }
+
+  return h;
+}
+
+// A bfloat16 value as stored in a BF16 tensor, the upper half of an
+// IEEE 754 single-precision value.
+struct BFloat16 {
+  uint16_t bits_;
+};
+
+// Convert a bfloat16 value to single precision.
+inline float
+BFloat16ToFloat(BFloat16 b)
+{
+  const uint32_t bits = static_cast<uint32_t>(b.bits_) << 16;
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+// Convert a single-precision value to bfloat16, rounding to nearest
+// even.
+inline BFloat16
+FloatToBFloat16(float f)
+{
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+
+  BFloat16 b;
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    // NaN, keep it quiet so that truncation can't make it Inf
+    b.bits_ = static_cast<uint16_t>((bits >> 16) | 0x40);
+  } else {
+    const uint32_t rounding = 0x7fff + ((bits >> 16) & 1);
+    b.bits_ = static_cast<uint16_t>((bits + rounding) >> 16);
+  }
+
+  return b;
+}
+
+}}  // namespace nvidia::inferenceserver
@@ -26,49 +26,159 @@
 
 #include "src/core/label_provider.h"
 
-#include <iostream>
-#include <iterator>
-#include <sstream>
+#include <mutex>
+#include <vector>
 #include "src/core/filesystem.h"
 
 namespace nvidia { namespace inferenceserver {
 
-const std::string&
-LabelProvider::GetLabel(const std::string& name, size_t index) const
+//
+// The contents of a label file, with each label referring directly
+// into the contents.
+//
+class LabelFile {
+ public:
+  // Read the file at 'filepath' and return the shared LabelFile for
+  // its contents. If a file with identical contents is already
+  // loaded then that LabelFile is returned instead.
+  static Status Create(
+      const std::string& filepath, std::shared_ptr<const LabelFile>* file);
+
+  ~LabelFile();
+
+  size_t Count() const { return labels_.size(); }
+  absl::string_view Label(size_t index) const { return labels_[index]; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LabelFile);
+  LabelFile(std::string&& contents, uint64_t hash);
+
+  // Hash of the file contents.
+  static uint64_t Hash(absl::string_view contents);
+
+  const std::string contents_;
+  const uint64_t hash_;
+  std::vector<absl::string_view> labels_;
+
+  // The label files currently in use, keyed by content hash. Entries
+  // are removed when the last provider using the file is
+  // destroyed. The registry is never destroyed so that it outlives
+  // any provider.
+  struct Registry {
+    std::mutex mu_;
+    std::unordered_multimap<uint64_t, std::weak_ptr<const LabelFile>> files_;
+  };
+  static Registry* GetRegistry()
+  {
+    static Registry* registry = new Registry();
+    return registry;
+  }
+};
+
+LabelFile::LabelFile(std::string&& contents, uint64_t hash)
+    : contents_(std::move(contents)), hash_(hash)
+{
+  // Split into labels the same way as std::getline: a trailing
+  // newline does not start an additional label.
+  absl::string_view remaining(contents_);
+  while (!remaining.empty()) {
+    const size_t eol = remaining.find('\n');
+    if (eol == absl::string_view::npos) {
+      labels_.push_back(remaining);
+      break;
+    }
+
+    labels_.push_back(remaining.substr(0, eol));
+    remaining.remove_prefix(eol + 1);
+  }
+}
+
+LabelFile::~LabelFile()
+{
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu_);
+  auto range = registry->files_.equal_range(hash_);
+  for (auto itr = range.first; itr != range.second; ++itr) {
+    if (itr->second.expired()) {
+      registry->files_.erase(itr);
+      break;
+    }
+  }
+}
+
+uint64_t
+LabelFile::Hash(absl::string_view contents)
+{
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : contents) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+Status
+LabelFile::Create(
+    const std::string& filepath, std::shared_ptr<const LabelFile>* file)
 {
-  static const std::string not_found;
+  std::string contents;
+  RETURN_IF_ERROR(ReadTextFile(filepath, &contents));
+  const uint64_t hash = Hash(contents);
+
+  // Files that collide on hash but differ in contents. Declared
+  // before the lock so that, if this holds the last reference to a
+  // file, the file is destroyed after the lock is released.
+  std::vector<std::shared_ptr<const LabelFile>> collisions;
+
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu_);
+
+  auto range = registry->files_.equal_range(hash);
+  for (auto itr = range.first; itr != range.second; ++itr) {
+    std::shared_ptr<const LabelFile> existing = itr->second.lock();
+    if (existing == nullptr) {
+      continue;
+    }
+    if (existing->contents_ == contents) {
+      *file = std::move(existing);
+      return Status::Success;
+    }
+    collisions.push_back(std::move(existing));
+  }
 
+  file->reset(new LabelFile(std::move(contents), hash));
+  registry->files_.emplace(hash, *file);
+
+  return Status::Success;
+}
+
+absl::string_view
+LabelProvider::GetLabel(const std::string& name, size_t index) const
+{
   auto itr = label_map_.find(name);
   if (itr == label_map_.end()) {
-    return not_found;
+    return absl::string_view();
   }
 
-  if (itr->second.size() <= index) {
-    return not_found;
+  if (itr->second->Count() <= index) {
+    return absl::string_view();
   }
 
-  return itr->second[index];
+  return itr->second->Label(index);
 }
 
 Status
 LabelProvider::AddLabels(const std::string& name, const std::string& filepath)
 {
-  std::string label_file_contents;
-  RETURN_IF_ERROR(ReadTextFile(filepath, &label_file_contents));
-
-  auto p = label_map_.insert(std::make_pair(name, std::vector<std::string>()));
-  if (!p.second) {
+  if (label_map_.find(name) != label_map_.end()) {
     return Status(
         RequestStatusCode::INTERNAL, "multiple label files for '" + name + "'");
   }
 
-  auto itr = p.first;
-
-  std::istringstream label_file_stream(label_file_contents);
-  std::string line;
-  while (std::getline(label_file_stream, line)) {
-    itr->second.push_back(line);
-  }
+  std::shared_ptr<const LabelFile> file;
+  RETURN_IF_ERROR(LabelFile::Create(filepath, &file));
+  label_map_.emplace(name, std::move(file));
 
   return Status::Success;
 }
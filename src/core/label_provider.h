@@ -25,33 +25,40 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "absl/strings/string_view.h"
 #include "src/core/constants.h"
 #include "src/core/status.h"
 
 namespace nvidia { namespace inferenceserver {
 
+class LabelFile;
+
 // Provides classification labels.
 class LabelProvider {
  public:
   LabelProvider() = default;
 
   // Return the label associated with 'name' for a given
-  // 'index'. Return empty string if no label is available.
-  const std::string& GetLabel(const std::string& name, size_t index) const;
+  // 'index'. Return empty string if no label is available. The
+  // returned label remains valid for the lifetime of the provider.
+  absl::string_view GetLabel(const std::string& name, size_t index) const;
 
   // Associate with 'name' a set of labels initialized from a given
   // 'filepath'. Within the file each label is specified on its own
   // line. The first label (line 0) is the index-0 label, the second
-  // label (line 1) is the index-1 label, etc.
+  // label (line 1) is the index-1 label, etc. The file contents are
+  // read once and shared with any other provider that has added a
+  // file with identical contents.
   Status AddLabels(const std::string& name, const std::string& filepath);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(LabelProvider);
 
-  std::unordered_map<std::string, std::vector<std::string>> label_map_;
+  std::unordered_map<std::string, std::shared_ptr<const LabelFile>> label_map_;
 };
 
 }}  // namespace nvidia::inferenceserver
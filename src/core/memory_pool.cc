@@ -0,0 +1,524 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/memory_pool.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "src/core/metrics.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+// The smallest size class is 2^kMinClassShift bytes and each
+// power-of-two range above that is split into kClassSteps classes,
+// up to the largest size class of 2^kMaxClassShift bytes. Larger
+// buffers are not pooled.
+constexpr size_t kMinClassShift = 8;
+constexpr size_t kMaxClassShift = 30;
+constexpr size_t kClassSteps = 4;
+constexpr size_t kClassCount =
+    1 + ((kMaxClassShift - kMinClassShift) * kClassSteps);
+constexpr size_t kMinClassByteSize = size_t(1) << kMinClassShift;
+constexpr size_t kMaxClassByteSize = size_t(1) << kMaxClassShift;
+
+// Buffers of at least this size are mmap'ed, aligned to this size,
+// and are candidates for transparent huge pages.
+constexpr size_t kHugePageByteSize = 2 * 1024 * 1024;
+
+// Buffers larger than this are never held in a thread's local free
+// lists.
+constexpr size_t kMaxThreadCacheClassByteSize = 1024 * 1024;
+
+// Allocations served from a thread's local free lists are counted by
+// the thread and added to the pool statistics in batches of this
+// many, so that the lock-free path doesn't write shared counters.
+constexpr uint64_t kThreadCacheHitBatchCount = 256;
+
+// Return the size class for a request of 'byte_size' bytes, which
+// must not be larger than kMaxClassByteSize. Return the byte size of
+// that class in 'class_byte_size'.
+size_t
+ClassIndex(size_t byte_size, size_t* class_byte_size)
+{
+  if (byte_size <= kMinClassByteSize) {
+    *class_byte_size = kMinClassByteSize;
+    return 0;
+  }
+
+  // The request falls in (2^msb, 2^(msb+1)], a range that is split
+  // into kClassSteps classes of 2^(msb-2) bytes each.
+  const size_t msb = 63 - __builtin_clzll(byte_size - 1);
+  const size_t step_shift = msb - 2;
+  const size_t steps = ((byte_size - 1) >> step_shift) + 1;
+  *class_byte_size = steps << step_shift;
+  return ((msb - kMinClassShift) * kClassSteps) + (steps - kClassSteps);
+}
+
+// Return the byte size of size class 'idx'.
+size_t
+ClassByteSize(size_t idx)
+{
+  if (idx == 0) {
+    return kMinClassByteSize;
+  }
+
+  const size_t msb = kMinClassShift + ((idx - 1) / kClassSteps);
+  const size_t steps = kClassSteps + 1 + ((idx - 1) % kClassSteps);
+  return steps << (msb - 2);
+}
+
+// Allocate 'byte_size' bytes from the system.
+char*
+SystemAllocate(size_t byte_size, bool huge_pages)
+{
+  if (byte_size < kHugePageByteSize) {
+    void* buffer = nullptr;
+    if (posix_memalign(&buffer, 64, byte_size) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<char*>(buffer);
+  }
+
+  // Over-allocate so the buffer can be aligned to a huge page, then
+  // return the unused head and tail to the system.
+  const size_t map_byte_size = byte_size + kHugePageByteSize;
+  void* map = mmap(
+      nullptr, map_byte_size, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+
+  const uintptr_t base = reinterpret_cast<uintptr_t>(map);
+  const uintptr_t aligned =
+      (base + kHugePageByteSize - 1) & ~(uintptr_t(kHugePageByteSize) - 1);
+  if (aligned > base) {
+    munmap(map, aligned - base);
+  }
+  const size_t tail_byte_size = (base + map_byte_size) - (aligned + byte_size);
+  if (tail_byte_size > 0) {
+    munmap(reinterpret_cast<void*>(aligned + byte_size), tail_byte_size);
+  }
+
+#ifdef MADV_HUGEPAGE
+  if (huge_pages) {
+    madvise(reinterpret_cast<void*>(aligned), byte_size, MADV_HUGEPAGE);
+  }
+#endif  // MADV_HUGEPAGE
+
+  return reinterpret_cast<char*>(aligned);
+}
+
+// Return a buffer of 'byte_size' bytes allocated by SystemAllocate().
+void
+SystemFree(char* buffer, size_t byte_size)
+{
+  if (byte_size < kHugePageByteSize) {
+    free(buffer);
+  } else {
+    munmap(buffer, byte_size);
+  }
+}
+
+//
+// The free lists and statistics shared by all threads.
+//
+class CentralPool {
+ public:
+  // The central pool is never destroyed so that buffers released
+  // during process exit, or by exiting threads, can still be
+  // returned.
+  static CentralPool* Get()
+  {
+    static CentralPool* pool = new CentralPool();
+    return pool;
+  }
+
+  void Configure(const SystemMemoryPool::Options& options);
+
+  bool Enabled() const { return max_cached_byte_size_ > 0; }
+  size_t ThreadCacheByteSize() const { return thread_cache_byte_size_; }
+
+  // Allocate a buffer of 'byte_size' bytes from the system.
+  char* Allocate(size_t byte_size);
+
+  // Return a buffer of 'byte_size' bytes to the system.
+  void Free(char* buffer, size_t byte_size);
+
+  // Pop a buffer of size class 'idx' from the shared free list.
+  // Return nullptr if the free list is empty.
+  char* Pop(size_t idx);
+
+  // Push a buffer of size class 'idx' onto the shared free list.
+  // Return false if the buffer would exceed the cache limit, in which
+  // case the caller retains ownership of the buffer.
+  bool Push(size_t idx, char* buffer);
+
+  // Record 'cnt' allocations served from a thread's local free
+  // lists.
+  void AddHits(uint64_t cnt)
+  {
+    hit_count_ += cnt;
+    Metrics::MemoryPoolHitCount().Increment(cnt);
+  }
+
+  void GetStats(SystemMemoryPool::Stats* stats) const;
+
+ private:
+  struct FreeList {
+    std::mutex mu_;
+    std::vector<char*> buffers_;
+  };
+
+  CentralPool();
+
+  // Return buffers in the shared free lists to the system, largest
+  // classes first, until the cache is within its limit.
+  void Trim();
+
+  std::atomic<size_t> max_cached_byte_size_;
+  std::atomic<size_t> thread_cache_byte_size_;
+  std::atomic<bool> huge_pages_;
+
+  std::array<FreeList, kClassCount> lists_;
+
+  std::atomic<uint64_t> hit_count_;
+  std::atomic<uint64_t> miss_count_;
+  std::atomic<size_t> resident_byte_size_;
+  std::atomic<size_t> cached_byte_size_;
+};
+
+CentralPool::CentralPool()
+    : hit_count_(0), miss_count_(0), resident_byte_size_(0),
+      cached_byte_size_(0)
+{
+  const SystemMemoryPool::Options options;
+  max_cached_byte_size_ = options.max_cached_byte_size_;
+  thread_cache_byte_size_ = options.thread_cache_byte_size_;
+  huge_pages_ = options.huge_pages_;
+}
+
+void
+CentralPool::Configure(const SystemMemoryPool::Options& options)
+{
+  max_cached_byte_size_ = options.max_cached_byte_size_;
+  thread_cache_byte_size_ = options.thread_cache_byte_size_;
+  huge_pages_ = options.huge_pages_;
+  Trim();
+}
+
+char*
+CentralPool::Allocate(size_t byte_size)
+{
+  char* buffer = SystemAllocate(byte_size, huge_pages_);
+  miss_count_++;
+  resident_byte_size_ += byte_size;
+  Metrics::MemoryPoolMissCount().Increment();
+  Metrics::MemoryPoolResidentBytes().Increment(byte_size);
+  return buffer;
+}
+
+void
+CentralPool::Free(char* buffer, size_t byte_size)
+{
+  SystemFree(buffer, byte_size);
+  resident_byte_size_ -= byte_size;
+  Metrics::MemoryPoolResidentBytes().Decrement(byte_size);
+}
+
+char*
+CentralPool::Pop(size_t idx)
+{
+  FreeList& list = lists_[idx];
+  std::lock_guard<std::mutex> lk(list.mu_);
+  if (list.buffers_.empty()) {
+    return nullptr;
+  }
+
+  char* buffer = list.buffers_.back();
+  list.buffers_.pop_back();
+  const size_t class_byte_size = ClassByteSize(idx);
+  cached_byte_size_ -= class_byte_size;
+  hit_count_++;
+  Metrics::MemoryPoolHitCount().Increment();
+  Metrics::MemoryPoolCachedBytes().Decrement(class_byte_size);
+  return buffer;
+}
+
+bool
+CentralPool::Push(size_t idx, char* buffer)
+{
+  const size_t class_byte_size = ClassByteSize(idx);
+  if ((cached_byte_size_.fetch_add(class_byte_size) + class_byte_size) >
+      max_cached_byte_size_) {
+    cached_byte_size_ -= class_byte_size;
+    return false;
+  }
+
+  {
+    FreeList& list = lists_[idx];
+    std::lock_guard<std::mutex> lk(list.mu_);
+    list.buffers_.push_back(buffer);
+  }
+
+  Metrics::MemoryPoolCachedBytes().Increment(class_byte_size);
+  return true;
+}
+
+void
+CentralPool::GetStats(SystemMemoryPool::Stats* stats) const
+{
+  stats->hit_count_ = hit_count_;
+  stats->miss_count_ = miss_count_;
+  stats->resident_byte_size_ = resident_byte_size_;
+  stats->cached_byte_size_ = cached_byte_size_;
+}
+
+void
+CentralPool::Trim()
+{
+  for (size_t idx = kClassCount; idx-- > 0;) {
+    if (cached_byte_size_ <= max_cached_byte_size_) {
+      break;
+    }
+
+    std::vector<char*> buffers;
+    {
+      std::lock_guard<std::mutex> lk(lists_[idx].mu_);
+      buffers.swap(lists_[idx].buffers_);
+    }
+
+    const size_t class_byte_size = ClassByteSize(idx);
+    for (char* buffer : buffers) {
+      cached_byte_size_ -= class_byte_size;
+      Metrics::MemoryPoolCachedBytes().Decrement(class_byte_size);
+      Free(buffer, class_byte_size);
+    }
+  }
+}
+
+//
+// Per-thread free lists. Buffers are served from and returned to
+// these lists without taking any locks.
+//
+class ThreadCache {
+ public:
+  ThreadCache() : byte_size_(0), hit_count_(0) {}
+  ~ThreadCache();
+
+  // Return the calling thread's cache, or nullptr if the thread is
+  // exiting and its cache has already been destroyed.
+  static ThreadCache* Get();
+
+  // Pop a buffer of size class 'idx'. Return nullptr if the local
+  // free list is empty.
+  char* Pop(size_t idx);
+
+  // Push a buffer of size class 'idx'. Return false if the buffer
+  // does not fit in the cache, in which case the caller retains
+  // ownership of the buffer.
+  bool Push(size_t idx, char* buffer);
+
+  // Add the hits counted by this cache to the pool statistics.
+  void FlushHits();
+
+ private:
+  // Move all locally held buffers to the shared free lists, or to
+  // the system if the shared free lists are full.
+  void Drain();
+
+  std::array<std::vector<char*>, kClassCount> lists_;
+  size_t byte_size_;
+
+  // Hits not yet added to the pool statistics.
+  uint64_t hit_count_;
+};
+
+// Set once the calling thread's cache has been destroyed so that
+// buffers released later during thread exit bypass it.
+thread_local bool thread_cache_destroyed_ = false;
+
+ThreadCache::~ThreadCache()
+{
+  Drain();
+  thread_cache_destroyed_ = true;
+}
+
+ThreadCache*
+ThreadCache::Get()
+{
+  if (thread_cache_destroyed_) {
+    return nullptr;
+  }
+
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+char*
+ThreadCache::Pop(size_t idx)
+{
+  std::vector<char*>& list = lists_[idx];
+  if (list.empty()) {
+    return nullptr;
+  }
+
+  char* buffer = list.back();
+  list.pop_back();
+  byte_size_ -= ClassByteSize(idx);
+  if (++hit_count_ >= kThreadCacheHitBatchCount) {
+    FlushHits();
+  }
+  return buffer;
+}
+
+bool
+ThreadCache::Push(size_t idx, char* buffer)
+{
+  const size_t class_byte_size = ClassByteSize(idx);
+  if (class_byte_size > kMaxThreadCacheClassByteSize) {
+    return false;
+  }
+
+  const size_t limit = CentralPool::Get()->ThreadCacheByteSize();
+  if ((byte_size_ + class_byte_size) > limit) {
+    Drain();
+    if (class_byte_size > limit) {
+      return false;
+    }
+  }
+
+  lists_[idx].push_back(buffer);
+  byte_size_ += class_byte_size;
+  return true;
+}
+
+void
+ThreadCache::FlushHits()
+{
+  if (hit_count_ > 0) {
+    CentralPool::Get()->AddHits(hit_count_);
+    hit_count_ = 0;
+  }
+}
+
+void
+ThreadCache::Drain()
+{
+  FlushHits();
+
+  CentralPool* central = CentralPool::Get();
+  for (size_t idx = 0; idx < kClassCount; ++idx) {
+    for (char* buffer : lists_[idx]) {
+      if (!central->Push(idx, buffer)) {
+        central->Free(buffer, ClassByteSize(idx));
+      }
+    }
+    lists_[idx].clear();
+  }
+
+  byte_size_ = 0;
+}
+
+}  // namespace
+
+void
+SystemMemoryPool::Configure(const Options& options)
+{
+  CentralPool::Get()->Configure(options);
+}
+
+char*
+SystemMemoryPool::Allocate(size_t byte_size)
+{
+  CentralPool* central = CentralPool::Get();
+  if (byte_size > kMaxClassByteSize) {
+    return central->Allocate(byte_size);
+  }
+
+  size_t class_byte_size;
+  const size_t idx = ClassIndex(byte_size, &class_byte_size);
+  if (central->Enabled()) {
+    ThreadCache* cache = ThreadCache::Get();
+    char* buffer = (cache == nullptr) ? nullptr : cache->Pop(idx);
+    if (buffer == nullptr) {
+      buffer = central->Pop(idx);
+    }
+    if (buffer != nullptr) {
+      return buffer;
+    }
+  }
+
+  return central->Allocate(class_byte_size);
+}
+
+void
+SystemMemoryPool::Release(char* buffer, size_t byte_size)
+{
+  if (buffer == nullptr) {
+    return;
+  }
+
+  CentralPool* central = CentralPool::Get();
+  if (byte_size > kMaxClassByteSize) {
+    central->Free(buffer, byte_size);
+    return;
+  }
+
+  size_t class_byte_size;
+  const size_t idx = ClassIndex(byte_size, &class_byte_size);
+  if (central->Enabled()) {
+    ThreadCache* cache = ThreadCache::Get();
+    if ((cache != nullptr) && cache->Push(idx, buffer)) {
+      return;
+    }
+    if (central->Push(idx, buffer)) {
+      return;
+    }
+  }
+
+  central->Free(buffer, class_byte_size);
+}
+
+void
+SystemMemoryPool::GetStats(Stats* stats)
+{
+  ThreadCache* cache = ThreadCache::Get();
+  if (cache != nullptr) {
+    cache->FlushHits();
+  }
+
+  CentralPool::Get()->GetStats(stats);
+}
+
+}}  // namespace nvidia::inferenceserver
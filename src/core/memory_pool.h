@@ -0,0 +1,115 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+
+namespace nvidia { namespace inferenceserver {
+
+//
+// Pool of host memory used for tensor buffers. Requests are rounded
+// up to a size class (four classes per power-of-two) and freed
+// buffers are kept on per-thread and then on shared per-class free
+// lists so that the next request for the same class does not need to
+// go to the system allocator. Buffers of huge-page size or larger are
+// mmap'ed directly and optionally backed by transparent huge pages.
+//
+class SystemMemoryPool {
+ public:
+  struct Options {
+    // The maximum number of bytes held in the shared free lists. A
+    // value of zero disables pooling so that every buffer is
+    // allocated from, and released to, the system.
+    size_t max_cached_byte_size_ = 256 * 1024 * 1024;
+
+    // The maximum number of bytes held in each thread's local free
+    // lists.
+    size_t thread_cache_byte_size_ = 4 * 1024 * 1024;
+
+    // Advise the kernel to back large buffers with transparent huge
+    // pages.
+    bool huge_pages_ = true;
+  };
+
+  struct Stats {
+    // Number of allocations served from a free list.
+    uint64_t hit_count_;
+
+    // Number of allocations that required a system allocation.
+    uint64_t miss_count_;
+
+    // Bytes allocated from the system and not yet returned, including
+    // both buffers in use and buffers held in free lists.
+    size_t resident_byte_size_;
+
+    // Bytes held in the shared free lists.
+    size_t cached_byte_size_;
+  };
+
+  // Deleter that returns a buffer of 'byte_size' bytes to the pool.
+  class Deleter {
+   public:
+    explicit Deleter(size_t byte_size = 0) : byte_size_(byte_size) {}
+    void operator()(char* buffer) const { Release(buffer, byte_size_); }
+
+   private:
+    size_t byte_size_;
+  };
+
+  // Change the pool options. Buffers held in excess of the new limits
+  // are returned to the system.
+  static void Configure(const Options& options);
+
+  // Allocate a buffer of at least 'byte_size' bytes. Throws
+  // std::bad_alloc if the system is out of memory.
+  static char* Allocate(size_t byte_size);
+
+  // Release a 'buffer' allocated with Allocate(). 'byte_size' must be
+  // the size that was requested when the buffer was allocated.
+  static void Release(char* buffer, size_t byte_size);
+
+  // Get the current pool statistics. Hits served from the local free
+  // lists of other threads are added in batches, and when those
+  // threads release their lists or exit, so the hit count may lag
+  // behind by a few hundred per thread.
+  static void GetStats(Stats* stats);
+};
+
+// A buffer owned by the system memory pool.
+using PooledBuffer = std::unique_ptr<char, SystemMemoryPool::Deleter>;
+
+// Allocate a buffer of 'byte_size' bytes from the system memory pool.
+inline PooledBuffer
+AllocatePooledBuffer(size_t byte_size)
+{
+  return PooledBuffer(
+      SystemMemoryPool::Allocate(byte_size),
+      SystemMemoryPool::Deleter(byte_size));
+}
+
+}}  // namespace nvidia::inferenceserver
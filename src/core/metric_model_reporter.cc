@@ -153,4 +153,25 @@ MetricModelReporter::MetricInferenceLoadRatio(int gpu_device) const
   return hist;
 }
 
+prometheus::Counter&
+MetricModelReporter::MetricCacheHit(int gpu_device) const
+{
+  return GetCounterMetric(
+      metric_cache_hit_, Metrics::FamilyCacheHit(), gpu_device);
+}
+
+prometheus::Counter&
+MetricModelReporter::MetricCacheMiss(int gpu_device) const
+{
+  return GetCounterMetric(
+      metric_cache_miss_, Metrics::FamilyCacheMiss(), gpu_device);
+}
+
+prometheus::Counter&
+MetricModelReporter::MetricCacheEviction(int gpu_device) const
+{
+  return GetCounterMetric(
+      metric_cache_eviction_, Metrics::FamilyCacheEviction(), gpu_device);
+}
+
 }}  // namespace nvidia::inferenceserver
@@ -56,6 +56,9 @@ class MetricModelReporter {
   prometheus::Counter& MetricInferenceComputeDuration(int gpu_device) const;
   prometheus::Counter& MetricInferenceQueueDuration(int gpu_device) const;
   prometheus::Histogram& MetricInferenceLoadRatio(int gpu_device) const;
+  prometheus::Counter& MetricCacheHit(int gpu_device) const;
+  prometheus::Counter& MetricCacheMiss(int gpu_device) const;
+  prometheus::Counter& MetricCacheEviction(int gpu_device) const;
 
  private:
   void GetMetricLabels(
@@ -77,6 +80,9 @@ class MetricModelReporter {
   mutable std::map<int, prometheus::Counter*> metric_inf_compute_duration_us_;
   mutable std::map<int, prometheus::Counter*> metric_inf_queue_duration_us_;
   mutable std::map<int, prometheus::Histogram*> metric_inf_load_ratio_;
+  mutable std::map<int, prometheus::Counter*> metric_cache_hit_;
+  mutable std::map<int, prometheus::Counter*> metric_cache_miss_;
+  mutable std::map<int, prometheus::Counter*> metric_cache_eviction_;
 };
 
 }}  // namespace nvidia::inferenceserver
@@ -74,6 +74,23 @@ Metrics::Metrics()
       inf_load_ratio_family_(prometheus::BuildHistogram()
                                  .Name("nv_inference_load_ratio")
                                  .Register(*registry_)),
+      cache_hit_family_(
+          prometheus::BuildCounter()
+              .Name("nv_cache_hit")
+              .Help("Number of inference requests served from the response "
+                    "cache")
+              .Register(*registry_)),
+      cache_miss_family_(
+          prometheus::BuildCounter()
+              .Name("nv_cache_miss")
+              .Help("Number of inference requests not found in the response "
+                    "cache")
+              .Register(*registry_)),
+      cache_eviction_family_(
+          prometheus::BuildCounter()
+              .Name("nv_cache_eviction")
+              .Help("Number of responses evicted from the response cache")
+              .Register(*registry_)),
       gpu_utilization_family_(prometheus::BuildGauge()
                                   .Name("nv_gpu_utilization")
                                   .Help("GPU utilization rate [0.0 - 1.0)")
@@ -99,8 +116,34 @@ Metrics::Metrics()
               .Name("nv_energy_consumption")
               .Help("GPU energy consumption in joules since the trtserver "
                     "started")
+              .Register(*registry_)),
+      memory_pool_hit_family_(
+          prometheus::BuildCounter()
+              .Name("nv_memory_pool_hit")
+              .Help("Number of tensor buffer allocations served from the "
+                    "memory pool")
+              .Register(*registry_)),
+      memory_pool_miss_family_(
+          prometheus::BuildCounter()
+              .Name("nv_memory_pool_miss")
+              .Help("Number of tensor buffer allocations that required a "
+                    "system allocation")
+              .Register(*registry_)),
+      memory_pool_resident_bytes_family_(
+          prometheus::BuildGauge()
+              .Name("nv_memory_pool_resident_bytes")
+              .Help("Memory allocated by the memory pool, in bytes")
+              .Register(*registry_)),
+      memory_pool_cached_bytes_family_(
+          prometheus::BuildGauge()
+              .Name("nv_memory_pool_cached_bytes")
+              .Help("Memory held in the memory pool free lists, in bytes")
               .Register(*registry_))
 {
+  memory_pool_hit_ = &memory_pool_hit_family_.Add({});
+  memory_pool_miss_ = &memory_pool_miss_family_.Add({});
+  memory_pool_resident_bytes_ = &memory_pool_resident_bytes_family_.Add({});
+  memory_pool_cached_bytes_ = &memory_pool_cached_bytes_family_.Add({});
 }
 
 Metrics::~Metrics()
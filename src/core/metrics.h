@@ -100,6 +100,51 @@ class Metrics {
     return GetSingleton()->inf_load_ratio_family_;
   }
 
+  // Metric family of inference requests served from the response
+  // cache
+  static prometheus::Family<prometheus::Counter>& FamilyCacheHit()
+  {
+    return GetSingleton()->cache_hit_family_;
+  }
+
+  // Metric family of inference requests not found in the response
+  // cache
+  static prometheus::Family<prometheus::Counter>& FamilyCacheMiss()
+  {
+    return GetSingleton()->cache_miss_family_;
+  }
+
+  // Metric family of responses evicted from the response cache
+  static prometheus::Family<prometheus::Counter>& FamilyCacheEviction()
+  {
+    return GetSingleton()->cache_eviction_family_;
+  }
+
+  // Counter of tensor buffer allocations served from the memory pool
+  static prometheus::Counter& MemoryPoolHitCount()
+  {
+    return *GetSingleton()->memory_pool_hit_;
+  }
+
+  // Counter of tensor buffer allocations that required a system
+  // allocation
+  static prometheus::Counter& MemoryPoolMissCount()
+  {
+    return *GetSingleton()->memory_pool_miss_;
+  }
+
+  // Gauge of bytes allocated by the memory pool, in use or cached
+  static prometheus::Gauge& MemoryPoolResidentBytes()
+  {
+    return *GetSingleton()->memory_pool_resident_bytes_;
+  }
+
+  // Gauge of bytes held in the memory pool's shared free lists
+  static prometheus::Gauge& MemoryPoolCachedBytes()
+  {
+    return *GetSingleton()->memory_pool_cached_bytes_;
+  }
+
  private:
   Metrics();
   virtual ~Metrics();
@@ -116,12 +161,19 @@ class Metrics {
   prometheus::Family<prometheus::Counter>& inf_compute_duration_us_family_;
   prometheus::Family<prometheus::Counter>& inf_queue_duration_us_family_;
   prometheus::Family<prometheus::Histogram>& inf_load_ratio_family_;
+  prometheus::Family<prometheus::Counter>& cache_hit_family_;
+  prometheus::Family<prometheus::Counter>& cache_miss_family_;
+  prometheus::Family<prometheus::Counter>& cache_eviction_family_;
   prometheus::Family<prometheus::Gauge>& gpu_utilization_family_;
   prometheus::Family<prometheus::Gauge>& gpu_memory_total_family_;
   prometheus::Family<prometheus::Gauge>& gpu_memory_used_family_;
   prometheus::Family<prometheus::Gauge>& gpu_power_usage_family_;
   prometheus::Family<prometheus::Gauge>& gpu_power_limit_family_;
   prometheus::Family<prometheus::Counter>& gpu_energy_consumption_family_;
+  prometheus::Family<prometheus::Counter>& memory_pool_hit_family_;
+  prometheus::Family<prometheus::Counter>& memory_pool_miss_family_;
+  prometheus::Family<prometheus::Gauge>& memory_pool_resident_bytes_family_;
+  prometheus::Family<prometheus::Gauge>& memory_pool_cached_bytes_family_;
 
   std::vector<prometheus::Gauge*> gpu_utilization_;
   std::vector<prometheus::Gauge*> gpu_memory_total_;
@@ -130,6 +182,11 @@ class Metrics {
   std::vector<prometheus::Gauge*> gpu_power_limit_;
   std::vector<prometheus::Counter*> gpu_energy_consumption_;
 
+  prometheus::Counter* memory_pool_hit_;
+  prometheus::Counter* memory_pool_miss_;
+  prometheus::Gauge* memory_pool_resident_bytes_;
+  prometheus::Gauge* memory_pool_cached_bytes_;
+
   bool gpu_metrics_enabled_;
   std::unique_ptr<std::thread> nvml_thread_;
   std::atomic<bool> nvml_thread_exit_;
@@ -64,6 +64,8 @@ GetDataTypeByteSize(const DataType dtype)
       return 4;
     case TYPE_FP64:
       return 8;
+    case TYPE_BF16:
+      return 2;
     case TYPE_STRING:
       return 0;
     default:
@@ -420,6 +420,32 @@ ValidateModelConfig(
         nullptr));
   }
 
+  // If a response cache is specified make sure it has a size and
+  // that the model is stateless.
+  if (config.has_response_cache()) {
+    if (config.response_cache().max_byte_size() == 0) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "response cache max byte size must be positive for " +
+              config.name());
+    }
+    if (config.has_sequence_batching()) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "response cache can't be used with sequence batching for " +
+              config.name());
+    }
+  }
+
+  // Identical requests to a stateful model don't produce identical
+  // responses so they can't be coalesced.
+  if (config.has_request_coalescing() && config.has_sequence_batching()) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "request coalescing can't be used with sequence batching for " +
+            config.name());
+  }
+
   // If ensemble scheduling is specified, validate it.
   // Otherwise, must validate platform and instance_group
   if (config.has_ensemble_scheduling()) {
@@ -26,11 +26,17 @@
 
 #include "src/core/provider.h"
 
+#include <string.h>
+#include <algorithm>
 #include "src/core/backend.h"
+#include "src/core/blob_store.h"
 #include "src/core/constants.h"
 #include "src/core/logging.h"
 #include "src/core/model_config.h"
 #include "src/core/model_config_utils.h"
+#include "src/core/shared_memory_manager.h"
+#include "src/core/tensor_convert.h"
+#include "src/core/topk.h"
 
 namespace nvidia { namespace inferenceserver {
 
@@ -61,8 +67,7 @@ SystemMemoryReference::AddBuffer(const char* buffer, size_t byte_size)
 AllocatedSystemMemory::AllocatedSystemMemory(size_t byte_size) : SystemMemory()
 {
   total_byte_size_ = byte_size;
-  char* buffer = new char[byte_size];
-  buffer_.reset(buffer);
+  buffer_ = AllocatePooledBuffer(byte_size);
 }
 
 const char*
@@ -82,44 +87,256 @@ AllocatedSystemMemory::MutableBuffer()
   return buffer_.get();
 }
 
+namespace {
+
+// Convert the input data in 'src', delivered as 'src_dtype', to
+// 'dst_dtype' in newly allocated memory returned in 'dst'. The blocks
+// of 'src' are converted in place as they are visited, elements that
+// straddle two blocks are assembled in a small staging buffer.
+Status
+ConvertInputMemory(
+    const InferRequestHeader::Input& io, const DataType src_dtype,
+    const DataType dst_dtype, const SystemMemory& src,
+    std::shared_ptr<SystemMemory>* dst)
+{
+  const size_t src_elem_size = GetDataTypeByteSize(src_dtype);
+  const size_t dst_elem_size = GetDataTypeByteSize(dst_dtype);
+  const size_t element_count = src.TotalByteSize() / src_elem_size;
+  const float scale = io.has_conversion() ? io.conversion().scale() : 1.0f;
+  const float offset = io.has_conversion() ? io.conversion().offset() : 0.0f;
+
+  auto converted =
+      std::make_shared<AllocatedSystemMemory>(element_count * dst_elem_size);
+  char* out = converted->MutableBuffer();
+
+  char staging[sizeof(double)];
+  size_t staged = 0;
+
+  size_t idx = 0;
+  size_t byte_size;
+  const char* block;
+  while ((block = src.BufferAt(idx++, &byte_size)) != nullptr) {
+    if (staged > 0) {
+      const size_t cnt = std::min(src_elem_size - staged, byte_size);
+      memcpy(staging + staged, block, cnt);
+      staged += cnt;
+      block += cnt;
+      byte_size -= cnt;
+      if (staged < src_elem_size) {
+        continue;
+      }
+
+      RETURN_IF_ERROR(ConvertTensorData(
+          src_dtype, staging, dst_dtype, out, 1, scale, offset));
+      out += dst_elem_size;
+      staged = 0;
+    }
+
+    const size_t block_elements = byte_size / src_elem_size;
+    RETURN_IF_ERROR(ConvertTensorData(
+        src_dtype, block, dst_dtype, out, block_elements, scale, offset));
+    out += block_elements * dst_elem_size;
+
+    staged = byte_size - (block_elements * src_elem_size);
+    memcpy(staging, block + (block_elements * src_elem_size), staged);
+  }
+
+  if (staged > 0) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "input '" + io.name() + "' has a partial " +
+            DataType_Name(src_dtype) + " element");
+  }
+
+  *dst = std::move(converted);
+  return Status::Success;
+}
+
+// Transpose the input image data in 'src', delivered in the
+// 'src_format' layout, to the other of the NHWC and NCHW layouts in
+// newly allocated memory returned in 'dst'. 'dims' is the shape of
+// the input in the target layout.
+Status
+TransposeInputMemory(
+    const InferRequestHeader::Input& io, const ModelInput::Format src_format,
+    const DataType dtype, const DimsList& dims, const SystemMemory& src,
+    std::shared_ptr<SystemMemory>* dst)
+{
+  // NHWC to NCHW transposes each [ H * W, C ] matrix, NCHW to NHWC
+  // transposes each [ C, H * W ] matrix.
+  const size_t rows = (src_format == ModelInput::FORMAT_NHWC)
+                          ? (size_t)(dims[1] * dims[2])
+                          : (size_t)dims[2];
+  const size_t cols = (src_format == ModelInput::FORMAT_NHWC)
+                          ? (size_t)dims[0]
+                          : (size_t)(dims[0] * dims[1]);
+  const size_t elem_size = GetDataTypeByteSize(dtype);
+  const size_t matrix_byte_size = rows * cols * elem_size;
+  if ((matrix_byte_size == 0) ||
+      ((src.TotalByteSize() % matrix_byte_size) != 0)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "unexpected size " + std::to_string(src.TotalByteSize()) +
+            " for input '" + io.name() + "' with format " +
+            ModelInput::Format_Name(src_format));
+  }
+
+  // The transpose needs the whole image so gather the input if it is
+  // split across multiple blocks.
+  const char* data = nullptr;
+  std::shared_ptr<AllocatedSystemMemory> gathered;
+  size_t byte_size;
+  if (src.BufferAt(1, &byte_size) == nullptr) {
+    data = src.BufferAt(0, &byte_size);
+  } else {
+    gathered = std::make_shared<AllocatedSystemMemory>(src.TotalByteSize());
+    char* next = gathered->MutableBuffer();
+    size_t idx = 0;
+    const char* block;
+    while ((block = src.BufferAt(idx++, &byte_size)) != nullptr) {
+      memcpy(next, block, byte_size);
+      next += byte_size;
+    }
+    data = gathered->MutableBuffer();
+  }
+
+  auto transposed =
+      std::make_shared<AllocatedSystemMemory>(src.TotalByteSize());
+  RETURN_IF_ERROR(TransposeTensorData(
+      elem_size, data, transposed->MutableBuffer(),
+      src.TotalByteSize() / matrix_byte_size, rows, cols));
+
+  *dst = std::move(transposed);
+  return Status::Success;
+}
+
+}  // namespace
+
 //
 // InferRequestProvider
 //
 Status
 InferRequestProvider::Create(
     const std::string& model_name, const int64_t model_version,
-    const InferRequestHeader& request_header,
-    const std::unordered_map<std::string, std::shared_ptr<SystemMemory>>&
-        input_buffer,
-    std::shared_ptr<InferRequestProvider>* provider)
+    const std::shared_ptr<InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals, const InputMemoryList& input_buffer,
+    std::shared_ptr<InferRequestProvider>* provider,
+    const std::shared_ptr<RequestArena>& arena)
 {
-  provider->reset(new InferRequestProvider(model_name, model_version));
+  *provider = RequestArena::MakeShared<InferRequestProvider>(
+      arena, model_name, model_version);
+
+  if (ordinals.inputs_.size() != (size_t)request_header->input_size()) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "request header inputs have not been resolved for model '" +
+            (*provider)->model_name_ + "'");
+  }
 
   (*provider)->request_header_ = request_header;
+  (*provider)->InitInputs(ordinals);
+
+  for (int i = 0; i < request_header->input_size(); ++i) {
+    const auto& io = request_header->input(i);
+
+    // An input that references a blob or shared memory has no data
+    // in the request, the referenced bytes are used as the input data
+    // without copying.
+    std::shared_ptr<SystemMemory> memory;
+    if (!io.blob_key().empty()) {
+      RETURN_IF_ERROR(BlobStore::Get(io.blob_key(), &memory));
+    } else if (io.has_shared_memory()) {
+      RETURN_IF_ERROR(SharedMemoryManager::GetMemory(
+          io.shared_memory().name(), io.shared_memory().offset(),
+          io.shared_memory().byte_size(), &memory));
+    } else if ((size_t)i < input_buffer.size()) {
+      memory = input_buffer[i];
+    }
 
-  for (const auto& io : request_header.input()) {
-    auto it = input_buffer.find(io.name());
-    if (it == input_buffer.end()) {
+    if (memory == nullptr) {
       return Status(
           RequestStatusCode::INVALID_ARG,
           "input '" + io.name() + "' is specified in request header but" +
               " not found in memory block mapping for model '" +
               (*provider)->model_name_ + "'");
     }
-    if (io.batch_byte_size() != it->second->TotalByteSize()) {
+    if (io.batch_byte_size() != memory->TotalByteSize()) {
       return Status(
           RequestStatusCode::INVALID_ARG,
-          "unexpected size " + std::to_string(it->second->TotalByteSize()) +
+          "unexpected size " + std::to_string(memory->TotalByteSize()) +
               " for input '" + io.name() + "', expecting " +
               std::to_string(io.batch_byte_size()) + " for model '" +
               (*provider)->model_name_ + "'");
     }
-    (*provider)->input_buffer_[io.name()] = std::make_pair(it->second, 0);
+
+    // If the request delivers the input in a datatype other than the
+    // one the model expects, convert it. Backends only ever see the
+    // converted data so the header is updated to describe it.
+    if ((io.data_type() != TYPE_INVALID) || io.has_conversion()) {
+      const DataType src_dtype = (io.data_type() != TYPE_INVALID)
+                                     ? io.data_type()
+                                     : ordinals.input_dtypes_[i];
+      std::shared_ptr<SystemMemory> converted;
+      RETURN_IF_ERROR(ConvertInputMemory(
+          io, src_dtype, ordinals.input_dtypes_[i], *memory, &converted));
+      memory = std::move(converted);
+
+      auto mio = request_header->mutable_input(i);
+      mio->set_batch_byte_size(memory->TotalByteSize());
+      mio->clear_data_type();
+      mio->clear_conversion();
+    }
+
+    // Similarly, transpose an image input delivered in a different
+    // layout than the model expects.
+    if (io.format() != ModelInput::FORMAT_NONE) {
+      std::shared_ptr<SystemMemory> transposed;
+      RETURN_IF_ERROR(TransposeInputMemory(
+          io, io.format(), ordinals.input_dtypes_[i], io.dims(), *memory,
+          &transposed));
+      memory = std::move(transposed);
+      request_header->mutable_input(i)->clear_format();
+    }
+
+    (*provider)->inputs_[ordinals.inputs_[i]].memory_ = std::move(memory);
   }
 
   return Status::Success;
 }
 
+void
+InferRequestProvider::InitInputs(const RequestOrdinals& ordinals)
+{
+  ordinals_ = ordinals;
+
+  uint32_t input_cnt = 0;
+  for (const uint32_t ordinal : ordinals.inputs_) {
+    input_cnt = std::max(input_cnt, ordinal + 1);
+  }
+
+  inputs_.assign(input_cnt, Input{nullptr, nullptr, 0});
+  for (int i = 0; i < request_header_->input_size(); ++i) {
+    inputs_[ordinals.inputs_[i]].header_ = &request_header_->input(i);
+  }
+}
+
+Status
+InferRequestProvider::InputOrdinal(
+    const std::string& name, uint32_t* ordinal) const
+{
+  // A request has only a handful of inputs so a linear scan is
+  // cheaper than hashing the name.
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if ((inputs_[i].header_ != nullptr) &&
+        (inputs_[i].header_->name() == name)) {
+      *ordinal = i;
+      return Status::Success;
+    }
+  }
+
+  return Status(RequestStatusCode::INTERNAL, "unexpected input '" + name + "'");
+}
+
 const std::shared_ptr<InferRequestProvider::InputOverrideMap>&
 InferRequestProvider::GetInputOverride() const
 {
@@ -169,27 +386,49 @@ InferRequestProvider::GetNextInputContent(
     return Status::Success;
   }
 
-  if (!GetInputOverrideContent(name, content, content_byte_size)) {
-    const auto& pr = input_buffer_.find(name);
-    if (pr == input_buffer_.end()) {
-      return Status(
-          RequestStatusCode::INTERNAL, "unexpected input '" + name + "'");
-    }
+  // Inputs that are only provided as overrides, like sequence control
+  // inputs, do not have an ordinal in the request.
+  if (GetInputOverrideContent(name, content, content_byte_size)) {
+    return Status::Success;
+  }
 
-    auto& input_content = pr->second;
+  uint32_t ordinal;
+  RETURN_IF_ERROR(InputOrdinal(name, &ordinal));
+  return GetNextInputContent(
+      ordinal, content, content_byte_size, force_contiguous);
+}
 
+Status
+InferRequestProvider::GetNextInputContent(
+    uint32_t ordinal, const void** content, size_t* content_byte_size,
+    bool force_contiguous)
+{
+  if (*content_byte_size == 0) {
+    *content = nullptr;
+    return Status::Success;
+  }
+
+  if ((ordinal >= inputs_.size()) || (inputs_[ordinal].header_ == nullptr)) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unexpected input ordinal " + std::to_string(ordinal));
+  }
+
+  Input& input = inputs_[ordinal];
+  if (!GetInputOverrideContent(
+          input.header_->name(), content, content_byte_size)) {
     bool isLastChunk =
-        (input_content.first->BufferAt(
-             input_content.second + 1, content_byte_size) == nullptr);
+        (input.memory_->BufferAt(input.next_block_ + 1, content_byte_size) ==
+         nullptr);
     if (!force_contiguous || isLastChunk) {
-      *content = input_content.first->BufferAt(
-          input_content.second++, content_byte_size);
+      *content =
+          input.memory_->BufferAt(input.next_block_++, content_byte_size);
     } else {
       size_t total_size = 0;
-      size_t start_idx = input_content.second;
+      size_t start_idx = input.next_block_;
       do {
-        *content = input_content.first->BufferAt(
-            input_content.second++, content_byte_size);
+        *content =
+            input.memory_->BufferAt(input.next_block_++, content_byte_size);
         total_size += *content_byte_size;
       } while (*content != nullptr);
 
@@ -197,8 +436,8 @@ InferRequestProvider::GetNextInputContent(
       std::vector<char>& buf = contiguous_buffers_.back();
       buf.reserve(total_size);
 
-      for (size_t i = start_idx; i < input_content.second; i++) {
-        const auto& block = input_content.first->BufferAt(i, content_byte_size);
+      for (size_t i = start_idx; i < input.next_block_; i++) {
+        const auto& block = input.memory_->BufferAt(i, content_byte_size);
         buf.insert(buf.end(), block, block + *content_byte_size);
       }
 
@@ -214,17 +453,72 @@ InferRequestProvider::GetNextInputContent(
   return Status::Success;
 }
 
+Status
+InferRequestProvider::GetInputBlocks(
+    const std::string& name, std::vector<struct iovec>* blocks)
+{
+  const void* content;
+  size_t content_byte_size = 1;
+  if (GetInputOverrideContent(name, &content, &content_byte_size)) {
+    if (content != nullptr) {
+      blocks->push_back({const_cast<void*>(content), content_byte_size});
+    }
+    return Status::Success;
+  }
+
+  uint32_t ordinal;
+  RETURN_IF_ERROR(InputOrdinal(name, &ordinal));
+  return GetInputBlocks(ordinal, blocks);
+}
+
+Status
+InferRequestProvider::GetInputBlocks(
+    uint32_t ordinal, std::vector<struct iovec>* blocks)
+{
+  if ((ordinal >= inputs_.size()) || (inputs_[ordinal].header_ == nullptr)) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unexpected input ordinal " + std::to_string(ordinal));
+  }
+
+  Input& input = inputs_[ordinal];
+  const void* content;
+  size_t content_byte_size = 1;
+  if (GetInputOverrideContent(
+          input.header_->name(), &content, &content_byte_size)) {
+    if (content != nullptr) {
+      blocks->push_back({const_cast<void*>(content), content_byte_size});
+    }
+    return Status::Success;
+  }
+
+  while (true) {
+    const char* block =
+        input.memory_->BufferAt(input.next_block_, &content_byte_size);
+    if (block == nullptr) {
+      break;
+    }
+
+    input.next_block_++;
+    if (content_byte_size > 0) {
+      blocks->push_back({const_cast<char*>(block), content_byte_size});
+    }
+  }
+
+  return Status::Success;
+}
+
 Status
 InferRequestProvider::GetSystemMemory(
     const std::string& name, std::shared_ptr<SystemMemory>* input_buffer)
 {
-  auto it = input_buffer_.find(name);
-  if (it == input_buffer_.end()) {
+  uint32_t ordinal;
+  if (!InputOrdinal(name, &ordinal).IsOk()) {
     return Status(
         RequestStatusCode::INVALID_ARG,
         "input '" + name + "' is not found in the provider");
   }
-  *input_buffer = it->second.first;
+  *input_buffer = inputs_[ordinal].memory_;
   return Status::Success;
 }
 
@@ -236,7 +530,7 @@ std::mutex NULLInferRequestProvider::mu_;
 
 Status
 NULLInferRequestProvider::GetNextInputContent(
-    const std::string& name, const void** content, size_t* content_byte_size,
+    uint32_t ordinal, const void** content, size_t* content_byte_size,
     bool force_contiguous)
 {
   if (*content_byte_size == 0) {
@@ -244,26 +538,89 @@ NULLInferRequestProvider::GetNextInputContent(
     return Status::Success;
   }
 
-  if (!GetInputOverrideContent(name, content, content_byte_size)) {
+  const InferRequestHeader::Input* io = RequestInput(ordinal);
+  if (io == nullptr) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unexpected input ordinal " + std::to_string(ordinal));
+  }
+
+  if (!GetInputOverrideContent(io->name(), content, content_byte_size)) {
     std::lock_guard<std::mutex> lock(mu_);
 
     // Must return content with all zero data. This is required by
     // string-datatype tensors where it is interpreted as all empty
     // strings. Clamp the maximum size that we allow the buffer to
     // grow to avoid massive allocation.
-    if (buf_.size() < *content_byte_size) {
-      constexpr size_t max_size = 16 * 1024 * 1024;
-      buf_.resize(std::min(max_size, *content_byte_size), 0);
+    *content = ZeroBuffer(content_byte_size);
+  }
+
+  return Status::Success;
+}
+
+Status
+NULLInferRequestProvider::GetInputBlocks(
+    uint32_t ordinal, std::vector<struct iovec>* blocks)
+{
+  const InferRequestHeader::Input* io = RequestInput(ordinal);
+  if (io == nullptr) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unexpected input ordinal " + std::to_string(ordinal));
+  }
+
+  const void* content;
+  size_t content_byte_size = 1;
+  if (GetInputOverrideContent(io->name(), &content, &content_byte_size)) {
+    if (content != nullptr) {
+      blocks->push_back({const_cast<void*>(content), content_byte_size});
     }
+    return Status::Success;
+  }
+
+  size_t remaining_byte_size = io->batch_byte_size();
 
-    *content = &(buf_[0]);
+  // The zero buffer is clamped in size so a large input may need to
+  // refer to it multiple times.
+  std::lock_guard<std::mutex> lock(mu_);
+  while (remaining_byte_size > 0) {
+    size_t byte_size = remaining_byte_size;
+    content = ZeroBuffer(&byte_size);
+    blocks->push_back({const_cast<void*>(content), byte_size});
+    remaining_byte_size -= byte_size;
   }
 
   return Status::Success;
 }
 
+const void*
+NULLInferRequestProvider::ZeroBuffer(size_t* byte_size)
+{
+  constexpr size_t max_size = 16 * 1024 * 1024;
+  if (buf_.size() < *byte_size) {
+    buf_.resize(std::min(max_size, *byte_size), 0);
+  }
+
+  *byte_size = std::min(*byte_size, buf_.size());
+  return &(buf_[0]);
+}
+
 namespace {
 
+template <typename T>
+float
+ClassValue(const T value)
+{
+  return static_cast<float>(value);
+}
+
+template <>
+float
+ClassValue<Float16>(const Float16 value)
+{
+  return Float16ToFloat(value);
+}
+
 template <typename T>
 void
 AddClassResults(
@@ -273,32 +630,31 @@ AddClassResults(
     const std::shared_ptr<LabelProvider>& label_provider,
     const InferResponseProvider::SecondaryLabelProviderMap& lookup_map)
 {
-  T* probs = reinterpret_cast<T*>(poutput_buffer);
+  const T* probs = reinterpret_cast<const T*>(poutput_buffer);
   const size_t entry_cnt = batch1_element_count;
   const size_t class_cnt = std::min(cls_count, entry_cnt);
-  std::vector<size_t> idx(entry_cnt);
+
+  std::vector<size_t> topk(batch_size * class_cnt);
+  BatchTopK(probs, batch_size, entry_cnt, class_cnt, topk.data());
 
   for (size_t i = 0; i < batch_size; ++i) {
-    iota(idx.begin(), idx.end(), 0);
-    sort(idx.begin(), idx.end(), [&probs](size_t i1, size_t i2) {
-      return probs[i1] > probs[i2];
-    });
+    const size_t* idx = &topk[i * class_cnt];
 
     auto bcls = poutput->add_batch_classes();
     for (size_t k = 0; k < class_cnt; ++k) {
       auto cls = bcls->add_cls();
       cls->set_idx(idx[k]);
-      const auto& label = label_provider->GetLabel(poutput->name(), idx[k]);
-      cls->set_label(label);
-
-      if (label == "" && !lookup_map.empty()) {
+      absl::string_view label =
+          label_provider->GetLabel(poutput->name(), idx[k]);
+      if (label.empty() && !lookup_map.empty()) {
         auto it = lookup_map.find(poutput->name());
         if (it != lookup_map.end()) {
-          cls->set_label(it->second.second->GetLabel(it->second.first, idx[k]));
+          label = it->second.second->GetLabel(it->second.first, idx[k]);
         }
       }
+      cls->set_label(label.data(), label.size());
 
-      cls->set_value(static_cast<float>(probs[idx[k]]));
+      cls->set_value(ClassValue(probs[idx[k]]));
     }
 
     probs += entry_cnt;
@@ -311,21 +667,35 @@ AddClassResults(
 // InferResponseProvider
 //
 InferResponseProvider::InferResponseProvider(
-    const InferRequestHeader& request_header,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider)
-    : request_header_(request_header), label_provider_(label_provider)
+    : request_header_(request_header), output_ordinals_(ordinals.outputs_),
+      output_dtypes_(ordinals.output_dtypes_), label_provider_(label_provider)
 {
-  // Create a map from output name to the InferRequestHeader::Output
-  // object for that output.
-  for (const InferRequestHeader::Output& output : request_header.output()) {
-    output_map_.emplace(std::make_pair(output.name(), &output));
+  // Create a map from output ordinal to the index of the
+  // InferRequestHeader::Output object for that output.
+  uint32_t output_cnt = 0;
+  for (const uint32_t ordinal : output_ordinals_) {
+    output_cnt = std::max(output_cnt, ordinal + 1);
+  }
+
+  output_map_.assign(output_cnt, -1);
+  for (size_t i = 0; i < output_ordinals_.size(); ++i) {
+    output_map_[output_ordinals_[i]] = i;
   }
 }
 
 bool
 InferResponseProvider::RequiresOutput(const std::string& name)
 {
-  return output_map_.find(name) != output_map_.end();
+  for (const auto& output : request_header_->output()) {
+    if (output.name() == name) {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 Status
@@ -334,8 +704,13 @@ InferResponseProvider::OutputBufferContents(
 {
   for (const auto& output : outputs_) {
     if ((name == output.name_) && (output.cls_count_ == 0)) {
-      *content = output.ptr_;
-      *content_byte_size = output.byte_size_;
+      if (output.wire_dtype_ != TYPE_INVALID) {
+        *content = output.wire_ptr_;
+        *content_byte_size = output.wire_byte_size_;
+      } else {
+        *content = output.ptr_;
+        *content_byte_size = output.byte_size_;
+      }
       return Status::Success;
     }
   }
@@ -350,26 +725,78 @@ InferResponseProvider::CheckAndSetIfBufferedOutput(
     const std::string& name, void** content, size_t content_byte_size,
     const std::vector<int64_t>& content_shape, Output** output)
 {
-  const auto& pr = output_map_.find(name);
-  if (pr == output_map_.end()) {
+  int idx = 0;
+  while ((idx < request_header_->output_size()) &&
+         (request_header_->output(idx).name() != name)) {
+    idx++;
+  }
+  if ((idx == request_header_->output_size()) ||
+      ((size_t)idx >= output_ordinals_.size())) {
     return Status(
         RequestStatusCode::INTERNAL, "unexpected output '" + name + "'");
   }
 
+  const InferRequestHeader::Output& request_output =
+      request_header_->output(idx);
+
   outputs_.emplace_back();
   Output* loutput = &(outputs_.back());
   loutput->name_ = name;
+  loutput->ordinal_ = output_ordinals_[idx];
   loutput->shape_ = content_shape;
   loutput->cls_count_ = 0;
   loutput->ptr_ = nullptr;
   loutput->byte_size_ = content_byte_size;
+  loutput->wire_dtype_ = request_output.data_type();
+  loutput->scale_ = 1.0f;
+  loutput->offset_ = 0.0f;
+  loutput->wire_ptr_ = nullptr;
+  loutput->wire_byte_size_ = 0;
+
+  // A converted output is produced by the backend into a staging
+  // buffer and converted into the response when it is finalized.
+  size_t response_byte_size = content_byte_size;
+  if (loutput->wire_dtype_ != TYPE_INVALID) {
+    const size_t model_elem_size = GetDataTypeByteSize(output_dtypes_[idx]);
+    loutput->wire_byte_size_ = (content_byte_size / model_elem_size) *
+                               GetDataTypeByteSize(loutput->wire_dtype_);
+    if (request_output.has_conversion()) {
+      loutput->scale_ = request_output.conversion().scale();
+      loutput->offset_ = request_output.conversion().offset();
+    }
+    loutput->buffer_ = AllocatePooledBuffer(content_byte_size);
+    *content = static_cast<void*>(loutput->buffer_.get());
+    loutput->ptr_ = *content;
+    response_byte_size = loutput->wire_byte_size_;
+  }
+
+  if (request_output.has_cls()) {
+    loutput->cls_count_ = request_output.cls().count();
+    loutput->buffer_ = AllocatePooledBuffer(content_byte_size);
+    *content = static_cast<void*>(loutput->buffer_.get());
+    loutput->ptr_ = *content;
+  } else if (request_output.has_shared_memory()) {
+    // Write the output directly into the requested shared memory.
+    const SharedMemoryRange& range = request_output.shared_memory();
+    if (response_byte_size > range.byte_size()) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "output '" + name + "' requires " +
+              std::to_string(response_byte_size) +
+              " bytes but shared memory region '" + range.name() +
+              "' provides " + std::to_string(range.byte_size()));
+    }
 
-  if (pr->second->has_cls()) {
-    loutput->cls_count_ = pr->second->cls().count();
-    char* buffer = new char[content_byte_size];
-    *content = static_cast<void*>(buffer);
-    loutput->ptr_ = static_cast<void*>(buffer);
-    loutput->buffer_.reset(buffer);
+    char* buffer;
+    RETURN_IF_ERROR(SharedMemoryManager::GetMemory(
+        range.name(), range.offset(), response_byte_size,
+        &loutput->shared_memory_, &buffer));
+    if (loutput->wire_dtype_ != TYPE_INVALID) {
+      loutput->wire_ptr_ = static_cast<void*>(buffer);
+    } else {
+      *content = static_cast<void*>(buffer);
+      loutput->ptr_ = *content;
+    }
   }
 
   *output = loutput;
@@ -405,13 +832,12 @@ InferResponseProvider::FinalizeResponse(const InferenceBackend& is)
   response_header->set_model_name(is.Name());
   response_header->set_model_version(is.Version());
 
-  const size_t batch_size = request_header_.batch_size();
+  const size_t batch_size = request_header_->batch_size();
   response_header->set_batch_size(batch_size);
 
   int output_idx = 0;
   for (const auto& output : outputs_) {
-    const ModelOutput* output_config;
-    RETURN_IF_ERROR(is.GetOutput(output.name_, &output_config));
+    const ModelOutput* output_config = &is.Config().output(output.ordinal_);
 
     // Verify that the actual output shape matches what is expected by
     // the model configuration. If there is an output reshape, we've
@@ -446,7 +872,25 @@ InferResponseProvider::FinalizeResponse(const InferenceBackend& is)
     if (output.cls_count_ == 0) {
       // Raw result...
       poutput->mutable_raw()->Clear();
-      poutput->mutable_raw()->set_batch_byte_size(output.byte_size_);
+      if (output.wire_dtype_ == TYPE_INVALID) {
+        poutput->mutable_raw()->set_batch_byte_size(output.byte_size_);
+      } else {
+        if ((output.wire_ptr_ == nullptr) && (output.wire_byte_size_ > 0)) {
+          return Status(
+              RequestStatusCode::INTERNAL,
+              "no response buffer for converted output '" + output.name_ +
+                  "'");
+        }
+
+        RETURN_IF_ERROR(ConvertTensorData(
+            output_config->data_type(), output.ptr_, output.wire_dtype_,
+            output.wire_ptr_,
+            output.byte_size_ /
+                GetDataTypeByteSize(output_config->data_type()),
+            output.scale_, output.offset_));
+        poutput->mutable_raw()->set_batch_byte_size(output.wire_byte_size_);
+        poutput->mutable_raw()->set_data_type(output.wire_dtype_);
+      }
 
       // If there is a reshape them we know that output_config dims
       // are non-variable so use them directly. If there is not a
@@ -510,6 +954,12 @@ InferResponseProvider::FinalizeResponse(const InferenceBackend& is)
               secondary_label_provider_map_);
           break;
 
+        case DataType::TYPE_FP16:
+          AddClassResults<Float16>(
+              poutput, output.buffer_.get(), batch1_element_count, batch_size,
+              output.cls_count_, label_provider_,
+              secondary_label_provider_map_);
+          break;
         case DataType::TYPE_FP32:
           AddClassResults<float>(
               poutput, output.buffer_.get(), batch1_element_count, batch_size,
@@ -543,12 +993,14 @@ InferResponseProvider::FinalizeResponse(const InferenceBackend& is)
 //
 Status
 InternalInferResponseProvider::Create(
-    const InferenceBackend& is, const InferRequestHeader& request_header,
+    const InferenceBackend& is,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider,
     std::shared_ptr<InternalInferResponseProvider>* infer_provider)
 {
-  auto provider =
-      new InternalInferResponseProvider(request_header, label_provider);
+  auto provider = new InternalInferResponseProvider(
+      request_header, ordinals, label_provider);
   infer_provider->reset(provider);
   return Status::Success;
 }
@@ -576,6 +1028,22 @@ InternalInferResponseProvider::AllocateOutputBuffer(
   RETURN_IF_ERROR(CheckAndSetIfBufferedOutput(
       name, content, content_byte_size, content_shape, &output));
 
+  // The output is always passed on in the datatype produced by the
+  // model and through 'output_buffer_', so it can be neither
+  // converted nor written to shared memory.
+  if (output->wire_dtype_ != TYPE_INVALID) {
+    return Status(
+        RequestStatusCode::UNSUPPORTED,
+        "output '" + name + "' can't be converted to " +
+            DataType_Name(output->wire_dtype_) + " in an internal request");
+  }
+  if (output->shared_memory_ != nullptr) {
+    return Status(
+        RequestStatusCode::UNSUPPORTED,
+        "output '" + name +
+            "' can't be returned in shared memory in an internal request");
+  }
+
   // Always write output tensor to an output buffer no matter
   // if output has cls field defined
   auto it = output_buffer_.find(name);
@@ -616,9 +1084,10 @@ InternalInferResponseProvider::GetSystemMemory(
 }
 
 InternalInferResponseProvider::InternalInferResponseProvider(
-    const InferRequestHeader& request_header,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider)
-    : InferResponseProvider(request_header, label_provider)
+    : InferResponseProvider(request_header, ordinals, label_provider)
 {
 }
 
@@ -627,13 +1096,15 @@ InternalInferResponseProvider::InternalInferResponseProvider(
 //
 Status
 GRPCInferResponseProvider::Create(
-    const InferRequestHeader& request_header, InferResponse* response,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
+    InferResponse* response,
     const std::shared_ptr<LabelProvider>& label_provider,
-    std::shared_ptr<GRPCInferResponseProvider>* infer_provider)
+    std::shared_ptr<GRPCInferResponseProvider>* infer_provider,
+    const std::shared_ptr<RequestArena>& arena)
 {
-  GRPCInferResponseProvider* provider =
-      new GRPCInferResponseProvider(request_header, response, label_provider);
-  infer_provider->reset(provider);
+  *infer_provider = RequestArena::MakeShared<GRPCInferResponseProvider>(
+      arena, request_header, ordinals, response, label_provider);
 
   return Status::Success;
 }
@@ -663,7 +1134,12 @@ GRPCInferResponseProvider::AllocateOutputBuffer(
   // order of raw output entries equals the output meta-data. But
   // leave empty if not returning raw result for the output.
   std::string* raw_output = response_->add_raw_output();
-  if (output->ptr_ == nullptr) {
+  if (output->wire_dtype_ != TYPE_INVALID) {
+    if ((output->wire_ptr_ == nullptr) && (output->wire_byte_size_ > 0)) {
+      raw_output->resize(output->wire_byte_size_);
+      output->wire_ptr_ = static_cast<void*>(&((*raw_output)[0]));
+    }
+  } else if (output->ptr_ == nullptr) {
     raw_output->resize(content_byte_size);
     *content = static_cast<void*>(&((*raw_output)[0]));
     output->ptr_ = *content;
@@ -676,9 +1152,11 @@ GRPCInferResponseProvider::AllocateOutputBuffer(
 // HTTPInferResponseProvider
 //
 HTTPInferResponseProvider::HTTPInferResponseProvider(
-    evbuffer* output_buffer, const InferRequestHeader& request_header,
+    evbuffer* output_buffer,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider)
-    : InferResponseProvider(request_header, label_provider),
+    : InferResponseProvider(request_header, ordinals, label_provider),
       output_buffer_(output_buffer)
 {
 }
@@ -686,13 +1164,14 @@ HTTPInferResponseProvider::HTTPInferResponseProvider(
 Status
 HTTPInferResponseProvider::Create(
     evbuffer* output_buffer, const InferenceBackend& is,
-    const InferRequestHeader& request_header,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider,
-    std::shared_ptr<HTTPInferResponseProvider>* infer_provider)
+    std::shared_ptr<HTTPInferResponseProvider>* infer_provider,
+    const std::shared_ptr<RequestArena>& arena)
 {
-  HTTPInferResponseProvider* provider = new HTTPInferResponseProvider(
-      output_buffer, request_header, label_provider);
-  infer_provider->reset(provider);
+  *infer_provider = RequestArena::MakeShared<HTTPInferResponseProvider>(
+      arena, output_buffer, request_header, ordinals, label_provider);
 
   return Status::Success;
 }
@@ -720,28 +1199,35 @@ HTTPInferResponseProvider::AllocateOutputBuffer(
   RETURN_IF_ERROR(CheckAndSetIfBufferedOutput(
       name, content, content_byte_size, content_shape, &output));
 
-  if ((output->ptr_ == nullptr) && (content_byte_size > 0)) {
+  // A converted output is produced into a staging buffer, the
+  // response holds the converted bytes.
+  const bool converted = (output->wire_dtype_ != TYPE_INVALID);
+  void** response_ptr = (converted) ? &output->wire_ptr_ : &output->ptr_;
+  const size_t response_byte_size =
+      (converted) ? output->wire_byte_size_ : content_byte_size;
+
+  if ((*response_ptr == nullptr) && (response_byte_size > 0)) {
     // Reserve requested space in evbuffer...
     struct evbuffer_iovec output_iovec;
     if (evbuffer_reserve_space(
-            output_buffer_, content_byte_size, &output_iovec, 1) != 1) {
+            output_buffer_, response_byte_size, &output_iovec, 1) != 1) {
       return Status(
           RequestStatusCode::INTERNAL, "failed to reserve " +
-                                           std::to_string(content_byte_size) +
+                                           std::to_string(response_byte_size) +
                                            " bytes in output tensor buffer");
     }
 
-    if (output_iovec.iov_len < content_byte_size) {
+    if (output_iovec.iov_len < response_byte_size) {
       return Status(
           RequestStatusCode::INTERNAL,
           "reserved " + std::to_string(output_iovec.iov_len) +
               " bytes in output tensor buffer, need " +
-              std::to_string(content_byte_size));
+              std::to_string(response_byte_size));
     }
 
-    output_iovec.iov_len = content_byte_size;
-    *content = output_iovec.iov_base;
-    output->ptr_ = *content;
+    output_iovec.iov_len = response_byte_size;
+    *response_ptr = output_iovec.iov_base;
+    *content = output->ptr_;
 
     // Immediately commit the buffer space. Some backends will write
     // async to the just allocated buffer space so we are relying on
@@ -750,7 +1236,7 @@ HTTPInferResponseProvider::AllocateOutputBuffer(
     // entry in output_iovec), this seems to be a valid assumption.
     if (evbuffer_commit_space(output_buffer_, &output_iovec, 1) != 0) {
       *content = nullptr;
-      output->ptr_ = nullptr;
+      *response_ptr = nullptr;
       return Status(
           RequestStatusCode::INTERNAL,
           "failed to commit output tensors to output buffer");
@@ -765,12 +1251,14 @@ HTTPInferResponseProvider::AllocateOutputBuffer(
 //
 Status
 DelegatingInferResponseProvider::Create(
-    const InferRequestHeader& request_header,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider,
     std::shared_ptr<DelegatingInferResponseProvider>* infer_provider)
 {
   DelegatingInferResponseProvider* provider =
-      new DelegatingInferResponseProvider(request_header, label_provider);
+      new DelegatingInferResponseProvider(
+          request_header, ordinals, label_provider);
   infer_provider->reset(provider);
 
   return Status::Success;
@@ -799,11 +1287,15 @@ DelegatingInferResponseProvider::AllocateOutputBuffer(
   RETURN_IF_ERROR(CheckAndSetIfBufferedOutput(
       name, content, content_byte_size, content_shape, &output));
 
-  if ((output->buffer_ == nullptr) && (content_byte_size > 0)) {
-    char* buffer = new char[content_byte_size];
-    *content = static_cast<void*>(buffer);
-    output->ptr_ = static_cast<void*>(buffer);
-    output->buffer_.reset(buffer);
+  if (output->wire_dtype_ != TYPE_INVALID) {
+    if ((output->wire_ptr_ == nullptr) && (output->wire_byte_size_ > 0)) {
+      output->wire_buffer_ = AllocatePooledBuffer(output->wire_byte_size_);
+      output->wire_ptr_ = static_cast<void*>(output->wire_buffer_.get());
+    }
+  } else if ((output->ptr_ == nullptr) && (content_byte_size > 0)) {
+    output->buffer_ = AllocatePooledBuffer(content_byte_size);
+    *content = static_cast<void*>(output->buffer_.get());
+    output->ptr_ = *content;
   }
 
   return Status::Success;
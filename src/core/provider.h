@@ -25,10 +25,13 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include <sys/uio.h>
 #include "libevent/include/event2/buffer.h"
 #include "src/core/api.pb.h"
 #include "src/core/grpc_service.pb.h"
+#include "src/core/memory_pool.h"
 #include "src/core/model_config.h"
+#include "src/core/request_arena.h"
 #include "src/core/status.h"
 
 namespace nvidia { namespace inferenceserver {
@@ -87,22 +90,53 @@ class AllocatedSystemMemory : public SystemMemory {
   char* MutableBuffer();
 
  private:
-  std::unique_ptr<char[]> buffer_;
+  PooledBuffer buffer_;
 };
 
+//
+// The model configuration ordinals of the inputs and outputs of a
+// request. Entry 'i' of 'inputs_' is the ordinal, within the model
+// configuration, of the 'i'th input in the request header, and
+// similarly for 'outputs_'. Entry 'i' of 'input_dtypes_' is the
+// datatype the model expects for the 'i'th input in the request
+// header, which the provider converts the input data to if the
+// request delivers it in a different datatype, and similarly
+// 'output_dtypes_' is the datatype the model produces for each output.
+//
+struct RequestOrdinals {
+  std::vector<uint32_t> inputs_;
+  std::vector<DataType> input_dtypes_;
+  std::vector<uint32_t> outputs_;
+  std::vector<DataType> output_dtypes_;
+};
+
+//
+// The data of each input of a request, in the same order as the
+// inputs appear in the request header.
+//
+using InputMemoryList = std::vector<std::shared_ptr<SystemMemory>>;
+
 //
 // Provide inference request inputs and meta-data
 //
 class InferRequestProvider {
  public:
-  // Initialize based on map from input name to data. The 'input_buffer' object
-  // is mapping from input name to data buffer for that input.
+  // Initialize based on the data of each input. Entry 'i' of
+  // 'input_buffer' is the data for the 'i'th input of
+  // 'request_header', whose model configuration ordinal is given by
+  // 'ordinals'. An input that specifies a blob key or shared memory
+  // uses the referenced bytes as its data and its 'input_buffer'
+  // entry is ignored. If 'arena' is given the provider is created in
+  // it. The provider shares 'request_header' instead of copying it,
+  // updating it in place when the inputs are converted, so the caller
+  // must not modify it after the call.
   static Status Create(
       const std::string& model_name, const int64_t model_version,
-      const InferRequestHeader& request_header,
-      const std::unordered_map<std::string, std::shared_ptr<SystemMemory>>&
-          input_buffer,
-      std::shared_ptr<InferRequestProvider>* provider);
+      const std::shared_ptr<InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
+      const InputMemoryList& input_buffer,
+      std::shared_ptr<InferRequestProvider>* provider,
+      const std::shared_ptr<RequestArena>& arena = nullptr);
 
   // Return the requested model name.
   const std::string& ModelName() const { return model_name_; }
@@ -114,7 +148,11 @@ class InferRequestProvider {
   // Get the request header for this inference request that has been
   // validated and normalized so that all inputs have shape and
   // batch-byte-size defined.
-  const InferRequestHeader& RequestHeader() const { return request_header_; }
+  const InferRequestHeader& RequestHeader() const { return *request_header_; }
+
+  // Get the model configuration ordinals of the inputs and outputs
+  // of the request header.
+  const RequestOrdinals& Ordinals() const { return ordinals_; }
 
   // Get the next contiguous chunk of bytes for the 'name'd
   // input. Return a pointer to the chunk in 'content'.
@@ -127,10 +165,36 @@ class InferRequestProvider {
   // 'force_contiguous' is true then the entire (remaining) input will
   // be returned as a single chunk. In some cases this will require
   // copying the data.
-  virtual Status GetNextInputContent(
+  Status GetNextInputContent(
       const std::string& name, const void** content, size_t* content_byte_size,
       bool force_contiguous);
 
+  // Get the next contiguous chunk of bytes for the input with model
+  // configuration ordinal 'ordinal'. \see GetNextInputContent().
+  virtual Status GetNextInputContent(
+      uint32_t ordinal, const void** content, size_t* content_byte_size,
+      bool force_contiguous);
+
+  // Get all remaining chunks of bytes for the 'name'd input without
+  // copying. Each chunk is appended to 'blocks' in order. After this
+  // call the input is consumed and GetNextInputContent() will return
+  // 'content' == nullptr for it.
+  Status GetInputBlocks(
+      const std::string& name, std::vector<struct iovec>* blocks);
+
+  // Get all remaining chunks of bytes for the input with model
+  // configuration ordinal 'ordinal'. \see GetInputBlocks().
+  virtual Status GetInputBlocks(
+      uint32_t ordinal, std::vector<struct iovec>* blocks);
+
+  // Get the request header information for the input with model
+  // configuration ordinal 'ordinal', or nullptr if the request does
+  // not have that input.
+  const InferRequestHeader::Input* RequestInput(uint32_t ordinal) const
+  {
+    return (ordinal < inputs_.size()) ? inputs_[ordinal].header_ : nullptr;
+  }
+
   // Retrieve the data buffer of input 'name'.
   Status GetSystemMemory(
       const std::string& name, std::shared_ptr<SystemMemory>* input_buffer);
@@ -149,6 +213,7 @@ class InferRequestProvider {
   Status SetInputOverride(const std::shared_ptr<InputOverrideMap>& override);
 
  protected:
+  friend class RequestArena;
   explicit InferRequestProvider(
       const std::string& model_name, const int64_t version)
       : model_name_(model_name), version_(version)
@@ -164,9 +229,17 @@ class InferRequestProvider {
   bool GetInputOverrideContent(
       const std::string& name, const void** content, size_t* content_byte_size);
 
+  // Set 'ordinals_' and initialize 'inputs_' from 'request_header_'
+  // and 'ordinals'.
+  void InitInputs(const RequestOrdinals& ordinals);
+
+  // Get the model configuration ordinal of the 'name'd input.
+  Status InputOrdinal(const std::string& name, uint32_t* ordinal) const;
+
   const std::string model_name_;
   const int64_t version_;
-  InferRequestHeader request_header_;
+  std::shared_ptr<const InferRequestHeader> request_header_;
+  RequestOrdinals ordinals_;
 
   // Input content overrides.
   std::shared_ptr<InputOverrideMap> overrides_;
@@ -181,11 +254,15 @@ class InferRequestProvider {
   // Placeholder for providing buffer as contiguous block.
   std::vector<std::vector<char>> contiguous_buffers_;
 
-  // Map from input name to the content of the input. The content contains
-  // the buffer and index to the next data block for the named input.
-  std::unordered_map<
-      std::string, std::pair<std::shared_ptr<SystemMemory>, size_t>>
-      input_buffer_;
+  // The state of each input, indexed by the model configuration
+  // ordinal of the input. 'header_' is nullptr for an ordinal that is
+  // not in the request.
+  struct Input {
+    const InferRequestHeader::Input* header_;
+    std::shared_ptr<SystemMemory> memory_;
+    size_t next_block_;
+  };
+  std::vector<Input> inputs_;
 };
 
 //
@@ -196,17 +273,31 @@ class InferRequestProvider {
 //
 class NULLInferRequestProvider : public InferRequestProvider {
  public:
-  explicit NULLInferRequestProvider(const InferRequestHeader& request_header)
+  explicit NULLInferRequestProvider(
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals)
       : InferRequestProvider("<NULL>", -1)
   {
     request_header_ = request_header;
+    InitInputs(ordinals);
   }
 
+  using InferRequestProvider::GetInputBlocks;
+  using InferRequestProvider::GetNextInputContent;
+
   Status GetNextInputContent(
-      const std::string& name, const void** content, size_t* content_byte_size,
+      uint32_t ordinal, const void** content, size_t* content_byte_size,
       bool force_contiguous) override;
 
+  Status GetInputBlocks(
+      uint32_t ordinal, std::vector<struct iovec>* blocks) override;
+
  private:
+  // Return a buffer of at least 'byte_size' zero bytes, or of the
+  // maximum size of the buffer if 'byte_size' is larger than that.
+  // Must be called with 'mu_' held.
+  static const void* ZeroBuffer(size_t* byte_size);
+
   // A buffer of zero bytes that is used commonly as the NULL input.
   static std::vector<uint8_t> buf_;
 
@@ -226,7 +317,8 @@ class InferResponseProvider {
       std::unordered_map<std::string, SecondaryLabelProvider>;
 
   explicit InferResponseProvider(
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider);
 
   // Get the full response header for this inference request.
@@ -238,6 +330,13 @@ class InferResponseProvider {
   // Return true if this provider requires a named output.
   bool RequiresOutput(const std::string& name);
 
+  // Return true if this provider requires the output with model
+  // configuration ordinal 'ordinal'.
+  bool RequiresOutput(uint32_t ordinal) const
+  {
+    return (ordinal < output_map_.size()) && (output_map_[ordinal] >= 0);
+  }
+
   // Get a buffer to store results for a named output. Must be called
   // exactly once for each output that is being returned for the
   // request. The output must be listed in the request header.
@@ -245,8 +344,9 @@ class InferResponseProvider {
       const std::string& name, void** content, size_t content_byte_size,
       const std::vector<int64_t>& content_shape) = 0;
 
-  // Get the address and byte-size of an output buffer. Error is
-  // returned if the buffer is not already allocated.
+  // Get the address and byte-size of an output buffer, after any
+  // requested datatype conversion. Error is returned if the buffer is
+  // not already allocated.
   Status OutputBufferContents(
       const std::string& name, void** content, size_t* content_byte_size) const;
 
@@ -268,34 +368,67 @@ class InferResponseProvider {
   // Finalize response based on a servable.
   Status FinalizeResponse(const InferenceBackend& is);
 
- protected:
-  struct Output;
+  // Information about each output.
+  struct Output {
+    std::string name_;
+    uint32_t ordinal_;
+    std::vector<int64_t> shape_;
+    size_t cls_count_;
+    void* ptr_;
+    size_t byte_size_;
 
+    // Created buffer for non-RAW and converted results
+    PooledBuffer buffer_;
+
+    // Shared memory holding a result that is written in place
+    std::shared_ptr<SystemMemory> shared_memory_;
+
+    // The datatype the output is returned in if it is converted from
+    // the datatype produced by the model, TYPE_INVALID if it is not
+    // converted. A converted output is produced into 'buffer_' and
+    // converted into the 'wire_byte_size_' bytes at 'wire_ptr_' when
+    // the response is finalized.
+    DataType wire_dtype_;
+    float scale_;
+    float offset_;
+    void* wire_ptr_;
+    size_t wire_byte_size_;
+
+    // Created buffer for the converted result if the response doesn't
+    // provide one
+    PooledBuffer wire_buffer_;
+  };
+
+  // Get the outputs in the order they were added by
+  // AllocateOutputBuffer(). 'ptr_' of each output holds the raw
+  // output tensor.
+  const std::vector<Output>& Outputs() const { return outputs_; }
+
+ protected:
   // Check that 'name' is a valid output. If output is to be buffered,
-  // allocate space for it and point to that space with 'content'
+  // allocate space for it and point to that space with 'content'. If
+  // the output is requested in shared memory point 'content' at that
+  // memory.
   Status CheckAndSetIfBufferedOutput(
       const std::string& name, void** content, size_t content_byte_size,
       const std::vector<int64_t>& content_shape, Output** output);
 
  protected:
-  const InferRequestHeader& request_header_;
+  // The request header, shared with the request provider.
+  std::shared_ptr<const InferRequestHeader> request_header_;
 
-  // Map from output name to the InferRequestHeader output information
-  // for that output.
-  std::unordered_map<std::string, const InferRequestHeader::Output*>
-      output_map_;
+  // The model configuration ordinal of each output in the request
+  // header.
+  std::vector<uint32_t> output_ordinals_;
 
-  // Information about each output.
-  struct Output {
-    std::string name_;
-    std::vector<int64_t> shape_;
-    size_t cls_count_;
-    void* ptr_;
-    size_t byte_size_;
+  // The datatype produced by the model for each output in the request
+  // header.
+  std::vector<DataType> output_dtypes_;
 
-    // Created buffer for non-RAW results
-    std::unique_ptr<char[]> buffer_;
-  };
+  // Map from the model configuration ordinal of an output to the
+  // index of that output in the request header, or -1 if the output
+  // is not requested.
+  std::vector<int> output_map_;
 
   // Ordered list of outputs as they "added" by AllocateOutputBuffer().
   std::vector<Output> outputs_;
@@ -310,13 +443,17 @@ class InferResponseProvider {
 };
 
 //
-// Inference response provider for an internal request
+// Inference response provider for an internal request. Outputs are
+// kept in the datatype produced by the model, so outputs requested
+// with a different datatype or in shared memory are not supported.
 //
 class InternalInferResponseProvider : public InferResponseProvider {
  public:
   // Create a InternalInferResponseProvider object.
   static Status Create(
-      const InferenceBackend& is, const InferRequestHeader& request_header,
+      const InferenceBackend& is,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider,
       std::shared_ptr<InternalInferResponseProvider>* infer_provider);
 
@@ -332,7 +469,8 @@ class InternalInferResponseProvider : public InferResponseProvider {
 
  private:
   InternalInferResponseProvider(
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider);
 
   InferResponseHeader response_header_;
@@ -345,11 +483,15 @@ class InternalInferResponseProvider : public InferResponseProvider {
 //
 class GRPCInferResponseProvider : public InferResponseProvider {
  public:
-  // Initialize based on gRPC request
+  // Initialize based on gRPC request. If 'arena' is given the
+  // provider is created in it.
   static Status Create(
-      const InferRequestHeader& request_header, InferResponse* response,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
+      InferResponse* response,
       const std::shared_ptr<LabelProvider>& label_provider,
-      std::shared_ptr<GRPCInferResponseProvider>* infer_provider);
+      std::shared_ptr<GRPCInferResponseProvider>* infer_provider,
+      const std::shared_ptr<RequestArena>& arena = nullptr);
 
   const InferResponseHeader& ResponseHeader() const override;
   InferResponseHeader* MutableResponseHeader() override;
@@ -358,10 +500,13 @@ class GRPCInferResponseProvider : public InferResponseProvider {
       const std::vector<int64_t>& content_shape) override;
 
  private:
+  friend class RequestArena;
   GRPCInferResponseProvider(
-      const InferRequestHeader& request_header, InferResponse* response,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
+      InferResponse* response,
       const std::shared_ptr<LabelProvider>& label_provider)
-      : InferResponseProvider(request_header, label_provider),
+      : InferResponseProvider(request_header, ordinals, label_provider),
         response_(response)
   {
   }
@@ -374,11 +519,14 @@ class GRPCInferResponseProvider : public InferResponseProvider {
 //
 class HTTPInferResponseProvider : public InferResponseProvider {
  public:
+  // If 'arena' is given the provider is created in it.
   static Status Create(
       evbuffer* output_buffer, const InferenceBackend& is,
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider,
-      std::shared_ptr<HTTPInferResponseProvider>* infer_provider);
+      std::shared_ptr<HTTPInferResponseProvider>* infer_provider,
+      const std::shared_ptr<RequestArena>& arena = nullptr);
 
   const InferResponseHeader& ResponseHeader() const override;
   InferResponseHeader* MutableResponseHeader() override;
@@ -387,8 +535,11 @@ class HTTPInferResponseProvider : public InferResponseProvider {
       const std::vector<int64_t>& content_shape) override;
 
  private:
+  friend class RequestArena;
   HTTPInferResponseProvider(
-      evbuffer* output_buffer, const InferRequestHeader& request_header,
+      evbuffer* output_buffer,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider);
 
   InferResponseHeader response_header_;
@@ -402,7 +553,8 @@ class HTTPInferResponseProvider : public InferResponseProvider {
 class DelegatingInferResponseProvider : public InferResponseProvider {
  public:
   static Status Create(
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider,
       std::shared_ptr<DelegatingInferResponseProvider>* infer_provider);
 
@@ -414,9 +566,10 @@ class DelegatingInferResponseProvider : public InferResponseProvider {
 
  private:
   DelegatingInferResponseProvider(
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider)
-      : InferResponseProvider(request_header, label_provider)
+      : InferResponseProvider(request_header, ordinals, label_provider)
   {
   }
 
@@ -32,12 +32,14 @@
 #include "src/core/logging.h"
 #include "src/core/model_config.h"
 #include "src/core/model_config_utils.h"
+#include "src/core/tensor_convert.h"
 
 namespace nvidia { namespace inferenceserver {
 
 Status
 NormalizeRequestHeader(
-    const InferenceBackend& is, InferRequestHeader& request_header)
+    const InferenceBackend& is, InferRequestHeader& request_header,
+    RequestOrdinals* ordinals)
 {
   const std::string& model_name = is.Name();
   const ModelConfig& model_config = is.Config();
@@ -72,10 +74,97 @@ NormalizeRequestHeader(
             " inputs for model '" + model_name + "'");
   }
 
+  ordinals->inputs_.clear();
+  ordinals->input_dtypes_.clear();
+  ordinals->outputs_.clear();
+  ordinals->output_dtypes_.clear();
+
+  // The request has exactly as many inputs as the model so each model
+  // input must appear exactly once.
+  std::vector<bool> seen_inputs(model_config.input_size(), false);
+
   // Update each input to have shape and batch-byte-size.
   for (InferRequestHeader::Input& io : *request_header.mutable_input()) {
-    const ModelInput* input_config;
-    RETURN_IF_ERROR(is.GetInput(io.name(), &input_config));
+    uint32_t ordinal;
+    RETURN_IF_ERROR(is.GetInputOrdinal(io.name(), &ordinal));
+    if (seen_inputs[ordinal]) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "input '" + io.name() + "' is specified multiple times for model '" +
+              model_name + "'");
+    }
+    seen_inputs[ordinal] = true;
+    ordinals->inputs_.push_back(ordinal);
+
+    if (!io.blob_key().empty() && io.has_shared_memory()) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "input '" + io.name() +
+              "' cannot specify both a blob key and shared memory for model '" +
+              model_name + "'");
+    }
+
+    const ModelInput* input_config = &model_config.input(ordinal);
+    ordinals->input_dtypes_.push_back(input_config->data_type());
+
+    // The request may deliver the input in a different datatype than
+    // the model expects, in which case the provider converts it. The
+    // datatype is cleared when no conversion is needed so that the
+    // provider only has to check for its presence.
+    if (io.data_type() == input_config->data_type()) {
+      io.clear_data_type();
+    }
+    const DataType wire_dtype = (io.data_type() != TYPE_INVALID)
+                                    ? io.data_type()
+                                    : input_config->data_type();
+    if (((io.data_type() != TYPE_INVALID) || io.has_conversion()) &&
+        !IsConvertibleDataType(wire_dtype, input_config->data_type())) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "unable to convert input '" + io.name() + "' from " +
+              DataType_Name(wire_dtype) + " to " +
+              DataType_Name(input_config->data_type()) + " for model '" +
+              model_name + "'");
+    }
+
+    // The request may deliver an image input in the other of the
+    // NHWC and NCHW layouts than the model expects, in which case the
+    // provider transposes it. As for the datatype, the format is
+    // cleared when no transpose is needed. The request shape is
+    // permuted to the layout of the model.
+    if (io.format() == input_config->format()) {
+      io.clear_format();
+    }
+    if (io.format() != ModelInput::FORMAT_NONE) {
+      if ((input_config->format() == ModelInput::FORMAT_NONE) ||
+          input_config->has_reshape()) {
+        return Status(
+            RequestStatusCode::INVALID_ARG,
+            "unable to change the format of input '" + io.name() +
+                "' for model '" + model_name + "'");
+      }
+
+      if (io.dims_size() > 0) {
+        if (io.dims_size() != 3) {
+          return Status(
+              RequestStatusCode::INVALID_ARG,
+              "input '" + io.name() + "' with format " +
+                  ModelInput::Format_Name(io.format()) +
+                  " requires 3 dims for model '" + model_name + "'");
+        }
+
+        const auto wire_dims = io.dims();
+        if (io.format() == ModelInput::FORMAT_NHWC) {
+          io.set_dims(0, wire_dims[2]);
+          io.set_dims(1, wire_dims[0]);
+          io.set_dims(2, wire_dims[1]);
+        } else {
+          io.set_dims(0, wire_dims[1]);
+          io.set_dims(1, wire_dims[2]);
+          io.set_dims(2, wire_dims[0]);
+        }
+      }
+    }
 
     // If the inference request specifies a shape for an input, make
     // sure it matches what the model expects.
@@ -141,13 +230,14 @@ NormalizeRequestHeader(
     // Note that non-batching zero-rank tensor is not allowed since
     // that will always be shape [], i.e. a tensor with no contents.
     //
+    // The byte-size is that of the data as delivered in the request.
+    //
     uint64_t bs = 0;
-    if (IsFixedSizeDataType(input_config->data_type())) {
-      bs = GetByteSize(input_config->data_type(), io.dims());
+    if (IsFixedSizeDataType(wire_dtype)) {
+      bs = GetByteSize(wire_dtype, io.dims());
       if (model_config.max_batch_size() > 0) {
         if (io.dims_size() == 0) {
-          bs = GetDataTypeByteSize(input_config->data_type()) *
-               request_header.batch_size();
+          bs = GetDataTypeByteSize(wire_dtype) * request_header.batch_size();
         } else {
           bs *= request_header.batch_size();
         }
@@ -172,14 +262,78 @@ NormalizeRequestHeader(
     io.set_batch_byte_size(bs);
   }
 
+  for (InferRequestHeader::Output& io : *request_header.mutable_output()) {
+    uint32_t ordinal;
+    RETURN_IF_ERROR(is.GetOutputOrdinal(io.name(), &ordinal));
+    ordinals->outputs_.push_back(ordinal);
+
+    const DataType model_dtype = model_config.output(ordinal).data_type();
+    ordinals->output_dtypes_.push_back(model_dtype);
+
+    if (io.has_cls() && io.has_shared_memory()) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "classification output '" + io.name() +
+              "' cannot be returned in shared memory for model '" +
+              model_name + "'");
+    }
+
+    // As for inputs, the datatype is cleared when no conversion is
+    // needed.
+    if ((io.data_type() == model_dtype) && !io.has_conversion()) {
+      io.clear_data_type();
+    }
+    if ((io.data_type() != TYPE_INVALID) || io.has_conversion()) {
+      if (io.has_cls()) {
+        return Status(
+            RequestStatusCode::INVALID_ARG,
+            "classification output '" + io.name() +
+                "' cannot be converted for model '" + model_name + "'");
+      }
+      if (io.data_type() == TYPE_INVALID) {
+        io.set_data_type(model_dtype);
+      }
+      if (!IsConvertibleDataType(model_dtype, io.data_type())) {
+        return Status(
+            RequestStatusCode::INVALID_ARG,
+            "unable to convert output '" + io.name() + "' from " +
+                DataType_Name(model_dtype) + " to " +
+                DataType_Name(io.data_type()) + " for model '" + model_name +
+                "'");
+      }
+    }
+  }
+
+  // Only the TensorFlow backends understand string encodings other
+  // than the default.
+  if ((request_header.string_encoding() !=
+       InferRequestHeader::STRING_LENGTH_PREFIXED) &&
+      (model_config.platform() != kTensorFlowGraphDefPlatform) &&
+      (model_config.platform() != kTensorFlowSavedModelPlatform)) {
+    bool has_string = false;
+    for (const auto& io : model_config.input()) {
+      has_string |= (io.data_type() == TYPE_STRING);
+    }
+    for (const auto& io : model_config.output()) {
+      has_string |= (io.data_type() == TYPE_STRING);
+    }
+    if (has_string) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "string encoding " +
+              InferRequestHeader::StringEncoding_Name(
+                  request_header.string_encoding()) +
+              " is not supported for model '" + model_name + "'");
+    }
+  }
+
   return Status::Success;
 }
 
 Status
 EVBufferToInputMap(
     const std::string& model_name, const InferRequestHeader& request_header,
-    evbuffer* input_buffer,
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>>& input_map)
+    evbuffer* input_buffer, InputMemoryList& input_map)
 {
   // Now need to create 'ref'. Each input has one entry in
   // SystemMemory which gives a list of all the blocks of data for that
@@ -206,9 +360,15 @@ EVBufferToInputMap(
   // Get the byte-size for each input and from that get the blocks
   // holding the data for that input
   for (const auto& io : request_header.input()) {
+    // Blob and shared-memory inputs have no data in the request,
+    // their data is resolved when the request provider is created.
+    if (!io.blob_key().empty() || io.has_shared_memory()) {
+      input_map.emplace_back(nullptr);
+      continue;
+    }
+
     auto memory_ref = std::make_shared<SystemMemoryReference>();
-    input_map.emplace(std::make_pair(
-        io.name(), std::static_pointer_cast<SystemMemory>(memory_ref)));
+    input_map.emplace_back(std::static_pointer_cast<SystemMemory>(memory_ref));
 
     uint64_t byte_size = io.batch_byte_size();
     while ((byte_size > 0) && (v_idx < n)) {
@@ -248,16 +408,24 @@ EVBufferToInputMap(
 Status
 GRPCInferRequestToInputMap(
     const InferRequestHeader& request_header, const InferRequest& request,
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>>& input_map)
+    InputMemoryList& input_map)
 {
   // Make sure that the request is providing the same number of raw
-  // input tensor data.
-  if (request_header.input_size() != request.raw_input_size()) {
+  // input tensor data. Blob and shared-memory inputs have no raw data
+  // in the request, their data is resolved when the request provider
+  // is created.
+  int data_input_cnt = 0;
+  for (const auto& io : request_header.input()) {
+    if (io.blob_key().empty() && !io.has_shared_memory()) {
+      data_input_cnt++;
+    }
+  }
+
+  if (data_input_cnt != request.raw_input_size()) {
     return Status(
         RequestStatusCode::INVALID_ARG,
-        "expected tensor data for " +
-            std::to_string(request_header.input_size()) + " inputs but got " +
-            std::to_string(request.raw_input_size()) +
+        "expected tensor data for " + std::to_string(data_input_cnt) +
+            " inputs but got " + std::to_string(request.raw_input_size()) +
             " sets of data for model '" + request.model_name() + "'");
   }
 
@@ -265,9 +433,13 @@ GRPCInferRequestToInputMap(
   // the provided raw tensor data.
   size_t idx = 0;
   for (const auto& io : request_header.input()) {
+    if (!io.blob_key().empty() || io.has_shared_memory()) {
+      input_map.emplace_back(nullptr);
+      continue;
+    }
+
     auto memory_ref = std::make_shared<SystemMemoryReference>();
-    input_map.emplace(std::make_pair(
-        io.name(), std::static_pointer_cast<SystemMemory>(memory_ref)));
+    input_map.emplace_back(std::static_pointer_cast<SystemMemory>(memory_ref));
 
     if (io.batch_byte_size() != request.raw_input(idx).size()) {
       return Status(
@@ -36,18 +36,20 @@ namespace nvidia { namespace inferenceserver {
 class InferenceBackend;
 
 // Validate request header and modify as necessary so that every
-// input has a shape and a batch-byte-size.
+// input has a shape and a batch-byte-size. Return in 'ordinals' the
+// model configuration ordinal of each input and output of the
+// request.
 Status NormalizeRequestHeader(
-    const InferenceBackend& is, InferRequestHeader& request_header);
+    const InferenceBackend& is, InferRequestHeader& request_header,
+    RequestOrdinals* ordinals);
 
 Status EVBufferToInputMap(
     const std::string& model_name,
     const InferRequestHeader& normalized_request_header, evbuffer* input_buffer,
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>>& input_map);
+    InputMemoryList& input_map);
 
 Status GRPCInferRequestToInputMap(
     const InferRequestHeader& normalized_request_header,
-    const InferRequest& request,
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>>& input_map);
+    const InferRequest& request, InputMemoryList& input_map);
 
 }}  // namespace nvidia::inferenceserver
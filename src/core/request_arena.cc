@@ -0,0 +1,98 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/request_arena.h"
+
+#include <stdint.h>
+#include <algorithm>
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+google::protobuf::ArenaOptions
+ProtoArenaOptions(char* initial_block, size_t initial_block_size)
+{
+  google::protobuf::ArenaOptions options;
+  options.initial_block = initial_block;
+  options.initial_block_size = initial_block_size;
+  return options;
+}
+
+}  // namespace
+
+RequestArena::RequestArena()
+    : next_(inline_block_), end_(inline_block_ + kInlineByteSize),
+      blocks_(nullptr), overflow_block_cnt_(0), cleanups_(nullptr),
+      proto_arena_(
+          ProtoArenaOptions(proto_inline_block_, kProtoInlineByteSize))
+{
+}
+
+RequestArena::~RequestArena()
+{
+  while (cleanups_ != nullptr) {
+    cleanups_->destroy_(cleanups_->obj_);
+    cleanups_ = cleanups_->next_;
+  }
+
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next_;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void*
+RequestArena::Allocate(size_t byte_size, size_t alignment)
+{
+  uintptr_t ptr = reinterpret_cast<uintptr_t>(next_);
+  ptr = (ptr + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  if ((ptr + byte_size) > reinterpret_cast<uintptr_t>(end_)) {
+    // Grow geometrically so a large request needs only a few blocks.
+    const size_t last_byte_size =
+        (blocks_ == nullptr) ? kInlineByteSize : blocks_->byte_size_;
+    const size_t block_byte_size = std::max(
+        2 * last_byte_size, sizeof(Block) + byte_size + alignment);
+
+    Block* block = static_cast<Block*>(::operator new(block_byte_size));
+    block->next_ = blocks_;
+    block->byte_size_ = block_byte_size;
+    blocks_ = block;
+    overflow_block_cnt_++;
+
+    next_ = reinterpret_cast<char*>(block + 1);
+    end_ = reinterpret_cast<char*>(block) + block_byte_size;
+
+    ptr = reinterpret_cast<uintptr_t>(next_);
+    ptr = (ptr + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  }
+
+  next_ = reinterpret_cast<char*>(ptr + byte_size);
+  return reinterpret_cast<void*>(ptr);
+}
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,151 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <google/protobuf/arena.h>
+#include <stddef.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace nvidia { namespace inferenceserver {
+
+//
+// Memory for the objects created while handling a single inference
+// request. Objects are allocated by bumping a pointer, the first few
+// kilobytes from storage inside the arena itself, and are all
+// destroyed, in reverse order of creation, when the arena is
+// destroyed. Protobuf messages are created in a protobuf arena that
+// is also backed by inline storage. So the common request needs only
+// the one allocation of the arena itself.
+//
+// An object in the arena is usually shared by creating a shared_ptr
+// that aliases the shared_ptr owning the arena, which keeps the
+// arena alive as long as the object is referenced. An object in the
+// arena must not hold such a shared_ptr to itself or to another
+// object in the same arena since that would keep the arena alive
+// forever.
+//
+// An arena is not thread-safe, all objects should be created by the
+// thread preparing the request.
+//
+class RequestArena {
+ public:
+  RequestArena();
+  ~RequestArena();
+
+  // Allocate 'byte_size' bytes aligned to 'alignment', which must be
+  // a power of 2.
+  void* Allocate(size_t byte_size, size_t alignment);
+
+  // Arrange for 'obj', which must have been constructed in memory
+  // returned by Allocate(), to be destroyed with the arena.
+  template <typename T>
+  void Own(T* obj)
+  {
+    Cleanup* cleanup =
+        static_cast<Cleanup*>(Allocate(sizeof(Cleanup), alignof(Cleanup)));
+    cleanup->destroy_ = [](void* p) { static_cast<T*>(p)->~T(); };
+    cleanup->obj_ = obj;
+    cleanup->next_ = cleanups_;
+    cleanups_ = cleanup;
+  }
+
+  // Construct a T in the arena.
+  template <typename T, typename... Args>
+  T* New(Args&&... args)
+  {
+    void* mem = Allocate(sizeof(T), alignof(T));
+    T* obj = new (mem) T(std::forward<Args>(args)...);
+    Own(obj);
+    return obj;
+  }
+
+  // Construct a T in 'arena' and return a shared_ptr to it that
+  // keeps the arena alive. If 'arena' is nullptr the T is allocated on
+  // the heap. A class with a non-public constructor can be created
+  // this way by befriending RequestArena.
+  template <typename T, typename... Args>
+  static std::shared_ptr<T> MakeShared(
+      const std::shared_ptr<RequestArena>& arena, Args&&... args)
+  {
+    if (arena == nullptr) {
+      return std::shared_ptr<T>(new T(std::forward<Args>(args)...));
+    }
+
+    T* obj = arena->New<T>(std::forward<Args>(args)...);
+    return std::shared_ptr<T>(arena, obj);
+  }
+
+  // Return a shared_ptr to 'obj', an object in the arena, that does
+  // not keep the arena alive. It is for sharing 'obj' with other
+  // objects in the same arena, which cannot outlive it.
+  template <typename T>
+  static std::shared_ptr<T> Borrow(T* obj)
+  {
+    return std::shared_ptr<T>(std::shared_ptr<T>(), obj);
+  }
+
+  // Create a protobuf message in the arena.
+  template <typename T>
+  T* NewMessage()
+  {
+    return google::protobuf::Arena::CreateMessage<T>(&proto_arena_);
+  }
+
+  // Return the number of heap allocations made by the arena because
+  // its inline storage was exhausted.
+  size_t OverflowBlockCount() const { return overflow_block_cnt_; }
+
+ private:
+  struct Cleanup {
+    void (*destroy_)(void*);
+    void* obj_;
+    Cleanup* next_;
+  };
+
+  struct Block {
+    Block* next_;
+    size_t byte_size_;
+  };
+
+  static constexpr size_t kInlineByteSize = 4096;
+  static constexpr size_t kProtoInlineByteSize = 2048;
+
+  alignas(std::max_align_t) char inline_block_[kInlineByteSize];
+  alignas(std::max_align_t) char proto_inline_block_[kProtoInlineByteSize];
+
+  char* next_;
+  char* end_;
+  Block* blocks_;
+  size_t overflow_block_cnt_;
+  Cleanup* cleanups_;
+
+  google::protobuf::Arena proto_arena_;
+};
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,90 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/request_coalescer.h"
+
+#include "src/core/provider.h"
+
+namespace nvidia { namespace inferenceserver {
+
+bool
+RequestCoalescer::Join(
+    const RequestKey& key,
+    const std::shared_ptr<InferResponseProvider>& response_provider,
+    std::function<void(Status)> OnComplete)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto itr = inflight_.find(key);
+  if (itr == inflight_.end()) {
+    inflight_.emplace(key, std::vector<Waiter>());
+    return false;
+  }
+
+  itr->second.emplace_back(Waiter{response_provider, std::move(OnComplete)});
+  return true;
+}
+
+void
+RequestCoalescer::Complete(
+    const RequestKey& key, const Status& status,
+    const InferResponseProvider& provider)
+{
+  std::vector<Waiter> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto itr = inflight_.find(key);
+    if (itr == inflight_.end()) {
+      return;
+    }
+
+    waiters.swap(itr->second);
+    inflight_.erase(itr);
+  }
+
+  // Each waiter gets its own copy of the outputs since each response
+  // provider owns the buffers that are returned to its client.
+  for (auto& waiter : waiters) {
+    Status waiter_status = status;
+    if (waiter_status.IsOk()) {
+      for (const auto& output : provider.Outputs()) {
+        void* content;
+        waiter_status = waiter.response_provider_->AllocateOutputBuffer(
+            output.name_, &content, output.byte_size_, output.shape_);
+        if (!waiter_status.IsOk()) {
+          break;
+        }
+        if ((content != nullptr) && (output.byte_size_ > 0)) {
+          memcpy(content, output.ptr_, output.byte_size_);
+        }
+      }
+    }
+
+    waiter.OnComplete_(waiter_status);
+  }
+}
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,88 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "src/core/constants.h"
+#include "src/core/request_key.h"
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+class InferResponseProvider;
+
+//
+// Coalesce identical inference requests that are in flight at the
+// same time. The first request for a key executes normally and
+// identical requests that arrive before it completes wait for it and
+// receive a copy of its response, without taking a slot in the
+// scheduler.
+//
+class RequestCoalescer {
+ public:
+  RequestCoalescer() = default;
+
+  // Attach a request to the in-flight request with the same
+  // 'key'. If there is one, return true and respond to
+  // 'response_provider' and call 'OnComplete' when the in-flight
+  // request completes. Otherwise return false, in which case the
+  // request becomes the in-flight request for 'key' and the caller
+  // must execute it and then call Complete().
+  bool Join(
+      const RequestKey& key,
+      const std::shared_ptr<InferResponseProvider>& response_provider,
+      std::function<void(Status)> OnComplete);
+
+  // Complete the in-flight request for 'key' that produced 'status'
+  // and, if successful, the response held by 'provider'. The response
+  // is copied to every request waiting on 'key'. Must be called
+  // before the outputs of 'provider' are released.
+  void Complete(
+      const RequestKey& key, const Status& status,
+      const InferResponseProvider& provider);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(RequestCoalescer);
+
+  struct Waiter {
+    std::shared_ptr<InferResponseProvider> response_provider_;
+    std::function<void(Status)> OnComplete_;
+  };
+
+  std::mutex mu_;
+
+  // Map from the key of each in-flight request to the requests
+  // waiting for it. A request joins only if its key, including the
+  // input bytes, is equal to the in-flight request's.
+  std::unordered_map<RequestKey, std::vector<Waiter>, RequestKeyHash>
+      inflight_;
+};
+
+}}  // namespace nvidia::inferenceserver
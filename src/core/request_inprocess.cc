@@ -274,7 +274,8 @@ class InferInProcessRequestImpl : public RequestImpl {
   RequestStatus* MutableRequestStatus() { return &request_status_; }
 
   Error CreateResponseProvider(
-      const InferRequestHeader& request_header,
+      const std::shared_ptr<const InferRequestHeader>& request_header,
+      const RequestOrdinals& ordinals,
       const std::shared_ptr<LabelProvider>& label_provider,
       std::shared_ptr<DelegatingInferResponseProvider>* response_provider);
 
@@ -305,7 +306,8 @@ class InferInProcessRequestImpl : public RequestImpl {
 
 Error
 InferInProcessRequestImpl::CreateResponseProvider(
-    const InferRequestHeader& request_header,
+    const std::shared_ptr<const InferRequestHeader>& request_header,
+    const RequestOrdinals& ordinals,
     const std::shared_ptr<LabelProvider>& label_provider,
     std::shared_ptr<DelegatingInferResponseProvider>* response_provider)
 {
@@ -316,7 +318,7 @@ InferInProcessRequestImpl::CreateResponseProvider(
   }
 
   RETURN_IF_STATUS_ERROR(DelegatingInferResponseProvider::Create(
-      request_header, label_provider, &response_provider_));
+      request_header, ordinals, label_provider, &response_provider_));
 
   *response_provider = response_provider_;
   return Error::Success;
@@ -372,9 +374,7 @@ class InferInProcessContextImpl : public InferContextImpl {
   Error AsyncInfer(
       std::shared_ptr<InferInProcessRequestImpl> request,
       std::function<void()> OnCompleteInfer);
-  Status InferRequestToInputMap(
-      std::unordered_map<std::string, std::shared_ptr<SystemMemory>>* input_map)
-      const;
+  Status InferRequestToInputMap(InputMemoryList* input_map) const;
   Error GetResults(
       const InferInProcessRequestImpl& request,
       InferContext::ResultMap* results) const;
@@ -412,13 +412,11 @@ InferInProcessContextImpl::InitInProcess(
 
 Status
 InferInProcessContextImpl::InferRequestToInputMap(
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>>* input_map)
-    const
+    InputMemoryList* input_map) const
 {
   for (const auto& input : inputs_) {
     auto memory_ref = std::make_shared<SystemMemoryReference>();
-    input_map->emplace(std::make_pair(
-        input->Name(), std::static_pointer_cast<SystemMemory>(memory_ref)));
+    input_map->emplace_back(std::static_pointer_cast<SystemMemory>(memory_ref));
 
     InputImpl* input_impl = reinterpret_cast<InputImpl*>(input.get());
 
@@ -474,21 +472,26 @@ InferInProcessContextImpl::AsyncInfer(
     }
   }
 
-  RETURN_IF_STATUS_ERROR(
-      NormalizeRequestHeader(*backend->GetInferenceBackend(), infer_request_));
+  RequestOrdinals ordinals;
+  RETURN_IF_STATUS_ERROR(NormalizeRequestHeader(
+      *backend->GetInferenceBackend(), infer_request_, &ordinals));
 
-  std::unordered_map<std::string, std::shared_ptr<SystemMemory>> input_map;
+  InputMemoryList input_map;
   RETURN_IF_STATUS_ERROR(InferRequestToInputMap(&input_map));
 
+  // 'infer_request_' is reused by the next request so the providers
+  // share a copy of it.
+  auto request_header = std::make_shared<InferRequestHeader>(infer_request_);
+
   std::shared_ptr<InferRequestProvider> request_provider;
   RETURN_IF_STATUS_ERROR(InferRequestProvider::Create(
-      model_name_, model_version_, infer_request_, input_map,
+      model_name_, model_version_, request_header, ordinals, input_map,
       &request_provider));
 
   std::shared_ptr<DelegatingInferResponseProvider> response_provider;
   Error err = request->CreateResponseProvider(
-      infer_request_, backend->GetInferenceBackend()->GetLabelProvider(),
-      &response_provider);
+      request_header, ordinals,
+      backend->GetInferenceBackend()->GetLabelProvider(), &response_provider);
   if (!err.IsOk()) {
     return err;
   }
@@ -0,0 +1,121 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/request_key.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "src/core/provider.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+// The seed for request key fingerprints, chosen randomly once per
+// process.
+uint64_t
+KeySeed()
+{
+  static const uint64_t seed = []() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }();
+  return seed;
+}
+
+template <typename T>
+void
+AppendValue(std::string* content, const T& value)
+{
+  content->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+Status
+RequestKey::Create(InferRequestProvider& provider, RequestKey* key)
+{
+  const InferRequestHeader& request_header = provider.RequestHeader();
+  const RequestOrdinals& ordinals = provider.Ordinals();
+
+  size_t input_byte_size = 0;
+  for (const auto& input : request_header.input()) {
+    input_byte_size += input.batch_byte_size();
+  }
+
+  auto content = std::make_shared<std::string>();
+  content->reserve(input_byte_size + 256);
+
+  AppendValue<uint32_t>(content.get(), request_header.batch_size());
+  AppendValue<uint32_t>(content.get(), request_header.flags());
+  AppendValue<uint32_t>(content.get(), request_header.string_encoding());
+
+  // Visit the inputs and outputs in model configuration order so
+  // that the key doesn't depend on the order of the request header.
+  std::vector<uint32_t> input_ordinals(ordinals.inputs_);
+  std::sort(input_ordinals.begin(), input_ordinals.end());
+  for (const uint32_t ordinal : input_ordinals) {
+    const InferRequestHeader::Input* input = provider.RequestInput(ordinal);
+    AppendValue<uint32_t>(content.get(), ordinal);
+    AppendValue<uint64_t>(content.get(), input->batch_byte_size());
+    AppendValue<uint32_t>(content.get(), input->dims_size());
+    for (const auto dim : input->dims()) {
+      AppendValue<int64_t>(content.get(), dim);
+    }
+
+    std::shared_ptr<SystemMemory> memory;
+    RETURN_IF_ERROR(provider.GetSystemMemory(input->name(), &memory));
+
+    size_t idx = 0;
+    size_t byte_size;
+    const char* block;
+    while ((block = memory->BufferAt(idx++, &byte_size)) != nullptr) {
+      content->append(block, byte_size);
+    }
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> outputs;
+  for (int i = 0; i < request_header.output_size(); ++i) {
+    const auto& output = request_header.output(i);
+    outputs.emplace_back(
+        ordinals.outputs_[i], output.has_cls() ? output.cls().count() : 0);
+  }
+  std::sort(outputs.begin(), outputs.end());
+  for (const auto& output : outputs) {
+    AppendValue<uint32_t>(content.get(), output.first);
+    AppendValue<uint32_t>(content.get(), output.second);
+  }
+
+  Fingerprinter fp(KeySeed());
+  fp.Update(content->data(), content->size());
+  key->fingerprint_ = fp.Finish();
+  key->content_ = std::move(content);
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,89 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include <string>
+#include "src/core/fingerprint.h"
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+class InferRequestProvider;
+
+//
+// The identity of a normalized inference request, used to find
+// requests that must produce identical responses. A key holds a copy
+// of the request meta-data and input bytes that determine the
+// response, and two keys are equal only if those bytes are equal, so
+// a fingerprint collision can never match different requests. The
+// fingerprint is only used to find candidates and is seeded randomly
+// in each process so that colliding requests can't be constructed in
+// advance.
+//
+class RequestKey {
+ public:
+  RequestKey() = default;
+
+  // Create the key for a normalized request. The key covers the batch
+  // size, flags, the shape and content of every input and the
+  // requested outputs, but not the request ID, so identical requests
+  // from different clients have equal keys.
+  static Status Create(InferRequestProvider& provider, RequestKey* key);
+
+  // The fingerprint of the key contents.
+  const Fingerprint& Hash() const { return fingerprint_; }
+
+  // The number of bytes held by the key.
+  size_t ByteSize() const
+  {
+    return (content_ == nullptr) ? 0 : content_->size();
+  }
+
+  bool operator==(const RequestKey& o) const
+  {
+    return (fingerprint_ == o.fingerprint_) &&
+           ((content_ == o.content_) ||
+            ((content_ != nullptr) && (o.content_ != nullptr) &&
+             (*content_ == *o.content_)));
+  }
+  bool operator!=(const RequestKey& o) const { return !(*this == o); }
+
+ private:
+  Fingerprint fingerprint_;
+
+  // Copies of a key share the contents.
+  std::shared_ptr<const std::string> content_;
+};
+
+// Hash functor so that a RequestKey can be used as the key of an
+// unordered container.
+struct RequestKeyHash {
+  size_t operator()(const RequestKey& key) const { return key.Hash().lo_; }
+};
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,158 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/response_cache.h"
+
+#include <time.h>
+#include "src/core/constants.h"
+#include "src/core/logging.h"
+#include "src/core/metric_model_reporter.h"
+#include "src/core/provider.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+uint64_t
+MonotonicNs()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * NANOS_PER_SECOND + now.tv_nsec;
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(
+    const ModelResponseCache& config,
+    const std::shared_ptr<MetricModelReporter>& metric_reporter)
+    : max_byte_size_(config.max_byte_size()),
+      ttl_ns_(config.ttl_microseconds() * 1000),
+      hit_counter_(metric_reporter->MetricCacheHit(-1)),
+      miss_counter_(metric_reporter->MetricCacheMiss(-1)),
+      eviction_counter_(metric_reporter->MetricCacheEviction(-1)),
+      byte_size_(0)
+{
+}
+
+bool
+ResponseCache::Lookup(
+    const RequestKey& key, std::shared_ptr<const Response>* response)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto itr = entries_.find(key);
+  if (itr != entries_.end()) {
+    if ((ttl_ns_ == 0) || (MonotonicNs() < itr->second.expire_ns_)) {
+      lru_.splice(lru_.begin(), lru_, itr->second.lru_itr_);
+      *response = itr->second.response_;
+      hit_counter_.Increment();
+      return true;
+    }
+
+    Evict(itr);
+  }
+
+  miss_counter_.Increment();
+  return false;
+}
+
+void
+ResponseCache::Insert(
+    const RequestKey& key, const InferResponseProvider& provider)
+{
+  // Copy the outputs before taking the lock so that large responses
+  // don't block lookups. The entry's size includes the key since the
+  // entry holds a copy of the request inputs.
+  auto response = std::make_shared<Response>();
+  response->byte_size_ = sizeof(Response) + key.ByteSize();
+  for (const auto& output : provider.Outputs()) {
+    response->outputs_.emplace_back();
+    Response::Output& cached = response->outputs_.back();
+    cached.name_ = output.name_;
+    cached.shape_ = output.shape_;
+    if (output.byte_size_ > 0) {
+      cached.content_.assign(
+          static_cast<const char*>(output.ptr_), output.byte_size_);
+    }
+
+    response->byte_size_ += sizeof(Response::Output) + cached.name_.size() +
+                            (cached.shape_.size() * sizeof(int64_t)) +
+                            cached.content_.size();
+  }
+
+  if (response->byte_size_ > max_byte_size_) {
+    LOG_VERBOSE(1) << "response of " << response->byte_size_
+                   << " bytes exceeds response cache size";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+
+  // An identical request may have completed while this one was
+  // executing, if so keep the existing entry.
+  if (entries_.find(key) != entries_.end()) {
+    return;
+  }
+
+  while ((byte_size_ + response->byte_size_) > max_byte_size_) {
+    Evict(entries_.find(lru_.back()));
+  }
+
+  lru_.push_front(key);
+  Entry& entry = entries_[key];
+  entry.response_ = std::move(response);
+  entry.lru_itr_ = lru_.begin();
+  entry.expire_ns_ = (ttl_ns_ == 0) ? 0 : MonotonicNs() + ttl_ns_;
+  byte_size_ += entry.response_->byte_size_;
+}
+
+void
+ResponseCache::Evict(EntryMap::iterator itr)
+{
+  byte_size_ -= itr->second.response_->byte_size_;
+  lru_.erase(itr->second.lru_itr_);
+  entries_.erase(itr);
+  eviction_counter_.Increment();
+}
+
+Status
+ResponseCache::Respond(
+    const Response& response, InferResponseProvider* provider)
+{
+  for (const auto& output : response.outputs_) {
+    void* content;
+    RETURN_IF_ERROR(provider->AllocateOutputBuffer(
+        output.name_, &content, output.content_.size(), output.shape_));
+    if ((content != nullptr) && !output.content_.empty()) {
+      memcpy(content, output.content_.data(), output.content_.size());
+    }
+  }
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
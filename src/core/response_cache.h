@@ -0,0 +1,113 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "prometheus/registry.h"
+#include "src/core/model_config.pb.h"
+#include "src/core/request_key.h"
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+class InferResponseProvider;
+class MetricModelReporter;
+
+//
+// Cache of the responses of a model, keyed by the request meta-data
+// and input tensors. Responses are evicted in
+// least-recently-used order to keep the cache within a byte budget,
+// and optionally expire after a fixed time.
+//
+class ResponseCache {
+ public:
+  // The outputs of a cached response.
+  struct Response {
+    struct Output {
+      std::string name_;
+      std::vector<int64_t> shape_;
+      std::string content_;
+    };
+
+    std::vector<Output> outputs_;
+    size_t byte_size_;
+  };
+
+  ResponseCache(
+      const ModelResponseCache& config,
+      const std::shared_ptr<MetricModelReporter>& metric_reporter);
+
+  // Look up the response for 'key'. Return true and set 'response'
+  // if found, return false if not found or expired.
+  bool Lookup(
+      const RequestKey& key, std::shared_ptr<const Response>* response);
+
+  // Add the response held by 'provider' to the cache for
+  // 'key'. Must be called after the outputs of the response are
+  // complete and before they are released.
+  void Insert(const RequestKey& key, const InferResponseProvider& provider);
+
+  // Write a cached 'response' to 'provider' as if it was produced by
+  // the model.
+  static Status Respond(
+      const Response& response, InferResponseProvider* provider);
+
+ private:
+  struct Entry {
+    std::shared_ptr<const Response> response_;
+    std::list<RequestKey>::iterator lru_itr_;
+    uint64_t expire_ns_;
+  };
+
+  using EntryMap = std::unordered_map<RequestKey, Entry, RequestKeyHash>;
+
+  // Remove an entry. Must be called with 'mu_' held.
+  void Evict(EntryMap::iterator itr);
+
+  const uint64_t max_byte_size_;
+  const uint64_t ttl_ns_;
+
+  prometheus::Counter& hit_counter_;
+  prometheus::Counter& miss_counter_;
+  prometheus::Counter& eviction_counter_;
+
+  std::mutex mu_;
+  EntryMap entries_;
+
+  // Keys ordered from most to least recently used.
+  std::list<RequestKey> lru_;
+
+  // Bytes of all cached responses.
+  uint64_t byte_size_;
+};
+
+}}  // namespace nvidia::inferenceserver
@@ -100,6 +100,14 @@ class Scheduler {
       const std::shared_ptr<InferRequestProvider>& request_provider,
       const std::shared_ptr<InferResponseProvider>& response_provider,
       std::function<void(Status)> OnComplete) = 0;
+
+  // Mark the beginning and end of a group of requests that are
+  // enqueued together, for example the requests of a multi-infer
+  // request. A scheduler that batches requests can use the end of a
+  // group as a signal to schedule the requests it is holding instead
+  // of waiting for more. Groups may overlap.
+  virtual void BeginEnqueueGroup() {}
+  virtual void EndEnqueueGroup() {}
 };
 
 }}  // namespace nvidia::inferenceserver
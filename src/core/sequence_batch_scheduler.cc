@@ -608,9 +608,12 @@ SequenceBatchScheduler::SequenceBatch::Enqueue(
     // then grab a copy of the request header that is needed to create
     // NULL version request providers that can stand in as
     // representative when inference is issuing and there is no
-    // request available in one or more slots.
+    // request available in one or more slots. The copy is shared by
+    // all the NULL providers.
     if ((max_active_slot_ == -1) && (request_provider != nullptr)) {
-      null_request_header_ = request_provider->RequestHeader();
+      null_request_header_ = std::make_shared<InferRequestHeader>(
+          request_provider->RequestHeader());
+      null_request_ordinals_ = request_provider->Ordinals();
     }
 
     queues_[slot].emplace_back(
@@ -732,7 +735,7 @@ SequenceBatchScheduler::SequenceBatch::SchedulerThread(const int nice)
             if (use_null_provider) {
               auto null_request_provider =
                   std::make_shared<NULLInferRequestProvider>(
-                      null_request_header_);
+                      null_request_header_, null_request_ordinals_);
               null_request_provider->SetInputOverride(
                   notready_input_overrides_);
 
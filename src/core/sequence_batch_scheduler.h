@@ -143,10 +143,12 @@ class SequenceBatchScheduler : public Scheduler {
     std::mutex mu_;
     std::condition_variable cv_;
 
-    // The request header needed to create a null provider to use when
-    // an inference is issuing and there is no request available in a
-    // slot.
-    InferRequestHeader null_request_header_;
+    // The request header, and the model configuration ordinals of
+    // its inputs and outputs, needed to create a null provider to use
+    // when an inference is issuing and there is no request available
+    // in a slot.
+    std::shared_ptr<const InferRequestHeader> null_request_header_;
+    RequestOrdinals null_request_ordinals_;
 
     // Queues holding inference requests. There are 'batch_size'
     // queues, one for each batch slot where requests assigned to that
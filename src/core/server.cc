@@ -39,8 +39,10 @@
 
 #include "src/core/api.pb.h"
 #include "src/core/backend.h"
+#include "src/core/blob_store.h"
 #include "src/core/constants.h"
 #include "src/core/logging.h"
+#include "src/core/memory_pool.h"
 #include "src/core/model_config.h"
 #include "src/core/model_config.pb.h"
 #include "src/core/model_config_utils.h"
@@ -50,6 +52,7 @@
 #include "src/core/request_status.h"
 #include "src/core/server.h"
 #include "src/core/server_status.pb.h"
+#include "src/core/shared_memory_manager.h"
 #include "tensorflow/core/platform/env.h"
 
 namespace nvidia { namespace inferenceserver {
@@ -98,6 +101,13 @@ InferenceServer::InferenceServer()
   tf_soft_placement_enabled_ = true;
   tf_gpu_memory_fraction_ = 0.0;
 
+  const SystemMemoryPool::Options pool_options;
+  memory_pool_byte_size_ = pool_options.max_cached_byte_size_;
+  memory_pool_thread_cache_byte_size_ = pool_options.thread_cache_byte_size_;
+  memory_pool_huge_pages_ = pool_options.huge_pages_;
+
+  blob_store_byte_size_ = 0;
+
   inflight_request_counter_ = 0;
 
   status_manager_.reset(new ServerStatusManager(version_));
@@ -127,6 +137,14 @@ InferenceServer::Init()
     return false;
   }
 
+  // Size the tensor memory pool before any models are loaded.
+  SystemMemoryPool::Options pool_options;
+  pool_options.max_cached_byte_size_ = memory_pool_byte_size_;
+  pool_options.thread_cache_byte_size_ = memory_pool_thread_cache_byte_size_;
+  pool_options.huge_pages_ = memory_pool_huge_pages_;
+  SystemMemoryPool::Configure(pool_options);
+  BlobStore::Configure(blob_store_byte_size_);
+
   // Create the global manager for the repository. For now, all models are
   // eagerly loaded below when the manager is created.
   status = ModelRepositoryManager::Create(
@@ -358,35 +376,132 @@ InferenceServer::HandleInfer(
 }
 
 void
-InferenceServer::HandleStatus(
-    RequestStatus* request_status, ServerStatus* server_status,
-    const std::string& model_name)
+InferenceServer::HandleBlobUpload(
+    RequestStatus* request_status,
+    const std::shared_ptr<AllocatedSystemMemory>& blob, std::string* blob_key)
 {
-  if (ready_state_ == ServerReadyState::SERVER_EXITING) {
+  if (ready_state_ != ServerReadyState::SERVER_READY) {
     RequestStatusFactory::Create(
         request_status, 0, id_, RequestStatusCode::UNAVAILABLE,
-        "Server exiting");
+        "Server not ready");
+    return;
+  }
+
+  ScopedAtomicIncrement inflight(inflight_request_counter_);
+  const uint64_t request_id = NextRequestId();
+
+  RequestStatusFactory::Create(
+      request_status, request_id, id_, BlobStore::Add(blob, blob_key));
+}
+
+void
+InferenceServer::HandleRegisterSharedMemory(
+    RequestStatus* request_status, const std::string& name,
+    const std::string& shm_key, size_t offset, size_t byte_size)
+{
+  if (ready_state_ != ServerReadyState::SERVER_READY) {
+    RequestStatusFactory::Create(
+        request_status, 0, id_, RequestStatusCode::UNAVAILABLE,
+        "Server not ready");
     return;
   }
 
   ScopedAtomicIncrement inflight(inflight_request_counter_);
   const uint64_t request_id = NextRequestId();
 
+  RequestStatusFactory::Create(
+      request_status, request_id, id_,
+      SharedMemoryManager::RegisterRegion(name, shm_key, offset, byte_size));
+}
+
+void
+InferenceServer::HandleUnregisterSharedMemory(
+    RequestStatus* request_status, const std::string& name)
+{
+  if (ready_state_ != ServerReadyState::SERVER_READY) {
+    RequestStatusFactory::Create(
+        request_status, 0, id_, RequestStatusCode::UNAVAILABLE,
+        "Server not ready");
+    return;
+  }
+
+  ScopedAtomicIncrement inflight(inflight_request_counter_);
+  const uint64_t request_id = NextRequestId();
+
+  RequestStatusFactory::Create(
+      request_status, request_id, id_,
+      SharedMemoryManager::UnregisterRegion(name));
+}
+
+void
+InferenceServer::HandleUnregisterAllSharedMemory(RequestStatus* request_status)
+{
+  if (ready_state_ != ServerReadyState::SERVER_READY) {
+    RequestStatusFactory::Create(
+        request_status, 0, id_, RequestStatusCode::UNAVAILABLE,
+        "Server not ready");
+    return;
+  }
+
+  ScopedAtomicIncrement inflight(inflight_request_counter_);
+  const uint64_t request_id = NextRequestId();
+
+  RequestStatusFactory::Create(
+      request_status, request_id, id_,
+      SharedMemoryManager::UnregisterAllRegions());
+}
+
+void
+InferenceServer::HandleStatus(
+    RequestStatus* request_status, ServerStatus* server_status,
+    const std::string& model_name)
+{
+  std::shared_ptr<const ServerStatusSnapshot> snapshot;
+  ServerReadyState ready_state;
+  uint64_t uptime_ns;
+  HandleStatus(request_status, &snapshot, &ready_state, &uptime_ns);
+  if (request_status->code() != RequestStatusCode::SUCCESS) {
+    return;
+  }
+
   // If no specific model request just return the entire status
   // object.
-  if (model_name.empty()) {
+  std::vector<std::string> model_names;
+  if (!model_name.empty()) {
+    model_names.push_back(model_name);
+  }
+
+  Status status = snapshot->Filter(model_names, {} /* fields */, server_status);
+  server_status->set_ready_state(ready_state);
+  server_status->set_uptime_ns(uptime_ns);
+  if (!status.IsOk()) {
     RequestStatusFactory::Create(
-        request_status, request_id, id_,
-        status_manager_->Get(
-            server_status, id_, ready_state_, UptimeNs(),
-            model_repository_manager_.get()));
-  } else {
+        request_status, request_status->request_id(), id_, status);
+  }
+}
+
+void
+InferenceServer::HandleStatus(
+    RequestStatus* request_status,
+    std::shared_ptr<const ServerStatusSnapshot>* snapshot,
+    ServerReadyState* ready_state, uint64_t* uptime_ns)
+{
+  if (ready_state_ == ServerReadyState::SERVER_EXITING) {
     RequestStatusFactory::Create(
-        request_status, request_id, id_,
-        status_manager_->Get(
-            server_status, id_, ready_state_, UptimeNs(), model_name,
-            model_repository_manager_.get()));
+        request_status, 0, id_, RequestStatusCode::UNAVAILABLE,
+        "Server exiting");
+    return;
   }
+
+  ScopedAtomicIncrement inflight(inflight_request_counter_);
+  const uint64_t request_id = NextRequestId();
+
+  *snapshot = status_manager_->Snapshot(id_, model_repository_manager_.get());
+  *ready_state = ready_state_;
+  *uptime_ns = UptimeNs();
+
+  RequestStatusFactory::Create(
+      request_status, request_id, id_, RequestStatusCode::SUCCESS);
 }
 
 uint64_t
@@ -427,6 +542,36 @@ InferBackendHandleImpl::Init(
       model_name, model_version, &backend_handle_);
 }
 
+//
+// InferGroup
+//
+InferenceServer::InferGroup::~InferGroup()
+{
+  for (auto& backend : backends_) {
+    backend->GetInferenceBackend()->EndRunGroup();
+  }
+}
+
+void
+InferenceServer::InferGroup::AddModel(
+    const std::string& model_name, const int64_t model_version)
+{
+  std::shared_ptr<InferBackendHandle> backend;
+  if (!InferBackendHandle::Create(server_, model_name, model_version, &backend)
+           .IsOk()) {
+    return;
+  }
+
+  for (const auto& b : backends_) {
+    if (b->GetInferenceBackend() == backend->GetInferenceBackend()) {
+      return;
+    }
+  }
+
+  backend->GetInferenceBackend()->BeginRunGroup();
+  backends_.emplace_back(std::move(backend));
+}
+
 Status
 InferenceServer::InferBackendHandle::Create(
     const InferenceServer* server, const std::string& model_name,
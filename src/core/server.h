@@ -78,6 +78,27 @@ class InferenceServer {
       std::shared_ptr<ModelInferStats> infer_stats,
       std::function<void()> OnCompleteInferRPC);
 
+  // Add the tensor data in 'blob' to the blob store and return in
+  // 'blob_key' the key that inference requests use to reference it.
+  void HandleBlobUpload(
+      RequestStatus* request_status,
+      const std::shared_ptr<AllocatedSystemMemory>& blob,
+      std::string* blob_key);
+
+  // Register a shared-memory region called 'name' that covers
+  // 'byte_size' bytes starting at 'offset' within the shared-memory
+  // object 'shm_key'.
+  void HandleRegisterSharedMemory(
+      RequestStatus* request_status, const std::string& name,
+      const std::string& shm_key, size_t offset, size_t byte_size);
+
+  // Unregister the shared-memory region called 'name'.
+  void HandleUnregisterSharedMemory(
+      RequestStatus* request_status, const std::string& name);
+
+  // Unregister all shared-memory regions.
+  void HandleUnregisterAllSharedMemory(RequestStatus* request_status);
+
   // Update the RequestStatus object and ServerStatus object with the
   // status of the model. If 'model_name' is empty, update with the
   // status of all models.
@@ -85,6 +106,14 @@ class InferenceServer {
       RequestStatus* request_status, ServerStatus* server_status,
       const std::string& model_name);
 
+  // Update the RequestStatus object and return the current snapshot
+  // of the server status along with the ready state and uptime of the
+  // server, which are not part of the snapshot.
+  void HandleStatus(
+      RequestStatus* request_status,
+      std::shared_ptr<const ServerStatusSnapshot>* snapshot,
+      ServerReadyState* ready_state, uint64_t* uptime_ns);
+
   // Return the ready state for the server.
   ServerReadyState ReadyState() const { return ready_state_; }
 
@@ -134,6 +163,43 @@ class InferenceServer {
   float TensorFlowGPUMemoryFraction() const { return tf_gpu_memory_fraction_; }
   void SetTensorFlowGPUMemoryFraction(float f) { tf_gpu_memory_fraction_ = f; }
 
+  // Get / set the maximum number of bytes cached by the tensor
+  // memory pool. Zero disables pooling.
+  size_t MemoryPoolByteSize() const { return memory_pool_byte_size_; }
+  void SetMemoryPoolByteSize(size_t s) { memory_pool_byte_size_ = s; }
+
+  // Get / set the maximum number of bytes cached by each thread for
+  // the tensor memory pool.
+  size_t MemoryPoolThreadCacheByteSize() const
+  {
+    return memory_pool_thread_cache_byte_size_;
+  }
+  void SetMemoryPoolThreadCacheByteSize(size_t s)
+  {
+    memory_pool_thread_cache_byte_size_ = s;
+  }
+
+  // Get / set if large tensor memory pool buffers should use huge
+  // pages.
+  bool MemoryPoolHugePagesEnabled() const { return memory_pool_huge_pages_; }
+  void SetMemoryPoolHugePagesEnabled(bool e) { memory_pool_huge_pages_ = e; }
+
+  // Get / set the maximum number of bytes held by the input blob
+  // store. Zero disables the blob store.
+  size_t BlobStoreByteSize() const { return blob_store_byte_size_; }
+  void SetBlobStoreByteSize(size_t s) { blob_store_byte_size_ = s; }
+
+  // Get / set the minimum interval between server status snapshots,
+  // in milliseconds.
+  uint64_t StatusSnapshotIntervalMs() const
+  {
+    return status_manager_->SnapshotIntervalMs();
+  }
+  void SetStatusSnapshotIntervalMs(uint64_t ms)
+  {
+    status_manager_->SetSnapshotIntervalMs(ms);
+  }
+
   // Return the status manager for this server.
   std::shared_ptr<ServerStatusManager> StatusManager() const
   {
@@ -157,6 +223,25 @@ class InferenceServer {
     virtual InferenceBackend* GetInferenceBackend() = 0;
   };
 
+  // A group of inference requests that are issued together, for
+  // example the requests of a multi-infer request. When the group is
+  // destroyed the models used by the group schedule the requests
+  // they are holding for a dynamic batch without waiting for the rest
+  // of their queuing delay.
+  class InferGroup {
+   public:
+    explicit InferGroup(const InferenceServer* server) : server_(server) {}
+    ~InferGroup();
+
+    // Add the model used by a request of the group. An unavailable
+    // model is ignored, the request itself reports the error.
+    void AddModel(const std::string& model_name, const int64_t model_version);
+
+   private:
+    const InferenceServer* server_;
+    std::vector<std::shared_ptr<InferBackendHandle>> backends_;
+  };
+
  private:
   // Return the uptime of the server in nanoseconds.
   uint64_t UptimeNs() const;
@@ -178,6 +263,12 @@ class InferenceServer {
   bool tf_soft_placement_enabled_;
   float tf_gpu_memory_fraction_;
 
+  size_t memory_pool_byte_size_;
+  size_t memory_pool_thread_cache_byte_size_;
+  bool memory_pool_huge_pages_;
+
+  size_t blob_store_byte_size_;
+
   // Current state of the inference server.
   ServerReadyState ready_state_;
 
@@ -64,7 +64,88 @@ SetModelVersionReadyState(
 
 }  // namespace
 
+ServerStatusSnapshot::ServerStatusSnapshot(std::unique_ptr<ServerStatus> status)
+    : status_(std::move(status))
+{
+}
+
+const std::string&
+ServerStatusSnapshot::Serialized() const
+{
+  std::call_once(
+      serialized_once_, [this]() { status_->SerializeToString(&serialized_); });
+  return serialized_;
+}
+
+const std::string&
+ServerStatusSnapshot::DebugString() const
+{
+  std::call_once(
+      debug_string_once_, [this]() { debug_string_ = status_->DebugString(); });
+  return debug_string_;
+}
+
+Status
+ServerStatusSnapshot::Filter(
+    const std::vector<std::string>& model_names,
+    const std::vector<std::string>& fields, ServerStatus* server_status) const
+{
+  bool config = fields.empty();
+  bool version_status = fields.empty();
+  for (const auto& field : fields) {
+    if (field == "config") {
+      config = true;
+    } else if (field == "version_status") {
+      version_status = true;
+    } else {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "unknown model status field '" + field + "'");
+    }
+  }
+
+  server_status->Clear();
+  server_status->set_id(status_->id());
+  server_status->set_version(status_->version());
+  server_status->mutable_status_stats()->CopyFrom(status_->status_stats());
+  server_status->mutable_profile_stats()->CopyFrom(status_->profile_stats());
+  server_status->mutable_health_stats()->CopyFrom(status_->health_stats());
+  server_status->set_generation(status_->generation());
+
+  auto& ms = *server_status->mutable_model_status();
+  auto CopyModelStatus = [&](const ModelStatus& src, ModelStatus* dst) {
+    if (config) {
+      dst->mutable_config()->CopyFrom(src.config());
+    }
+    if (version_status) {
+      *dst->mutable_version_status() = src.version_status();
+    }
+  };
+
+  if (model_names.empty()) {
+    for (const auto& itr : status_->model_status()) {
+      CopyModelStatus(itr.second, &ms[itr.first]);
+    }
+  } else {
+    for (const auto& model_name : model_names) {
+      const auto& itr = status_->model_status().find(model_name);
+      if (itr == status_->model_status().end()) {
+        return Status(
+            RequestStatusCode::INVALID_ARG,
+            "no status available for unknown model '" + model_name + "'");
+      }
+
+      CopyModelStatus(itr->second, &ms[model_name]);
+    }
+  }
+
+  return Status::Success;
+}
+
 ServerStatusManager::ServerStatusManager(const std::string& server_version)
+    : update_cnt_(0), model_update_cnt_(0), snapshot_update_cnt_(0),
+      snapshot_model_update_cnt_(0), snapshot_ns_(0),
+      snapshot_interval_ns_(STATUS_SNAPSHOT_DEFAULT_INTERVAL_MS * 1000 * 1000)
 {
   const auto& version = server_version;
   if (!version.empty()) {
@@ -77,6 +158,8 @@ ServerStatusManager::InitForModel(
     const std::string& model_name, const ModelConfig& model_config)
 {
   std::lock_guard<std::mutex> lock(mu_);
+  update_cnt_++;
+  model_update_cnt_++;
 
   auto& ms = *server_status_.mutable_model_status();
   if (ms.find(model_name) == ms.end()) {
@@ -96,6 +179,8 @@ ServerStatusManager::UpdateConfigForModel(
     const std::string& model_name, const ModelConfig& model_config)
 {
   std::lock_guard<std::mutex> lock(mu_);
+  update_cnt_++;
+  model_update_cnt_++;
 
   auto& ms = *server_status_.mutable_model_status();
   if (ms.find(model_name) == ms.end()) {
@@ -159,10 +244,111 @@ ServerStatusManager::Get(
   return Status::Success;
 }
 
+std::shared_ptr<const ServerStatusSnapshot>
+ServerStatusManager::Snapshot(
+    const std::string& server_id,
+    ModelRepositoryManager* model_repository_manager)
+{
+  std::lock_guard<std::mutex> snapshot_lock(snapshot_mu_);
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  const uint64_t now_ns = now.tv_sec * NANOS_PER_SECOND + now.tv_nsec;
+
+  // Copy the live status if models were added or reconfigured since
+  // the last snapshot, or if the inference statistics changed and the
+  // snapshot is older than the interval. So statistics may be
+  // out-of-date by up to the interval but changes to the models are
+  // not.
+  std::unique_ptr<ServerStatus> status;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if ((snapshot_ == nullptr) ||
+        (model_update_cnt_ != snapshot_model_update_cnt_) ||
+        ((update_cnt_ != snapshot_update_cnt_) &&
+         ((now_ns - snapshot_ns_) >= snapshot_interval_ns_))) {
+      status.reset(new ServerStatus(server_status_));
+      snapshot_update_cnt_ = update_cnt_;
+      snapshot_model_update_cnt_ = model_update_cnt_;
+      snapshot_ns_ = now_ns;
+    }
+  }
+
+  // Otherwise the snapshot is still current unless the ready state
+  // of a model version changed.
+  if (status == nullptr) {
+    if ((snapshot_->Get().id() == server_id) &&
+        !ReadyStatesChanged(snapshot_->Get(), model_repository_manager)) {
+      return snapshot_;
+    }
+
+    status.reset(new ServerStatus(snapshot_->Get()));
+  }
+
+  status->set_id(server_id);
+  status->set_generation(
+      (snapshot_ == nullptr) ? 1 : snapshot_->Generation() + 1);
+  for (auto& msitr : *status->mutable_model_status()) {
+    SetModelVersionReadyState(msitr.second, model_repository_manager);
+  }
+
+  snapshot_.reset(new ServerStatusSnapshot(std::move(status)));
+  return snapshot_;
+}
+
+bool
+ServerStatusManager::ReadyStatesChanged(
+    const ServerStatus& server_status,
+    ModelRepositoryManager* model_repository_manager)
+{
+  // Same as SetModelVersionReadyState(), versions not being served
+  // are unavailable.
+  for (const auto& msitr : server_status.model_status()) {
+    const auto& mvs = msitr.second.version_status();
+    const auto versions_and_states = model_repository_manager->GetVersionStates(
+        msitr.second.config().name());
+    for (const auto& version_and_state : versions_and_states) {
+      if (mvs.find(version_and_state.first) == mvs.end()) {
+        return true;
+      }
+    }
+
+    for (const auto& itr : mvs) {
+      const auto state_itr = versions_and_states.find(itr.first);
+      const ModelReadyState state = (state_itr == versions_and_states.end())
+                                        ? ModelReadyState::MODEL_UNAVAILABLE
+                                        : state_itr->second;
+      if (itr.second.ready_state() != state) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+uint64_t
+ServerStatusManager::SnapshotIntervalMs() const
+{
+  std::lock_guard<std::mutex> snapshot_lock(snapshot_mu_);
+  return snapshot_interval_ns_ / (1000 * 1000);
+}
+
+void
+ServerStatusManager::SetSnapshotIntervalMs(uint64_t ms)
+{
+  std::lock_guard<std::mutex> snapshot_lock(snapshot_mu_);
+  snapshot_interval_ns_ = ms * 1000 * 1000;
+}
+
 void
 ServerStatusManager::UpdateServerStat(
     uint64_t duration, ServerStatTimerScoped::Kind kind)
 {
+  // The server's own request statistics are not part of what a
+  // generation identifies, otherwise every status request, which
+  // records one, would replace the snapshot for the next. They are
+  // updated in the snapshot when it is replaced for another change.
   std::lock_guard<std::mutex> lock(mu_);
 
   switch (kind) {
@@ -198,6 +384,7 @@ ServerStatusManager::UpdateFailedInferStats(
     size_t batch_size, uint64_t request_duration_ns)
 {
   std::lock_guard<std::mutex> lock(mu_);
+  update_cnt_++;
 
   // Model must exist...
   auto itr = server_status_.mutable_model_status()->find(model_name);
@@ -241,6 +428,7 @@ ServerStatusManager::UpdateSuccessInferStats(
     uint64_t queue_duration_ns, uint64_t compute_duration_ns)
 {
   std::lock_guard<std::mutex> lock(mu_);
+  update_cnt_++;
 
   // Model must exist...
   auto itr = server_status_.mutable_model_status()->find(model_name);
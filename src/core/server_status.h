@@ -26,7 +26,10 @@
 #pragma once
 
 #include <time.h>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 #include "src/core/model_config.pb.h"
 #include "src/core/model_repository_manager.h"
 #include "src/core/server_status.pb.h"
@@ -168,6 +171,43 @@ class ModelInferStats {
   mutable uint64_t compute_duration_ns_;
 };
 
+// An immutable snapshot of the server status. A snapshot is shared by
+// all the status requests made while it is current so that they
+// neither copy nor lock the live status.
+class ServerStatusSnapshot {
+ public:
+  explicit ServerStatusSnapshot(std::unique_ptr<ServerStatus> status);
+
+  // The generation of the snapshot.
+  uint64_t Generation() const { return status_->generation(); }
+
+  // The status of the server and all models. The server ready state
+  // and uptime are not set since they change independently of the
+  // snapshot.
+  const ServerStatus& Get() const { return *status_; }
+
+  // The status serialized in binary and in text format. Each is
+  // produced once, when first requested.
+  const std::string& Serialized() const;
+  const std::string& DebugString() const;
+
+  // Copy into 'server_status' the status of the models in
+  // 'model_names', or of all models if empty, holding only the
+  // ModelStatus 'fields' ("config" and/or "version_status"), or all
+  // fields if empty.
+  Status Filter(
+      const std::vector<std::string>& model_names,
+      const std::vector<std::string>& fields,
+      ServerStatus* server_status) const;
+
+ private:
+  const std::unique_ptr<const ServerStatus> status_;
+  mutable std::once_flag serialized_once_;
+  mutable std::string serialized_;
+  mutable std::once_flag debug_string_once_;
+  mutable std::string debug_string_;
+};
+
 // Manage access and updates to server status information.
 class ServerStatusManager {
  public:
@@ -195,6 +235,23 @@ class ServerStatusManager {
       const std::string& model_name,
       ModelRepositoryManager* model_repository_manager) const;
 
+  // Get a snapshot of the server status. The snapshot is replaced,
+  // with the next generation, when the status of the models has
+  // changed. Changes to the inference statistics replace it at most
+  // once every snapshot interval, so they may be up to one interval
+  // out-of-date. Added or reconfigured models and changed ready
+  // states replace it at once. The statistics of the server's own
+  // status, health and profile requests don't replace it.
+  std::shared_ptr<const ServerStatusSnapshot> Snapshot(
+      const std::string& server_id,
+      ModelRepositoryManager* model_repository_manager);
+
+  // Get / set the minimum interval between snapshots for changed
+  // statistics, in milliseconds. Zero replaces the snapshot on every
+  // request after a change.
+  uint64_t SnapshotIntervalMs() const;
+  void SetSnapshotIntervalMs(uint64_t ms);
+
   // Add a duration to the Server Stat specified by 'kind'.
   void UpdateServerStat(uint64_t duration, ServerStatTimerScoped::Kind kind);
 
@@ -210,7 +267,27 @@ class ServerStatusManager {
       uint64_t queue_duration_ns, uint64_t compute_duration_ns);
 
  private:
+  // Return true if the ready states of the model versions in
+  // 'server_status' differ from those in the model repository.
+  static bool ReadyStatesChanged(
+      const ServerStatus& server_status,
+      ModelRepositoryManager* model_repository_manager);
+
   mutable std::mutex mu_;
   ServerStatus server_status_;
+
+  // Incremented for every change to the status of the models, and
+  // for every model that is added or reconfigured.
+  uint64_t update_cnt_;
+  uint64_t model_update_cnt_;
+
+  // Protects the snapshot. Separate from 'mu_' so that status
+  // requests waiting for a snapshot don't delay stats updates.
+  mutable std::mutex snapshot_mu_;
+  std::shared_ptr<const ServerStatusSnapshot> snapshot_;
+  uint64_t snapshot_update_cnt_;
+  uint64_t snapshot_model_update_cnt_;
+  uint64_t snapshot_ns_;
+  uint64_t snapshot_interval_ns_;
 };
 }}  // namespace nvidia::inferenceserver
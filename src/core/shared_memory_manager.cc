@@ -0,0 +1,261 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "src/core/shared_memory_manager.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <mutex>
+#include <unordered_map>
+#include "src/core/logging.h"
+#include "src/core/provider.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+//
+// A registered region, mapped into the server's address space for
+// as long as the region is registered or referenced by a request.
+//
+class Region {
+ public:
+  Region(void* mapped_base, size_t mapped_byte_size, size_t base_offset)
+      : mapped_base_(mapped_base), mapped_byte_size_(mapped_byte_size),
+        base_(static_cast<char*>(mapped_base) + base_offset)
+  {
+  }
+
+  ~Region() { munmap(mapped_base_, mapped_byte_size_); }
+
+  char* Base() const { return base_; }
+
+ private:
+  void* mapped_base_;
+  const size_t mapped_byte_size_;
+  char* base_;
+};
+
+//
+// Reference to a range of a region that keeps the region mapped.
+//
+class RegionMemory : public SystemMemoryReference {
+ public:
+  RegionMemory(
+      const std::shared_ptr<Region>& region, const char* base,
+      size_t byte_size)
+      : region_(region)
+  {
+    AddBuffer(base, byte_size);
+  }
+
+ private:
+  std::shared_ptr<Region> region_;
+};
+
+struct RegionInfo {
+  size_t byte_size_;
+  std::shared_ptr<Region> region_;
+};
+
+//
+// The registered regions, shared by all server endpoints.
+//
+struct Registry {
+  std::mutex mu_;
+  std::unordered_map<std::string, RegionInfo> regions_;
+};
+
+Registry*
+GetRegistry()
+{
+  static Registry* registry = new Registry();
+  return registry;
+}
+
+Status
+MapRegion(
+    const std::string& shm_key, size_t offset, size_t byte_size,
+    std::shared_ptr<Region>* region)
+{
+  int fd = shm_open(shm_key.c_str(), O_RDWR, 0);
+  if (fd == -1) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "unable to open shared memory '" + shm_key +
+            "': " + std::string(strerror(errno)));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    const int err = errno;
+    close(fd);
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unable to get size of shared memory '" + shm_key +
+            "': " + std::string(strerror(err)));
+  }
+
+  if ((offset > (size_t)st.st_size) ||
+      (byte_size > ((size_t)st.st_size - offset))) {
+    close(fd);
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "region of " + std::to_string(byte_size) + " bytes at offset " +
+            std::to_string(offset) + " exceeds shared memory '" + shm_key +
+            "' of " + std::to_string(st.st_size) + " bytes");
+  }
+
+  // mmap requires a page-aligned offset so map from the start of the
+  // page holding 'offset'.
+  const size_t page_byte_size = sysconf(_SC_PAGESIZE);
+  const size_t map_offset = offset - (offset % page_byte_size);
+  const size_t map_byte_size = byte_size + (offset - map_offset);
+
+  void* base = mmap(
+      nullptr, map_byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+      map_offset);
+  const int err = errno;
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "unable to map shared memory '" + shm_key +
+            "': " + std::string(strerror(err)));
+  }
+
+  region->reset(new Region(base, map_byte_size, offset - map_offset));
+  return Status::Success;
+}
+
+}  // namespace
+
+Status
+SharedMemoryManager::RegisterRegion(
+    const std::string& name, const std::string& shm_key, size_t offset,
+    size_t byte_size)
+{
+  if (name.empty()) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "shared memory region name must not be empty");
+  }
+  if (byte_size == 0) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "shared memory region '" + name + "' must have non-zero size");
+  }
+
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu_);
+
+  if (registry->regions_.find(name) != registry->regions_.end()) {
+    return Status(
+        RequestStatusCode::ALREADY_EXISTS,
+        "shared memory region '" + name + "' is already registered");
+  }
+
+  RegionInfo info;
+  info.byte_size_ = byte_size;
+  RETURN_IF_ERROR(MapRegion(shm_key, offset, byte_size, &info.region_));
+
+  LOG_VERBOSE(1) << "registered shared memory region '" << name << "', key '"
+                 << shm_key << "', offset " << offset << ", size "
+                 << byte_size;
+
+  registry->regions_.emplace(name, std::move(info));
+  return Status::Success;
+}
+
+Status
+SharedMemoryManager::UnregisterRegion(const std::string& name)
+{
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu_);
+
+  if (registry->regions_.erase(name) == 0) {
+    return Status(
+        RequestStatusCode::NOT_FOUND,
+        "shared memory region '" + name + "' is not registered");
+  }
+
+  LOG_VERBOSE(1) << "unregistered shared memory region '" << name << "'";
+  return Status::Success;
+}
+
+Status
+SharedMemoryManager::UnregisterAllRegions()
+{
+  Registry* registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu_);
+  registry->regions_.clear();
+  return Status::Success;
+}
+
+Status
+SharedMemoryManager::GetMemory(
+    const std::string& name, size_t offset, size_t byte_size,
+    std::shared_ptr<SystemMemory>* memory, char** buffer)
+{
+  std::shared_ptr<Region> region;
+  {
+    Registry* registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry->mu_);
+
+    auto itr = registry->regions_.find(name);
+    if (itr == registry->regions_.end()) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "shared memory region '" + name + "' is not registered");
+    }
+
+    const RegionInfo& info = itr->second;
+    if ((offset > info.byte_size_) ||
+        (byte_size > (info.byte_size_ - offset))) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          std::to_string(byte_size) + " bytes at offset " +
+              std::to_string(offset) + " exceeds shared memory region '" +
+              name + "' of " + std::to_string(info.byte_size_) + " bytes");
+    }
+
+    region = info.region_;
+  }
+
+  char* base = region->Base() + offset;
+  memory->reset(new RegionMemory(region, base, byte_size));
+  if (buffer != nullptr) {
+    *buffer = base;
+  }
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
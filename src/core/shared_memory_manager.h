@@ -0,0 +1,71 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include <string>
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+class SystemMemory;
+
+//
+// Registry of system (POSIX) shared-memory regions that clients on
+// the same host use to exchange input and output tensors with the
+// server without serializing them into the HTTP or GRPC request. A
+// region is registered under a client-chosen name and covers
+// 'byte_size' bytes starting at 'offset' within a shared-memory
+// object. Requests hold a reference to the regions they use so
+// unregistering a region never invalidates an in-flight request.
+//
+class SharedMemoryManager {
+ public:
+  // Register a region called 'name' that covers 'byte_size' bytes
+  // starting at 'offset' within the shared-memory object
+  // 'shm_key'. The object must already exist and be large enough to
+  // hold the region.
+  static Status RegisterRegion(
+      const std::string& name, const std::string& shm_key, size_t offset,
+      size_t byte_size);
+
+  // Unregister the region called 'name'.
+  static Status UnregisterRegion(const std::string& name);
+
+  // Unregister all regions.
+  static Status UnregisterAllRegions();
+
+  // Get 'byte_size' bytes starting at 'offset' within the region
+  // called 'name'. 'memory' references the bytes in place and keeps
+  // the region mapped for as long as it is held. If 'buffer' is
+  // non-null it returns a writable pointer to the bytes.
+  static Status GetMemory(
+      const std::string& name, size_t offset, size_t byte_size,
+      std::shared_ptr<SystemMemory>* memory, char** buffer = nullptr);
+};
+
+}}  // namespace nvidia::inferenceserver
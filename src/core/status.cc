@@ -92,6 +92,9 @@ Status::AsString() const
     case RequestStatusCode::ALREADY_EXISTS:
       str = "Already exists";
       break;
+    case RequestStatusCode::BLOB_NOT_FOUND:
+      str = "Blob not found";
+      break;
 
     default:
       str = "Unknown status code (" + std::to_string(code_) + ")";
@@ -0,0 +1,93 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/string_offsets.h"
+
+#include <string>
+
+namespace nvidia { namespace inferenceserver {
+
+Status
+ParseStringOffsets(
+    const char* content, size_t byte_size, size_t element_count,
+    const char** offsets, const char** data)
+{
+  if (byte_size < StringOffsetsByteSize(0, 0)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "string data of " + std::to_string(byte_size) +
+            " bytes is too small to hold the element count and offsets");
+  }
+
+  const uint32_t cnt = StringOffsetAt(content, 0);
+  if (cnt != element_count) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "unexpected number of string elements " + std::to_string(cnt) +
+            ", expecting " + std::to_string(element_count));
+  }
+
+  const size_t header_byte_size = StringOffsetsByteSize(cnt, 0);
+  if (byte_size < header_byte_size) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "string data of " + std::to_string(byte_size) +
+            " bytes is too small to hold " + std::to_string(cnt) +
+            " offsets");
+  }
+
+  // The offsets must start at zero, never decrease and end at the
+  // size of the element bytes, so that every element is in bounds.
+  *offsets = content + sizeof(uint32_t);
+  *data = content + header_byte_size;
+  uint32_t prev = StringOffsetAt(*offsets, 0);
+  if (prev != 0) {
+    return Status(
+        RequestStatusCode::INVALID_ARG, "first string offset must be 0");
+  }
+  for (size_t i = 1; i <= cnt; ++i) {
+    const uint32_t next = StringOffsetAt(*offsets, i);
+    if (next < prev) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "string offset " + std::to_string(i) + " is less than the " +
+              "preceding offset");
+    }
+    prev = next;
+  }
+  if (prev != (byte_size - header_byte_size)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "last string offset " + std::to_string(prev) +
+            " does not match the " +
+            std::to_string(byte_size - header_byte_size) +
+            " bytes of string data");
+  }
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
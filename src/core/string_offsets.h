@@ -0,0 +1,76 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+//
+// Helpers for STRING tensor data in the
+// InferRequestHeader::STRING_OFFSETS encoding: a uint32 element count
+// N, N + 1 uint32 offsets and then the bytes of all elements.
+//
+
+// Return the byte-size of 'element_count' strings holding a total of
+// 'data_byte_size' bytes in the offsets encoding.
+inline size_t
+StringOffsetsByteSize(size_t element_count, size_t data_byte_size)
+{
+  return ((element_count + 2) * sizeof(uint32_t)) + data_byte_size;
+}
+
+// Return the 'idx'th uint32 of 'ptr'. The offsets are not necessarily
+// aligned within the tensor data so they are read with memcpy.
+inline uint32_t
+StringOffsetAt(const char* ptr, size_t idx)
+{
+  uint32_t value;
+  memcpy(&value, ptr + (idx * sizeof(uint32_t)), sizeof(uint32_t));
+  return value;
+}
+
+// Write the 'idx'th uint32 of 'ptr'.
+inline void
+SetStringOffsetAt(char* ptr, size_t idx, uint32_t value)
+{
+  memcpy(ptr + (idx * sizeof(uint32_t)), &value, sizeof(uint32_t));
+}
+
+// Validate that the 'byte_size' bytes of 'content' hold exactly
+// 'element_count' strings in the offsets encoding. Return in
+// 'offsets' the start of the N + 1 offsets and in 'data' the start of
+// the element bytes, so that element 'i' is the
+// StringOffsetAt(offsets, i + 1) - StringOffsetAt(offsets, i) bytes
+// at 'data' + StringOffsetAt(offsets, i).
+Status ParseStringOffsets(
+    const char* content, size_t byte_size, size_t element_count,
+    const char** offsets, const char** data);
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,352 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/core/tensor_convert.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include "src/core/float16.h"
+#include "src/core/model_config.h"
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+// Values are computed in float when both datatypes fit exactly in a
+// float, so that the common conversions (UINT8 pixels to FP32, FP32
+// to FP16) stay in single precision and vectorize well. Wider
+// datatypes are computed in double.
+template <typename T>
+struct IsNarrow {
+  static constexpr bool value =
+      (sizeof(T) <= 2) || std::is_same<T, float>::value;
+};
+
+template <typename S, typename D>
+using ComputeType = typename std::conditional<
+    IsNarrow<S>::value && IsNarrow<D>::value, float, double>::type;
+
+template <typename C, typename S>
+inline C
+Load(const S v)
+{
+  return static_cast<C>(v);
+}
+
+template <>
+inline float
+Load<float, Float16>(const Float16 v)
+{
+  return Float16ToFloat(v);
+}
+
+template <>
+inline double
+Load<double, Float16>(const Float16 v)
+{
+  return Float16ToFloat(v);
+}
+
+template <>
+inline float
+Load<float, BFloat16>(const BFloat16 v)
+{
+  return BFloat16ToFloat(v);
+}
+
+template <>
+inline double
+Load<double, BFloat16>(const BFloat16 v)
+{
+  return BFloat16ToFloat(v);
+}
+
+// Store to a floating-point datatype.
+template <typename D, typename C>
+inline typename std::enable_if<std::is_floating_point<D>::value, D>::type
+Store(const C v)
+{
+  return static_cast<D>(v);
+}
+
+// Store to an integer datatype, rounding to nearest and saturating.
+// NaN becomes zero. Written without branches so the loop vectorizes.
+template <typename D, typename C>
+inline typename std::enable_if<std::is_integral<D>::value, D>::type
+Store(C v)
+{
+  const C lo = static_cast<C>(std::numeric_limits<D>::lowest());
+  const C hi = static_cast<C>(std::numeric_limits<D>::max());
+  v = (v == v) ? v : C(0);
+  v = (v < lo) ? lo : v;
+  v = (v > hi) ? hi : v;
+  v = v + ((v < C(0)) ? C(-0.5) : C(0.5));
+  return (v >= hi) ? std::numeric_limits<D>::max() : static_cast<D>(v);
+}
+
+template <typename D, typename C>
+inline typename std::enable_if<std::is_same<D, Float16>::value, D>::type
+Store(const C v)
+{
+  return FloatToFloat16(static_cast<float>(v));
+}
+
+template <typename D, typename C>
+inline typename std::enable_if<std::is_same<D, BFloat16>::value, D>::type
+Store(const C v)
+{
+  return FloatToBFloat16(static_cast<float>(v));
+}
+
+template <typename S, typename D>
+void
+ConvertLoop(
+    const S* __restrict__ src, D* __restrict__ dst, size_t cnt, float scale,
+    float offset)
+{
+  using C = ComputeType<S, D>;
+  const C cscale = scale;
+  const C coffset = offset;
+  if ((scale == 1.0f) && (offset == 0.0f)) {
+    for (size_t i = 0; i < cnt; ++i) {
+      dst[i] = Store<D, C>(Load<C, S>(src[i]));
+    }
+  } else {
+    for (size_t i = 0; i < cnt; ++i) {
+      dst[i] = Store<D, C>(Load<C, S>(src[i]) * cscale + coffset);
+    }
+  }
+}
+
+template <typename S>
+Status
+ConvertFrom(
+    const S* src, DataType dst_dtype, void* dst, size_t cnt, float scale,
+    float offset)
+{
+  switch (dst_dtype) {
+    case TYPE_UINT8:
+      ConvertLoop(src, static_cast<uint8_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_UINT16:
+      ConvertLoop(src, static_cast<uint16_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_UINT32:
+      ConvertLoop(src, static_cast<uint32_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_UINT64:
+      ConvertLoop(src, static_cast<uint64_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_INT8:
+      ConvertLoop(src, static_cast<int8_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_INT16:
+      ConvertLoop(src, static_cast<int16_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_INT32:
+      ConvertLoop(src, static_cast<int32_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_INT64:
+      ConvertLoop(src, static_cast<int64_t*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_FP16:
+      ConvertLoop(src, static_cast<Float16*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_BF16:
+      ConvertLoop(src, static_cast<BFloat16*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_FP32:
+      ConvertLoop(src, static_cast<float*>(dst), cnt, scale, offset);
+      break;
+    case TYPE_FP64:
+      ConvertLoop(src, static_cast<double*>(dst), cnt, scale, offset);
+      break;
+    default:
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "unable to convert tensor data to " +
+              DataType_Name(dst_dtype));
+  }
+
+  return Status::Success;
+}
+
+// Transpose in square tiles so that both the reads and the writes of
+// a tile stay in cache. Each column of a tile is written contiguously.
+template <typename T>
+void
+TransposeLoop(
+    const T* __restrict__ src, T* __restrict__ dst, size_t matrix_count,
+    size_t rows, size_t cols)
+{
+  constexpr size_t kTile = 32;
+  const size_t matrix_size = rows * cols;
+  for (size_t m = 0; m < matrix_count; ++m) {
+    const T* s = src + (m * matrix_size);
+    T* d = dst + (m * matrix_size);
+    for (size_t r0 = 0; r0 < rows; r0 += kTile) {
+      const size_t rend = std::min(rows, r0 + kTile);
+      for (size_t c0 = 0; c0 < cols; c0 += kTile) {
+        const size_t cend = std::min(cols, c0 + kTile);
+        for (size_t c = c0; c < cend; ++c) {
+          for (size_t r = r0; r < rend; ++r) {
+            d[(c * rows) + r] = s[(r * cols) + c];
+          }
+        }
+      }
+    }
+  }
+}
+
+bool
+IsConvertible(DataType dtype)
+{
+  return (GetDataTypeByteSize(dtype) > 0) && (dtype != TYPE_BOOL);
+}
+
+}  // namespace
+
+bool
+IsConvertibleDataType(DataType src_dtype, DataType dst_dtype)
+{
+  return IsConvertible(src_dtype) && IsConvertible(dst_dtype);
+}
+
+Status
+ConvertTensorData(
+    DataType src_dtype, const void* src, DataType dst_dtype, void* dst,
+    size_t element_count, float scale, float offset)
+{
+  if (!IsConvertibleDataType(src_dtype, dst_dtype)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "unable to convert tensor data from " + DataType_Name(src_dtype) +
+            " to " + DataType_Name(dst_dtype));
+  }
+
+  if ((src_dtype == dst_dtype) && (scale == 1.0f) && (offset == 0.0f)) {
+    memcpy(dst, src, element_count * GetDataTypeByteSize(src_dtype));
+    return Status::Success;
+  }
+
+  switch (src_dtype) {
+    case TYPE_UINT8:
+      return ConvertFrom(
+          static_cast<const uint8_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_UINT16:
+      return ConvertFrom(
+          static_cast<const uint16_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_UINT32:
+      return ConvertFrom(
+          static_cast<const uint32_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_UINT64:
+      return ConvertFrom(
+          static_cast<const uint64_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_INT8:
+      return ConvertFrom(
+          static_cast<const int8_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_INT16:
+      return ConvertFrom(
+          static_cast<const int16_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_INT32:
+      return ConvertFrom(
+          static_cast<const int32_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_INT64:
+      return ConvertFrom(
+          static_cast<const int64_t*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_FP16:
+      return ConvertFrom(
+          static_cast<const Float16*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_BF16:
+      return ConvertFrom(
+          static_cast<const BFloat16*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_FP32:
+      return ConvertFrom(
+          static_cast<const float*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    case TYPE_FP64:
+      return ConvertFrom(
+          static_cast<const double*>(src), dst_dtype, dst, element_count,
+          scale, offset);
+    default:
+      break;
+  }
+
+  return Status(
+      RequestStatusCode::INVALID_ARG,
+      "unable to convert tensor data from " + DataType_Name(src_dtype));
+}
+
+Status
+TransposeTensorData(
+    size_t element_byte_size, const void* src, void* dst, size_t matrix_count,
+    size_t rows, size_t cols)
+{
+  switch (element_byte_size) {
+    case 1:
+      TransposeLoop(
+          static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst),
+          matrix_count, rows, cols);
+      break;
+    case 2:
+      TransposeLoop(
+          static_cast<const uint16_t*>(src), static_cast<uint16_t*>(dst),
+          matrix_count, rows, cols);
+      break;
+    case 4:
+      TransposeLoop(
+          static_cast<const uint32_t*>(src), static_cast<uint32_t*>(dst),
+          matrix_count, rows, cols);
+      break;
+    case 8:
+      TransposeLoop(
+          static_cast<const uint64_t*>(src), static_cast<uint64_t*>(dst),
+          matrix_count, rows, cols);
+      break;
+    default:
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "unable to transpose tensor data with " +
+              std::to_string(element_byte_size) + " byte elements");
+  }
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
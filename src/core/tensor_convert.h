@@ -0,0 +1,56 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include "src/core/model_config.pb.h"
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+// Return true if tensor data can be converted from 'src_dtype' to
+// 'dst_dtype' by ConvertTensorData. Conversion is supported between
+// all fixed-size numeric datatypes, that is every fixed-size datatype
+// except TYPE_BOOL.
+bool IsConvertibleDataType(DataType src_dtype, DataType dst_dtype);
+
+// Convert 'element_count' elements of 'src_dtype' tensor data in
+// 'src' to 'dst_dtype' tensor data in 'dst'. Each value 'v' becomes
+// 'v * scale + offset'. Integer results are rounded to nearest and
+// saturated to the range of the destination datatype.
+Status ConvertTensorData(
+    DataType src_dtype, const void* src, DataType dst_dtype, void* dst,
+    size_t element_count, float scale = 1.0f, float offset = 0.0f);
+
+// Transpose 'matrix_count' consecutive 'rows' x 'cols' matrices of
+// 'element_byte_size' elements from 'src' into 'dst', for example to
+// convert a batch of images between HWC and CHW layouts. 'src' and
+// 'dst' must not overlap.
+Status TransposeTensorData(
+    size_t element_byte_size, const void* src, void* dst, size_t matrix_count,
+    size_t rows, size_t cols);
+
+}}  // namespace nvidia::inferenceserver
@@ -0,0 +1,210 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "src/core/float16.h"
+
+namespace nvidia { namespace inferenceserver {
+
+// Map a half-precision value to an unsigned integer that has the
+// same ordering as the value, so FP16 scores can be compared without
+// converting them to float.
+inline uint16_t
+Float16OrderKey(Float16 h)
+{
+  return ((h.bits_ & 0x8000) != 0) ? static_cast<uint16_t>(~h.bits_)
+                                   : static_cast<uint16_t>(h.bits_ | 0x8000);
+}
+
+namespace topk {
+
+// Top-K sizes up to this use a streaming heap, larger sizes use
+// nth_element.
+constexpr size_t kMaxHeapK = 64;
+
+// Number of values the streaming heap compares against the current
+// threshold at once. Written as a branch-free loop so that it
+// vectorizes.
+constexpr size_t kScanBlock = 16;
+
+// Ordering of value indices from best to worst: larger value first,
+// lower index first for equal values.
+template <typename T>
+struct Better {
+  const T* values_;
+  bool operator()(size_t a, size_t b) const
+  {
+    return (values_[a] > values_[b]) ||
+           (!(values_[b] > values_[a]) && (a < b));
+  }
+};
+
+template <typename T>
+size_t
+ArgMax(const T* values, const size_t cnt)
+{
+  T max = values[0];
+  for (size_t i = 1; i < cnt; ++i) {
+    max = (values[i] > max) ? values[i] : max;
+  }
+
+  for (size_t i = 0; i < cnt; ++i) {
+    if (!(values[i] < max)) {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
+template <typename T>
+void
+HeapTopK(const T* values, const size_t cnt, const size_t k, size_t* topk)
+{
+  // 'topk' is a heap with the worst of the current top-K at the
+  // front. Only values strictly better than the front can enter, so
+  // scanning in index order keeps lower indices on ties.
+  const Better<T> better{values};
+  std::iota(topk, topk + k, 0);
+  std::make_heap(topk, topk + k, better);
+
+  size_t i = k;
+  while (i < cnt) {
+    const size_t end = std::min(cnt, i + kScanBlock);
+    const T threshold = values[topk[0]];
+    bool any = false;
+    for (size_t j = i; j < end; ++j) {
+      any |= (values[j] > threshold);
+    }
+
+    if (any) {
+      for (size_t j = i; j < end; ++j) {
+        if (values[j] > values[topk[0]]) {
+          std::pop_heap(topk, topk + k, better);
+          topk[k - 1] = j;
+          std::push_heap(topk, topk + k, better);
+        }
+      }
+    }
+
+    i = end;
+  }
+
+  std::sort_heap(topk, topk + k, better);
+}
+
+template <typename T>
+void
+SelectTopK(
+    const T* values, const size_t cnt, const size_t k, size_t* topk,
+    std::vector<size_t>* scratch)
+{
+  if (k == 1) {
+    topk[0] = ArgMax(values, cnt);
+  } else if (k <= kMaxHeapK) {
+    HeapTopK(values, cnt, k, topk);
+  } else {
+    const Better<T> better{values};
+    scratch->resize(cnt);
+    std::iota(scratch->begin(), scratch->end(), 0);
+    if (k < cnt) {
+      std::nth_element(
+          scratch->begin(), scratch->begin() + k, scratch->end(), better);
+    }
+    std::sort(scratch->begin(), scratch->begin() + k, better);
+    std::copy(scratch->begin(), scratch->begin() + k, topk);
+  }
+}
+
+// Per-type view of the values used for selection. FP16 values are
+// selected on their integer order keys.
+template <typename T>
+struct Keys {
+  using KeyType = T;
+  static const T* Get(const T* values, size_t, std::vector<T>*)
+  {
+    return values;
+  }
+};
+
+template <>
+struct Keys<Float16> {
+  using KeyType = uint16_t;
+  static const uint16_t* Get(
+      const Float16* values, size_t cnt, std::vector<uint16_t>* keys)
+  {
+    keys->resize(cnt);
+    for (size_t i = 0; i < cnt; ++i) {
+      (*keys)[i] = Float16OrderKey(values[i]);
+    }
+    return keys->data();
+  }
+};
+
+template <typename T>
+void
+BatchTopKRange(
+    const T* values, const size_t begin, const size_t end,
+    const size_t entry_cnt, const size_t k, size_t* topk)
+{
+  using KeyType = typename Keys<T>::KeyType;
+  std::vector<KeyType> key_buffer;
+  std::vector<size_t> scratch;
+  for (size_t b = begin; b < end; ++b) {
+    const KeyType* keys =
+        Keys<T>::Get(values + (b * entry_cnt), entry_cnt, &key_buffer);
+    SelectTopK(keys, entry_cnt, k, topk + (b * k), &scratch);
+  }
+}
+
+}  // namespace topk
+
+// For each of the 'batch_size' rows of 'entry_cnt' values in
+// 'values', write the indices of the 'k' largest values, ordered from
+// largest to smallest, to the corresponding 'k' entries of
+// 'topk'. Equal values are ordered by index. 'k' must not be larger
+// than 'entry_cnt'. Rows are selected one at a time on the calling
+// thread.
+template <typename T>
+void
+BatchTopK(
+    const T* values, const size_t batch_size, const size_t entry_cnt,
+    const size_t k, size_t* topk)
+{
+  if ((k == 0) || (entry_cnt == 0)) {
+    return;
+  }
+
+  topk::BatchTopKRange(values, 0, batch_size, entry_cnt, k, topk);
+}
+
+}}  // namespace nvidia::inferenceserver
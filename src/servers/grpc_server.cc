@@ -26,6 +26,9 @@
 
 #include "src/servers/grpc_server.h"
 
+#include <string.h>
+#include <atomic>
+#include <functional>
 #include <map>
 #include "grpc++/security/server_credentials.h"
 #include "grpc++/server.h"
@@ -34,10 +37,12 @@
 #include "grpc++/support/status.h"
 #include "grpc/grpc.h"
 #include "src/core/backend.h"
+#include "src/core/blob_store.h"
 #include "src/core/constants.h"
 #include "src/core/grpc_service.grpc.pb.h"
 #include "src/core/logging.h"
 #include "src/core/provider_utils.h"
+#include "src/core/request_arena.h"
 #include "src/core/request_status.h"
 #include "src/core/server.h"
 #include "src/nvrpc/Context.h"
@@ -45,6 +50,7 @@
 #include "src/nvrpc/Resources.h"
 #include "src/nvrpc/Service.h"
 #include "src/nvrpc/ThreadPool.h"
+#include "src/servers/unix_socket.h"
 
 using nvrpc::BaseContext;
 using nvrpc::BidirectionalStreamingLifeCycle;
@@ -94,96 +100,161 @@ class StatusContext final
           RequestStatus* request_status = response.mutable_request_status();
           ServerStatus* server_status = response.mutable_server_status();
 
-          GetResources()->GetServer()->HandleStatus(
-              request_status, server_status, request.model_name());
-          this->CompleteExecution(execution_context);
-        });
-  }
-};
+          InferenceServer* server = GetResources()->GetServer();
+          std::shared_ptr<const ServerStatusSnapshot> snapshot;
+          ServerReadyState ready_state;
+          uint64_t uptime_ns;
+          server->HandleStatus(
+              request_status, &snapshot, &ready_state, &uptime_ns);
 
-template <class LifeCycle>
-class InferBaseContext : public BaseContext<LifeCycle, AsyncResources> {
-  // Helper function that utilizes RETURN_IF_ERROR to avoid nested 'if'
-  Status InferHelper(
-      InferenceServer* server, std::shared_ptr<ModelInferStats>& infer_stats,
-      std::shared_ptr<ModelInferStats::ScopedTimer>& timer,
-      InferRequest& request, InferResponse& response)
-  {
-    std::shared_ptr<InferenceServer::InferBackendHandle> backend = nullptr;
-    RETURN_IF_ERROR(InferenceServer::InferBackendHandle::Create(
-        server, request.model_name(), request.model_version(), &backend));
-    infer_stats->SetMetricReporter(
-        backend->GetInferenceBackend()->MetricReporter());
-
-    std::unordered_map<std::string, std::shared_ptr<SystemMemory>> input_map;
-    InferRequestHeader request_header = request.meta_data();
-    RETURN_IF_ERROR(NormalizeRequestHeader(
-        *backend->GetInferenceBackend(), request_header));
-    RETURN_IF_ERROR(
-        GRPCInferRequestToInputMap(request_header, request, input_map));
-
-    std::shared_ptr<InferRequestProvider> request_provider;
-    std::shared_ptr<GRPCInferResponseProvider> response_provider;
-    RETURN_IF_ERROR(InferRequestProvider::Create(
-        request.model_name(), request.model_version(), request_header,
-        input_map, &request_provider));
-    infer_stats->SetBatchSize(request_header.batch_size());
-
-    RETURN_IF_ERROR(GRPCInferResponseProvider::Create(
-        request.meta_data(), &response,
-        backend->GetInferenceBackend()->GetLabelProvider(),
-        &response_provider));
-
-    RequestStatus* request_status = response.mutable_request_status();
-    uint64_t id = request.meta_data().id();
-    uintptr_t execution_context = this->GetExecutionContext();
-    server->HandleInfer(
-        request_status, backend, request_provider, response_provider,
-        infer_stats,
-        [this, execution_context, id, request_status, &response, infer_stats,
-         timer]() mutable {
-          // If the response is an error then clear the meta-data
-          // and raw output as they may be partially or
-          // un-initialized.
+          // Only the generation is returned if the client already has
+          // the current one.
           if (request_status->code() != RequestStatusCode::SUCCESS) {
-            response.mutable_meta_data()->Clear();
-            response.mutable_raw_output()->Clear();
+            // Nothing to return.
+          } else if (
+              (request.known_generation() != 0) &&
+              (request.known_generation() == snapshot->Generation())) {
+            server_status->set_generation(snapshot->Generation());
+            response.set_not_modified(true);
+          } else {
+            std::vector<std::string> model_names(
+                request.model_names().begin(), request.model_names().end());
+            if (!request.model_name().empty()) {
+              model_names.push_back(request.model_name());
+            }
+            std::vector<std::string> fields(
+                request.fields().begin(), request.fields().end());
+
+            Status status =
+                snapshot->Filter(model_names, fields, server_status);
+            server_status->set_ready_state(ready_state);
+            server_status->set_uptime_ns(uptime_ns);
+            if (!status.IsOk()) {
+              RequestStatusFactory::Create(
+                  request_status, request_status->request_id(),
+                  server->Id(), status);
+            }
           }
 
-          response.mutable_meta_data()->set_id(id);
           this->CompleteExecution(execution_context);
-          timer.reset();
         });
-
-    return Status::Success;
   }
+};
 
-  void ExecuteRPC(InferRequest& request, InferResponse& response) final override
-  {
-    auto server = this->GetResources()->GetServer();
-    auto infer_stats = std::make_shared<ModelInferStats>(
-        server->StatusManager(), request.model_name());
-    auto timer = std::make_shared<ModelInferStats::ScopedTimer>();
-    infer_stats->StartRequestTimer(timer.get());
-    infer_stats->SetRequestedVersion(request.model_version());
-
-    Status status = InferHelper(server, infer_stats, timer, request, response);
+// Helper function that utilizes RETURN_IF_ERROR to avoid nested
+// 'if'. 'OnComplete' is called once 'response' is complete.
+Status
+InferHelper(
+    InferenceServer* server, const std::shared_ptr<RequestArena>& arena,
+    const std::shared_ptr<ModelInferStats>& infer_stats,
+    ModelInferStats::ScopedTimer* timer, InferRequest& request,
+    InferResponse& response, const std::function<void()>& OnComplete)
+{
+  std::shared_ptr<InferenceServer::InferBackendHandle> backend = nullptr;
+  RETURN_IF_ERROR(InferenceServer::InferBackendHandle::Create(
+      server, request.model_name(), request.model_version(), &backend));
+  infer_stats->SetMetricReporter(
+      backend->GetInferenceBackend()->MetricReporter());
+
+  InputMemoryList input_map;
+  RequestOrdinals ordinals;
+
+  // Move the header out of the request instead of copying it. It is
+  // shared by the providers, which are in the same arena.
+  auto request_header = RequestArena::Borrow(arena->New<InferRequestHeader>(
+      std::move(*request.mutable_meta_data())));
+  RETURN_IF_ERROR(NormalizeRequestHeader(
+      *backend->GetInferenceBackend(), *request_header, &ordinals));
+  RETURN_IF_ERROR(
+      GRPCInferRequestToInputMap(*request_header, request, input_map));
+
+  std::shared_ptr<InferRequestProvider> request_provider;
+  std::shared_ptr<GRPCInferResponseProvider> response_provider;
+  RETURN_IF_ERROR(InferRequestProvider::Create(
+      request.model_name(), request.model_version(), request_header,
+      ordinals, input_map, &request_provider, arena));
+  infer_stats->SetBatchSize(request_header->batch_size());
+
+  RETURN_IF_ERROR(GRPCInferResponseProvider::Create(
+      request_header, ordinals, &response,
+      backend->GetInferenceBackend()->GetLabelProvider(), &response_provider,
+      arena));
+
+  RequestStatus* request_status = response.mutable_request_status();
+  uint64_t id = request_header->id();
+  server->HandleInfer(
+      request_status, backend, request_provider, response_provider,
+      infer_stats,
+      [OnComplete, id, request_status, &response, infer_stats,
+       timer]() mutable {
+        // If the response is an error then clear the meta-data
+        // and raw output as they may be partially or
+        // un-initialized.
+        if (request_status->code() != RequestStatusCode::SUCCESS) {
+          response.mutable_meta_data()->Clear();
+          response.mutable_raw_output()->Clear();
+        }
+
+        response.mutable_meta_data()->set_id(id);
+        OnComplete();
+
+        // The timer is destroyed with the arena, which may outlive
+        // this callback, so stop it here to not count the release
+        // of the request objects.
+        timer->Stop();
+      });
 
-    if (!status.IsOk()) {
-      LOG_VERBOSE(1) << "Infer failed: " << status.Message();
-      infer_stats->SetFailed(true);
-      RequestStatusFactory::Create(
-          response.mutable_request_status(), 0 /* request_id */, server->Id(),
-          status);
+  return Status::Success;
+}
 
-      // If the response is an error then clear the meta-data and raw
-      // output as they may be partially or un-initialized.
-      response.mutable_meta_data()->Clear();
-      response.mutable_raw_output()->Clear();
+// Issue the inference for 'request'. 'OnComplete' is called once
+// 'response' is complete, also if the request fails.
+void
+IssueInfer(
+    InferenceServer* server, InferRequest& request, InferResponse& response,
+    const std::function<void()>& OnComplete)
+{
+  // All the objects needed to handle the request are created in the
+  // arena, which is released once the last of them is released.
+  auto arena = std::make_shared<RequestArena>();
+  auto infer_stats = RequestArena::MakeShared<ModelInferStats>(
+      arena, server->StatusManager(), request.model_name());
+  auto timer = arena->New<ModelInferStats::ScopedTimer>();
+  infer_stats->StartRequestTimer(timer);
+  infer_stats->SetRequestedVersion(request.model_version());
+
+  // The request header is moved out of 'request' by InferHelper().
+  const uint64_t id = request.meta_data().id();
+  Status status = InferHelper(
+      server, arena, infer_stats, timer, request, response, OnComplete);
+
+  if (!status.IsOk()) {
+    LOG_VERBOSE(1) << "Infer failed: " << status.Message();
+    infer_stats->SetFailed(true);
+    RequestStatusFactory::Create(
+        response.mutable_request_status(), 0 /* request_id */, server->Id(),
+        status);
+
+    // If the response is an error then clear the meta-data and raw
+    // output as they may be partially or un-initialized.
+    response.mutable_meta_data()->Clear();
+    response.mutable_raw_output()->Clear();
+
+    response.mutable_meta_data()->set_id(id);
+    OnComplete();
+  }
+}
 
-      response.mutable_meta_data()->set_id(request.meta_data().id());
-      this->CompleteExecution(this->GetExecutionContext());
-    }
+template <class LifeCycle>
+class InferBaseContext : public BaseContext<LifeCycle, AsyncResources> {
+  void ExecuteRPC(InferRequest& request, InferResponse& response) final override
+  {
+    uintptr_t execution_context = this->GetExecutionContext();
+    IssueInfer(
+        this->GetResources()->GetServer(), request, response,
+        [this, execution_context]() {
+          this->CompleteExecution(execution_context);
+        });
   }
 };
 
@@ -196,6 +267,60 @@ class StreamInferContext final
           BidirectionalStreamingLifeCycle<InferRequest, InferResponse>> {
 };
 
+class MultiInferContext final
+    : public Context<MultiInferRequest, MultiInferResponse, AsyncResources> {
+  void ExecuteRPC(
+      MultiInferRequest& request, MultiInferResponse& response) final override
+  {
+    auto server = this->GetResources()->GetServer();
+    uintptr_t execution_context = this->GetExecutionContext();
+
+    // Completing the last request can complete the call and release
+    // 'request' and 'response', so don't access them after issuing it.
+    const int request_cnt = request.request_size();
+    if (request_cnt == 0) {
+      RequestStatusFactory::Create(
+          response.mutable_request_status(), 0 /* request_id */,
+          server->Id(),
+          Status(
+              RequestStatusCode::INVALID_ARG,
+              "multi-infer request must contain at least one request"));
+      this->CompleteExecution(execution_context);
+      return;
+    }
+
+    RequestStatusFactory::Create(
+        response.mutable_request_status(), 0 /* request_id */, server->Id(),
+        Status::Success);
+    for (int idx = 0; idx < request_cnt; ++idx) {
+      response.add_response();
+    }
+
+    // The call is complete once all of its requests are complete.
+    auto pending_cnt = std::make_shared<std::atomic<int>>(request_cnt);
+    auto OnComplete = [this, execution_context, pending_cnt]() {
+      if (pending_cnt->fetch_sub(1) == 1) {
+        this->CompleteExecution(execution_context);
+      }
+    };
+
+    // Issue all the requests as a group so that, once they are all
+    // issued, the models schedule the requests they are holding for a
+    // dynamic batch without waiting for more.
+    InferenceServer::InferGroup group(server);
+    for (const auto& infer_request : request.request()) {
+      group.AddModel(
+          infer_request.model_name(), infer_request.model_version());
+    }
+
+    for (int idx = 0; idx < request_cnt; ++idx) {
+      IssueInfer(
+          server, *request.mutable_request(idx),
+          *response.mutable_response(idx), OnComplete);
+    }
+  }
+};
+
 class ProfileContext final
     : public Context<ProfileRequest, ProfileResponse, AsyncResources> {
   void ExecuteRPC(
@@ -236,6 +361,79 @@ class HealthContext final
         });
   }
 };
+
+class BlobUploadContext final
+    : public Context<BlobUploadRequest, BlobUploadResponse, AsyncResources> {
+  void ExecuteRPC(
+      BlobUploadRequest& request, BlobUploadResponse& response) final override
+  {
+    uintptr_t execution_context = this->GetExecutionContext();
+    GetResources()->GetMgmtThreadPool().enqueue(
+        [this, execution_context, &request, &response] {
+          auto server = GetResources()->GetServer();
+
+          // Check the content fits in the blob store before making a
+          // copy of it. The blob outlives the request so the content
+          // must be copied out of the request message.
+          const std::string& content = request.content();
+          RequestStatus* request_status = response.mutable_request_status();
+          const Status status = BlobStore::CheckByteSize(content.size());
+          if (status.IsOk()) {
+            auto blob =
+                std::make_shared<AllocatedSystemMemory>(content.size());
+            memcpy(blob->MutableBuffer(), content.data(), content.size());
+            server->HandleBlobUpload(
+                request_status, blob, response.mutable_blob_key());
+          } else {
+            RequestStatusFactory::Create(
+                request_status, 0 /* request_id */, server->Id(), status);
+          }
+          this->CompleteExecution(execution_context);
+        });
+  }
+};
+
+class SharedMemoryControlContext final
+    : public Context<
+          SharedMemoryControlRequest, SharedMemoryControlResponse,
+          AsyncResources> {
+  void ExecuteRPC(
+      SharedMemoryControlRequest& request,
+      SharedMemoryControlResponse& response) final override
+  {
+    uintptr_t execution_context = this->GetExecutionContext();
+    GetResources()->GetMgmtThreadPool().enqueue(
+        [this, execution_context, &request, &response] {
+          auto server = GetResources()->GetServer();
+          RequestStatus* request_status = response.mutable_request_status();
+
+          switch (request.type_case()) {
+            case SharedMemoryControlRequest::kRegisterRegion: {
+              const auto& region = request.register_region();
+              server->HandleRegisterSharedMemory(
+                  request_status, region.name(), region.shared_memory_key(),
+                  region.offset(), region.byte_size());
+              break;
+            }
+            case SharedMemoryControlRequest::kUnregisterRegion:
+              server->HandleUnregisterSharedMemory(
+                  request_status, request.unregister_region().name());
+              break;
+            case SharedMemoryControlRequest::kUnregisterAllRegions:
+              server->HandleUnregisterAllSharedMemory(request_status);
+              break;
+            default:
+              RequestStatusFactory::Create(
+                  request_status, 0 /* request_id */, server->Id(),
+                  RequestStatusCode::INVALID_ARG,
+                  "shared memory control request must specify an action");
+              break;
+          }
+
+          this->CompleteExecution(execution_context);
+        });
+  }
+};
 }  // namespace
 
 GRPCServer::GRPCServer(
@@ -253,16 +451,40 @@ GRPCServer::~GRPCServer()
 
 Status
 GRPCServer::Create(
-    InferenceServer* server, int32_t port, int infer_thread_cnt,
-    int stream_infer_thread_cnt, std::unique_ptr<GRPCServer>* grpc_server)
+    InferenceServer* server, int32_t port, const std::string& unix_socket_path,
+    int infer_thread_cnt, int stream_infer_thread_cnt,
+    std::unique_ptr<GRPCServer>* grpc_server)
 {
   g_Resources = std::make_shared<AsyncResources>(
       server, 1 /* infer threads */, 1 /* mgmt threads */);
 
-  std::string addr = "0.0.0.0:" + std::to_string(port);
-  LOG_INFO << "Starting a GRPCService at " << addr;
+  // The server listens on the port, the Unix domain socket or
+  // both. GRPC removes any file at the socket path before binding the
+  // socket, so first make sure no other server is listening on it.
+  std::vector<std::string> addrs;
+  if (port != -1) {
+    addrs.push_back("0.0.0.0:" + std::to_string(port));
+  }
+  if (!unix_socket_path.empty()) {
+    RETURN_IF_ERROR(RemoveStaleUnixSocket(unix_socket_path));
+    addrs.push_back("unix:" + unix_socket_path);
+  }
+  if (addrs.empty()) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "GRPC is enabled but has neither a port nor a Unix domain socket");
+  }
+
+  for (const auto& addr : addrs) {
+    LOG_INFO << "Starting a GRPCService at " << addr;
+  }
   grpc_server->reset(
-      new GRPCServer(addr, infer_thread_cnt, stream_infer_thread_cnt));
+      new GRPCServer(addrs[0], infer_thread_cnt, stream_infer_thread_cnt));
+  for (size_t i = 1; i < addrs.size(); ++i) {
+    (*grpc_server)
+        ->GetBuilder()
+        .AddListeningPort(addrs[i], ::grpc::InsecureServerCredentials());
+  }
 
   (*grpc_server)->GetBuilder().SetMaxMessageSize(MAX_GRPC_MESSAGE_SIZE);
 
@@ -278,6 +500,11 @@ GRPCServer::Create(
       inferenceService->RegisterRPC<StreamInferContext>(
           &GRPCService::AsyncService::RequestStreamInfer);
 
+  LOG_INFO << "Register MultiInfer RPC";
+  (*grpc_server)->rpcMultiInfer_ =
+      inferenceService->RegisterRPC<MultiInferContext>(
+          &GRPCService::AsyncService::RequestMultiInfer);
+
   LOG_INFO << "Register Status RPC";
   (*grpc_server)->rpcStatus_ = inferenceService->RegisterRPC<StatusContext>(
       &GRPCService::AsyncService::RequestStatus);
@@ -290,6 +517,16 @@ GRPCServer::Create(
   (*grpc_server)->rpcHealth_ = inferenceService->RegisterRPC<HealthContext>(
       &GRPCService::AsyncService::RequestHealth);
 
+  LOG_INFO << "Register BlobUpload RPC";
+  (*grpc_server)->rpcBlobUpload_ =
+      inferenceService->RegisterRPC<BlobUploadContext>(
+          &GRPCService::AsyncService::RequestBlobUpload);
+
+  LOG_INFO << "Register SharedMemoryControl RPC";
+  (*grpc_server)->rpcSharedMemoryControl_ =
+      inferenceService->RegisterRPC<SharedMemoryControlContext>(
+          &GRPCService::AsyncService::RequestSharedMemoryControl);
+
   return Status::Success;
 }
 
@@ -306,9 +543,12 @@ GRPCServer::Start()
     executor->RegisterContexts(rpcInfer_, g_Resources, infer_thread_cnt_);
     executor->RegisterContexts(
         rpcStreamInfer_, g_Resources, stream_infer_thread_cnt_);
+    executor->RegisterContexts(rpcMultiInfer_, g_Resources, infer_thread_cnt_);
     executor->RegisterContexts(rpcStatus_, g_Resources, 1);
     executor->RegisterContexts(rpcHealth_, g_Resources, 1);
     executor->RegisterContexts(rpcProfile_, g_Resources, 1);
+    executor->RegisterContexts(rpcBlobUpload_, g_Resources, 1);
+    executor->RegisterContexts(rpcSharedMemoryControl_, g_Resources, 1);
 
     AsyncRun();
     return Status::Success;
@@ -38,7 +38,8 @@ class ServerStatus;
 class GRPCServer : private nvrpc::Server {
  public:
   static Status Create(
-      InferenceServer* server, int32_t port, int infer_thread_cnt,
+      InferenceServer* server, int32_t port,
+      const std::string& unix_socket_path, int infer_thread_cnt,
       int stream_infer_thread_cnt, std::unique_ptr<GRPCServer>* grpc_servers);
   Status Start();
   Status Stop();
@@ -52,9 +53,12 @@ class GRPCServer : private nvrpc::Server {
 
   nvrpc::IRPC* rpcInfer_;
   nvrpc::IRPC* rpcStreamInfer_;
+  nvrpc::IRPC* rpcMultiInfer_;
   nvrpc::IRPC* rpcStatus_;
   nvrpc::IRPC* rpcProfile_;
   nvrpc::IRPC* rpcHealth_;
+  nvrpc::IRPC* rpcBlobUpload_;
+  nvrpc::IRPC* rpcSharedMemoryControl_;
   int infer_thread_cnt_;
   int stream_infer_thread_cnt_;
   bool running_;
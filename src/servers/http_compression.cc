@@ -0,0 +1,379 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/servers/http_compression.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <zlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace nvidia { namespace inferenceserver {
+
+namespace {
+
+// Decompressed data is inflated into extents of at least this size.
+constexpr size_t kMinExtentByteSize = 64 * 1024;
+
+// Extents are at most this size, which zlib can address.
+constexpr size_t kMaxExtentByteSize = 1024 * 1024 * 1024;
+
+// Return the zlib window bits to use for 'compression'. For
+// decompression adding 32 accepts either the zlib or the gzip format,
+// since not all clients send the zlib format for "deflate".
+int
+WindowBits(HTTPCompression compression, bool decompress)
+{
+  if (decompress) {
+    return MAX_WBITS + 32;
+  }
+
+  return (compression == HTTPCompression::GZIP) ? MAX_WBITS + 16 : MAX_WBITS;
+}
+
+std::string
+ZlibMessage(const z_stream& stream)
+{
+  return (stream.msg != nullptr) ? std::string(": ") + stream.msg : "";
+}
+
+// Return the blocks holding the first 'byte_size' bytes of 'buffer',
+// or all its data if 'byte_size' is -1.
+std::vector<struct evbuffer_iovec>
+PeekBuffer(evbuffer* buffer, ev_ssize_t byte_size = -1)
+{
+  std::vector<struct evbuffer_iovec> blocks;
+  int n = evbuffer_peek(buffer, byte_size, NULL, NULL, 0);
+  if (n > 0) {
+    blocks.resize(n);
+    evbuffer_peek(buffer, byte_size, NULL, blocks.data(), n);
+  }
+
+  return blocks;
+}
+
+}  // namespace
+
+Status
+ParseContentEncoding(
+    const char* content_encoding, HTTPCompression* compression)
+{
+  if ((content_encoding == nullptr) || (content_encoding[0] == '\0') ||
+      (strcasecmp(content_encoding, "identity") == 0)) {
+    *compression = HTTPCompression::IDENTITY;
+  } else if (
+      (strcasecmp(content_encoding, "gzip") == 0) ||
+      (strcasecmp(content_encoding, "x-gzip") == 0)) {
+    *compression = HTTPCompression::GZIP;
+  } else if (strcasecmp(content_encoding, "deflate") == 0) {
+    *compression = HTTPCompression::DEFLATE;
+  } else {
+    return Status(
+        RequestStatusCode::UNSUPPORTED,
+        "unsupported Content-Encoding '" + std::string(content_encoding) +
+            "'");
+  }
+
+  return Status::Success;
+}
+
+HTTPCompression
+SelectAcceptEncoding(const char* accept_encoding)
+{
+  if (accept_encoding == nullptr) {
+    return HTTPCompression::IDENTITY;
+  }
+
+  // Each element of the list is a coding optionally followed by
+  // parameters, of which only a zero quality value matters here.
+  bool gzip = false;
+  bool deflate = false;
+  std::string list(accept_encoding);
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+
+    std::string element = list.substr(pos, end - pos);
+    pos = end + 1;
+
+    std::string coding = element.substr(0, element.find(';'));
+    coding.erase(0, coding.find_first_not_of(" \t"));
+    coding.erase(coding.find_last_not_of(" \t") + 1);
+
+    const size_t q = element.find("q=");
+    if ((q != std::string::npos) && (atof(element.c_str() + q + 2) <= 0)) {
+      continue;
+    }
+
+    if ((strcasecmp(coding.c_str(), "gzip") == 0) ||
+        (strcasecmp(coding.c_str(), "x-gzip") == 0) || (coding == "*")) {
+      gzip = true;
+    } else if (strcasecmp(coding.c_str(), "deflate") == 0) {
+      deflate = true;
+    }
+  }
+
+  if (gzip) {
+    return HTTPCompression::GZIP;
+  }
+  if (deflate) {
+    return HTTPCompression::DEFLATE;
+  }
+
+  return HTTPCompression::IDENTITY;
+}
+
+const char*
+ContentEncodingString(HTTPCompression compression)
+{
+  switch (compression) {
+    case HTTPCompression::DEFLATE:
+      return "deflate";
+    case HTTPCompression::GZIP:
+      return "gzip";
+    default:
+      break;
+  }
+
+  return "identity";
+}
+
+Status
+DecompressData(
+    HTTPCompression compression, evbuffer* source, size_t max_byte_size,
+    evbuffer* output)
+{
+  if (compression == HTTPCompression::IDENTITY) {
+    if (evbuffer_get_length(source) > max_byte_size) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          "request body exceeds " + std::to_string(max_byte_size) + " bytes");
+    }
+
+    evbuffer_add_buffer(output, source);
+    return Status::Success;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (inflateInit2(&stream, WindowBits(compression, true)) != Z_OK) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "failed to initialize decompression" + ZlibMessage(stream));
+  }
+
+  const std::vector<struct evbuffer_iovec> blocks = PeekBuffer(source);
+  size_t block_idx = 0;
+  size_t remaining_byte_size = evbuffer_get_length(source);
+  size_t produced_byte_size = 0;
+
+  Status status;
+  int ret = Z_OK;
+  while (status.IsOk() && (ret != Z_STREAM_END)) {
+    // Reserve one byte more than the remaining allowance to detect
+    // data that exceeds it. Otherwise guess from the size of the
+    // compressed data left.
+    const size_t extent_byte_size = std::min(
+        {std::max(kMinExtentByteSize, 4 * remaining_byte_size),
+         max_byte_size - produced_byte_size + 1, kMaxExtentByteSize});
+
+    struct evbuffer_iovec extent;
+    if (evbuffer_reserve_space(output, extent_byte_size, &extent, 1) != 1) {
+      status = Status(
+          RequestStatusCode::INTERNAL,
+          "failed to allocate buffer for decompressed data");
+      break;
+    }
+
+    stream.next_out = reinterpret_cast<Bytef*>(extent.iov_base);
+    stream.avail_out = extent_byte_size;
+    while ((stream.avail_out > 0) && (ret != Z_STREAM_END)) {
+      if (stream.avail_in == 0) {
+        if (block_idx == blocks.size()) {
+          break;
+        }
+
+        stream.next_in = reinterpret_cast<Bytef*>(blocks[block_idx].iov_base);
+        stream.avail_in = blocks[block_idx].iov_len;
+        remaining_byte_size -= blocks[block_idx].iov_len;
+        block_idx++;
+        continue;
+      }
+
+      ret = inflate(&stream, Z_NO_FLUSH);
+      if ((ret != Z_OK) && (ret != Z_STREAM_END)) {
+        status = Status(
+            RequestStatusCode::INVALID_ARG,
+            "failed to decompress request body" + ZlibMessage(stream));
+        break;
+      }
+    }
+
+    extent.iov_len = extent_byte_size - stream.avail_out;
+    evbuffer_commit_space(output, &extent, 1);
+    produced_byte_size += extent.iov_len;
+
+    if (!status.IsOk()) {
+      break;
+    } else if (produced_byte_size > max_byte_size) {
+      status = Status(
+          RequestStatusCode::INVALID_ARG,
+          "decompressed request body exceeds " +
+              std::to_string(max_byte_size) + " bytes");
+    } else if ((ret != Z_STREAM_END) && (stream.avail_out > 0)) {
+      status = Status(
+          RequestStatusCode::INVALID_ARG,
+          "unexpected end of compressed request body");
+    } else if (
+        (ret == Z_STREAM_END) &&
+        ((stream.avail_in > 0) || (block_idx < blocks.size()))) {
+      status = Status(
+          RequestStatusCode::INVALID_ARG,
+          "unexpected data after compressed request body");
+    }
+  }
+
+  inflateEnd(&stream);
+  evbuffer_drain(source, -1);
+
+  return status;
+}
+
+Status
+CompressData(HTTPCompression compression, evbuffer* source, evbuffer* output)
+{
+  if (compression == HTTPCompression::IDENTITY) {
+    evbuffer_add_buffer(output, source);
+    return Status::Success;
+  }
+
+  std::unique_ptr<HTTPCompressor> compressor;
+  RETURN_IF_ERROR(HTTPCompressor::Create(compression, &compressor));
+  return compressor->Compress(
+      source, evbuffer_get_length(source), true /* finish */, output);
+}
+
+struct HTTPCompressor::Stream {
+  z_stream zstream_;
+};
+
+HTTPCompressor::HTTPCompressor(std::unique_ptr<Stream> stream)
+    : stream_(std::move(stream))
+{
+}
+
+HTTPCompressor::~HTTPCompressor()
+{
+  deflateEnd(&stream_->zstream_);
+}
+
+Status
+HTTPCompressor::Create(
+    HTTPCompression compression, std::unique_ptr<HTTPCompressor>* compressor)
+{
+  std::unique_ptr<Stream> stream(new Stream());
+  memset(&stream->zstream_, 0, sizeof(stream->zstream_));
+  if (deflateInit2(
+          &stream->zstream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+          WindowBits(compression, false), 8 /* memLevel */,
+          Z_DEFAULT_STRATEGY) != Z_OK) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "failed to initialize compression" + ZlibMessage(stream->zstream_));
+  }
+
+  compressor->reset(new HTTPCompressor(std::move(stream)));
+  return Status::Success;
+}
+
+Status
+HTTPCompressor::Compress(
+    evbuffer* source, size_t byte_size, bool finish, evbuffer* output)
+{
+  z_stream& stream = stream_->zstream_;
+
+  // Compress the blocks of 'source' in place, each into space
+  // reserved in 'output' that can hold all of it unless the
+  // compressor flushes data held back from previous blocks.
+  size_t remaining_byte_size = std::min(byte_size, evbuffer_get_length(source));
+  const std::vector<struct evbuffer_iovec> blocks =
+      PeekBuffer(source, remaining_byte_size);
+  size_t block_idx = 0;
+
+  int ret = Z_OK;
+  while (true) {
+    while ((stream.avail_in == 0) && (remaining_byte_size > 0)) {
+      const size_t block_byte_size =
+          std::min(remaining_byte_size, blocks[block_idx].iov_len);
+      stream.next_in = reinterpret_cast<Bytef*>(blocks[block_idx].iov_base);
+      stream.avail_in = block_byte_size;
+      remaining_byte_size -= block_byte_size;
+      block_idx++;
+    }
+
+    const bool last = finish && (remaining_byte_size == 0);
+    if ((stream.avail_in == 0) && !last) {
+      break;
+    }
+
+    const size_t extent_byte_size =
+        std::max(kMinExtentByteSize, deflateBound(&stream, stream.avail_in));
+    struct evbuffer_iovec extent;
+    if (evbuffer_reserve_space(output, extent_byte_size, &extent, 1) != 1) {
+      return Status(
+          RequestStatusCode::INTERNAL,
+          "failed to allocate buffer for compressed data");
+    }
+
+    stream.next_out = reinterpret_cast<Bytef*>(extent.iov_base);
+    stream.avail_out = extent_byte_size;
+    ret = deflate(&stream, last ? Z_FINISH : Z_NO_FLUSH);
+
+    extent.iov_len = extent_byte_size - stream.avail_out;
+    evbuffer_commit_space(output, &extent, 1);
+
+    if (ret == Z_STREAM_ERROR) {
+      return Status(
+          RequestStatusCode::INTERNAL,
+          "failed to compress response body" + ZlibMessage(stream));
+    }
+    if (ret == Z_STREAM_END) {
+      break;
+    }
+  }
+
+  evbuffer_drain(source, std::min(byte_size, evbuffer_get_length(source)));
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
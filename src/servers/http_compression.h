@@ -0,0 +1,94 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include "libevent/include/event2/buffer.h"
+#include "src/core/status.h"
+
+namespace nvidia { namespace inferenceserver {
+
+// Content codings supported for HTTP request and response bodies.
+enum class HTTPCompression { IDENTITY, DEFLATE, GZIP };
+
+// Return in 'compression' the content coding named by the
+// Content-Encoding header value 'content_encoding', which may be
+// nullptr if the header is not present. Return error if the coding is
+// not supported.
+Status ParseContentEncoding(
+    const char* content_encoding, HTTPCompression* compression);
+
+// Return the preferred content coding for a response that is
+// acceptable according to the Accept-Encoding header value
+// 'accept_encoding', which may be nullptr if the header is not
+// present. Return IDENTITY if no compression is acceptable.
+HTTPCompression SelectAcceptEncoding(const char* accept_encoding);
+
+// Return the name of 'compression' for the Content-Encoding header.
+const char* ContentEncodingString(HTTPCompression compression);
+
+// Decompress the data in 'source', which is drained, and append it to
+// 'output'. The data is inflated directly into space reserved in
+// 'output' so it is not copied again. Return error if the data is not
+// valid or if more than 'max_byte_size' bytes of decompressed data
+// would be produced.
+Status DecompressData(
+    HTTPCompression compression, evbuffer* source, size_t max_byte_size,
+    evbuffer* output);
+
+// Compress the data in 'source', which is drained, and append it to
+// 'output'.
+Status CompressData(
+    HTTPCompression compression, evbuffer* source, evbuffer* output);
+
+// Compresses a body piece by piece, for bodies that are sent while
+// they are being compressed.
+class HTTPCompressor {
+ public:
+  // Create a compressor for 'compression', which must not be
+  // IDENTITY.
+  static Status Create(
+      HTTPCompression compression, std::unique_ptr<HTTPCompressor>* compressor);
+
+  ~HTTPCompressor();
+
+  // Compress the first 'byte_size' bytes of 'source', which are
+  // drained, and append the compressed data produced so far to
+  // 'output'. The compressor may hold back data until the next call.
+  // If 'finish' is true the end of the body is written, after which
+  // the compressor must not be used again.
+  Status Compress(
+      evbuffer* source, size_t byte_size, bool finish, evbuffer* output);
+
+ private:
+  struct Stream;
+  explicit HTTPCompressor(std::unique_ptr<Stream> stream);
+
+  std::unique_ptr<Stream> stream_;
+};
+
+}}  // namespace nvidia::inferenceserver
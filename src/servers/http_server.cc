@@ -26,19 +26,36 @@
 
 #include "src/servers/http_server.h"
 
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "evhtp/evhtp.h"
 #include "libevent/include/event2/buffer.h"
+#include "libevent/include/event2/bufferevent.h"
 #include "re2/re2.h"
 #include "src/core/backend.h"
+#include "src/core/blob_store.h"
 #include "src/core/constants.h"
 #include "src/core/logging.h"
 #include "src/core/provider_utils.h"
+#include "src/core/request_arena.h"
 #include "src/core/request_status.h"
 #include "src/core/server.h"
+#include "src/nvrpc/ThreadPool.h"
+#include "src/servers/http_compression.h"
+#include "src/servers/unix_socket.h"
 
 namespace nvidia { namespace inferenceserver {
 
@@ -47,12 +64,24 @@ class HTTPServerImpl : public HTTPServer {
  public:
   explicit HTTPServerImpl(
       InferenceServer* server, const std::vector<std::string>& endpoints,
-      int32_t port, int thread_cnt)
+      int32_t port, const std::string& unix_socket_path, int thread_cnt,
+      int work_thread_cnt, int listener_cnt, bool pin_listeners,
+      int compression_threshold, int response_chunk_byte_size)
       : server_(server), endpoint_names_(endpoints), port_(port),
-        thread_cnt_(thread_cnt),
-        api_regex_(R"(/api/(health|profile|infer|status)(.*))"),
+        unix_socket_path_(unix_socket_path),
+        thread_cnt_(thread_cnt), work_thread_cnt_(work_thread_cnt),
+        listener_cnt_(std::max(1, listener_cnt)),
+        pin_listeners_(pin_listeners),
+        compression_threshold_(compression_threshold),
+        response_chunk_byte_size_(std::max(0, response_chunk_byte_size)),
+        api_regex_(
+            R"(/api/(health|profile|infer|multiinfer|status|blob|)"
+            R"(sharedmemory)(.*))"),
         health_regex_(R"(/(live|ready))"),
-        infer_regex_(R"(/([^/]+)(?:/(\d+))?)"), status_regex_(R"(/(.*))")
+        infer_regex_(R"(/([^/]+)(?:/(\d+))?)"), status_regex_(R"(/(.*))"),
+        shm_regex_(
+            R"(/(register|unregister|unregisterall))"
+            R"((?:/([^/]+))?(?:/([^/]+)/(\d{1,19})/(\d{1,19}))?)")
   {
   }
 
@@ -66,15 +95,15 @@ class HTTPServerImpl : public HTTPServer {
  private:
   // Class object associated to evhtp thread, requests received are bounded
   // with the thread that accepts it. Need to keep track of that and let the
-  // corresponding thread send back the reply
+  // corresponding thread send back the reply. The request must already
+  // be paused. The object is created in the request's arena along with
+  // the providers, stats and timer, so it refers to the response
+  // provider by plain pointer.
   class InferRequest {
    public:
     InferRequest(
         evhtp_request_t* req, uint64_t id,
-        const std::shared_ptr<InferRequestProvider>& request_provider,
-        const std::shared_ptr<HTTPInferResponseProvider>& response_provider,
-        const std::shared_ptr<ModelInferStats>& infer_stats,
-        const std::shared_ptr<ModelInferStats::ScopedTimer>& timer);
+        HTTPInferResponseProvider* response_provider);
 
     evhtp_res FinalizeResponse();
 
@@ -84,61 +113,375 @@ class HTTPServerImpl : public HTTPServer {
     evthr_t* thread_;
     uint64_t id_;
     RequestStatus request_status_;
-    std::shared_ptr<InferRequestProvider> request_provider_;
-    std::shared_ptr<HTTPInferResponseProvider> response_provider_;
-    std::shared_ptr<ModelInferStats> infer_stats_;
-    std::shared_ptr<ModelInferStats::ScopedTimer> timer_;
+    HTTPInferResponseProvider* response_provider_;
   };
 
+  // A multi-infer request. Each of its requests is handled like a
+  // single infer request, with its own arena and its own input and
+  // output buffers, and the reply is sent once all of them are
+  // complete. The request must already be paused.
+  class MultiInferRequest {
+   public:
+    MultiInferRequest(evhtp_request_t* req, size_t request_cnt);
+    ~MultiInferRequest();
+
+    // Build the body of the reply from the responses.
+    void FinalizeResponse();
+
+   private:
+    friend class HTTPServerImpl;
+
+    struct Response {
+      uint64_t id_;
+      evbuffer* input_buffer_;
+      evbuffer* output_buffer_;
+      RequestStatus request_status_;
+      InferResponseHeader response_header_;
+    };
+
+    evhtp_request_t* req_;
+    evthr_t* thread_;
+    std::vector<Response> responses_;
+    std::atomic<size_t> pending_cnt_;
+  };
+
+  // Sends the body of the reply to a paused request in chunks with
+  // chunked transfer encoding, compressing each chunk just before it
+  // is sent if requested. The next chunk is handed to the connection
+  // only once it has written most of the previous one, so the
+  // connection never buffers much more than a chunk and a compressed
+  // body is never held in full.
+  class ChunkedReply {
+   public:
+    ChunkedReply(
+        evhtp_request_t* req, evhtp_res code, size_t chunk_byte_size,
+        HTTPCompression compression);
+
+    // Start sending the reply. Deferred to the thread of the
+    // request's connection.
+    static void StartCallback(evthr_t* thr, void* arg, void* shared);
+
+   private:
+    static void WriteCallback(
+        struct evbuffer* buffer, const struct evbuffer_cb_info* info,
+        void* arg);
+    static void ConnectionErrorHook(
+        evhtp_connection_t* conn, evhtp_error_flags errtype, void* arg);
+
+    void SendNextChunk();
+
+    // Stop watching the connection, resume the request and delete
+    // this object. If 'end' is true the end of the body is sent.
+    void Finish(bool end);
+
+    evhtp_request_t* req_;
+    const evhtp_res code_;
+    const size_t chunk_byte_size_;
+    std::unique_ptr<HTTPCompressor> compressor_;
+    struct evbuffer* output_;
+    struct evbuffer_cb_entry* write_cb_;
+  };
+
+  // A reply to a paused request whose body is compressed in full and
+  // then sent. Compression is deferred to the thread of the request's
+  // connection, like the sending of the reply, so that it doesn't
+  // hold up the thread that completed the inference.
+  struct CompressedReply {
+    evhtp_request_t* req_;
+    evhtp_res code_;
+    HTTPCompression compression_;
+
+    static void Callback(evthr_t* thr, void* arg, void* shared);
+  };
+
+  // An infer request whose body is still being received. Only the
+  // URL and the content headers are checked on the connection's
+  // thread when the HTTP headers arrive. The request header is then
+  // parsed and normalized, and the model looked up, while the body is
+  // received, on a work thread if there are any. So a request that
+  // can't succeed has the rest of its body discarded as it arrives
+  // instead of buffered and parsed, and one whose body is larger than
+  // its inputs is rejected as soon as that is known.
+  struct InferUpload {
+    std::shared_ptr<RequestArena> arena_;
+    std::shared_ptr<InferRequestHeader> request_header_;
+    std::shared_ptr<InferenceServer::InferBackendHandle> backend_;
+    RequestOrdinals ordinals_;
+
+    std::string model_name_;
+    int64_t model_version_;
+
+    // Copies of the request header HTTP headers, so that they are
+    // parsed without accessing the request while it is received.
+    std::unique_ptr<std::string> binary_header_;
+    std::string text_header_;
+
+    // The error to reply with once the body is received, if any.
+    Status status_;
+
+    HTTPCompression compression_;
+
+    // The Content-Length of the body, -1 if not given.
+    int64_t content_length_;
+
+    // The size of the input data in the body once decompressed.
+    size_t input_byte_size_;
+
+    // Serializes CheckInferUpload(). 'checked_' is set once the
+    // fields above are final, and is read without the lock by the
+    // body hook.
+    std::mutex mu_;
+    std::atomic<bool> checked_;
+
+    // The number of body bytes received so far.
+    size_t received_byte_size_;
+  };
+
+  static evhtp_res AcceptCallback(evhtp_connection_t* conn, void* arg);
+  static evhtp_res HeadersHook(
+      evhtp_request_t* req, evhtp_headers_t* headers, void* arg);
+  static evhtp_res BodyHook(
+      evhtp_request_t* req, struct evbuffer* buf, void* arg);
+  static evhtp_res RequestFiniHook(evhtp_request_t* req, void* arg);
+
+  // Start an InferUpload for 'req' if it is an infer request, and
+  // check it on a work thread if there are any. Return an error code
+  // to close the connection without reading the body.
+  evhtp_res StartInferUpload(evhtp_request_t* req);
+
+  // Parse and normalize the request header of 'upload' and look up
+  // its model, unless that was already done.
+  void CheckInferUpload(InferUpload* upload);
+
+  // If 'req' is a blob upload whose Content-Length exceeds the blob
+  // store, return an error code to close the connection without
+  // reading the body.
+  evhtp_res CheckBlobUpload(evhtp_request_t* req);
+
+  // Remove and return the InferUpload of 'req', nullptr if it has
+  // none.
+  std::shared_ptr<InferUpload> TakeInferUpload(evhtp_request_t* req);
+
   void Handle(evhtp_request_t* req);
   void HandleHealth(evhtp_request_t* req, const std::string& health_uri);
   void HandleProfile(evhtp_request_t* req, const std::string& profile_uri);
   void HandleInfer(evhtp_request_t* req, const std::string& infer_uri);
+
+  // Parse the header of paused infer request 'req' and issue the
+  // inference. Runs on a work thread if there are any. The reply is
+  // always sent on the thread of the request's connection.
+  // If 'upload' is not nullptr its already parsed header is used.
+  void PrepareInfer(
+      evhtp_request_t* req, const std::shared_ptr<RequestArena>& arena,
+      const std::shared_ptr<ModelInferStats>& infer_stats,
+      const std::string& model_name, int64_t model_version,
+      const std::shared_ptr<InferUpload>& upload);
+
+  // Parse the request header sent in the HTTP headers of infer
+  // request 'req'.
+  static Status ParseInferRequestHeader(
+      evhtp_request_t* req, InferRequestHeader* request_header);
+
+  // Parse the request header sent either serialized, in
+  // 'binary_header' if not nullptr, or in text format in
+  // 'text_header'.
+  static Status ParseInferRequestHeader(
+      const char* binary_header, const char* text_header,
+      InferRequestHeader* request_header);
+
+  void HandleMultiInfer(
+      evhtp_request_t* req, const std::string& multi_infer_uri);
+
+  // Parse the header of paused multi-infer request 'req' and issue
+  // its requests. Runs on a work thread if there are any.
+  void PrepareMultiInfer(evhtp_request_t* req);
+
+  // Issue request 'idx' of 'multi_req'. The response is recorded in
+  // 'multi_req' also if the request fails.
+  void IssueMultiInfer(
+      const std::shared_ptr<MultiInferRequest>& multi_req, size_t idx,
+      MultiInferRequestHeader::Request* request);
+
   void HandleStatus(evhtp_request_t* req, const std::string& status_uri);
+  void HandleBlob(evhtp_request_t* req, const std::string& blob_uri);
+  void HandleSharedMemory(evhtp_request_t* req, const std::string& shm_uri);
 
   // Helper function that utilizes RETURN_IF_ERROR to avoid nested 'if'
   Status InferHelper(
-      std::shared_ptr<ModelInferStats>& infer_stats,
-      std::shared_ptr<ModelInferStats::ScopedTimer>& timer,
+      const std::shared_ptr<RequestArena>& arena,
+      const std::shared_ptr<ModelInferStats>& infer_stats,
       const std::string& model_name, int64_t model_version,
-      InferRequestHeader& request_header, evhtp_request_t* req);
+      const std::shared_ptr<InferRequestHeader>& request_header,
+      const std::shared_ptr<InferUpload>& upload, evhtp_request_t* req);
+
+  // Create the providers for an inference request that takes its
+  // input from 'input_buffer' and writes its output to
+  // 'output_buffer'. If 'body' is not nullptr the input data is first
+  // moved from the start of 'body' to 'input_buffer', which doesn't
+  // copy it, once its size is known from the normalized header. If
+  // 'ordinals' is not nullptr the header is already normalized for
+  // '*backend' and 'ordinals' are its ordinals.
+  Status CreateInferProviders(
+      const std::shared_ptr<RequestArena>& arena,
+      const std::shared_ptr<ModelInferStats>& infer_stats,
+      const std::string& model_name, int64_t model_version,
+      const std::shared_ptr<InferRequestHeader>& request_header,
+      const RequestOrdinals* ordinals, evbuffer* body,
+      evbuffer* input_buffer, evbuffer* output_buffer,
+      std::shared_ptr<InferenceServer::InferBackendHandle>* backend,
+      std::shared_ptr<InferRequestProvider>* request_provider,
+      std::shared_ptr<HTTPInferResponseProvider>* response_provider);
+
+  // Replace the body of 'req' by its decompressed data if the
+  // request has a Content-Encoding. At most 'max_byte_size' bytes of
+  // decompressed data are accepted.
+  static Status DecompressRequestBody(
+      evhtp_request_t* req, size_t max_byte_size);
+
+  // Return the encoding to compress a reply body of 'byte_size' bytes
+  // with, IDENTITY unless 'req' accepts a supported encoding and the
+  // body is at least 'compression_threshold_' bytes.
+  HTTPCompression ResponseCompression(
+      evhtp_request_t* req, size_t byte_size) const;
+
+  // Compress the body of the reply to 'req' with 'compression'. The
+  // body is sent uncompressed if compression fails.
+  static void CompressResponseBody(
+      evhtp_request_t* req, HTTPCompression compression);
+
+  // Send the reply to paused request 'req' on 'thread', the thread of
+  // its connection. Large bodies are sent with ChunkedReply, others
+  // at once, compressed by CompressedReply if requested.
+  void DeferReply(evhtp_request_t* req, evthr_t* thread, evhtp_res code) const;
 
   void FinishInferResponse(const std::shared_ptr<InferRequest>& req);
+  void FinishMultiInferResponse(
+      const std::shared_ptr<MultiInferRequest>& multi_req);
+
+  // Return true if the infer request asks for the binary response
+  // header format.
+  static bool UseBinaryResponseHeader(evhtp_request_t* req);
+
+  // Add 'request_status' and 'response_header' to the reply to
+  // 'req'. In the binary response header format both are serialized
+  // at the start of the body, each preceded by its 4-byte
+  // little-endian size, and only the status code is sent as an HTTP
+  // header. Otherwise they are sent as text in HTTP headers.
+  static void AddInferResponseHeaders(
+      evhtp_request_t* req, bool binary_header,
+      const RequestStatus& request_status,
+      const InferResponseHeader& response_header);
+
+  // Append 'request_status' and 'response_header' to 'buffer' in the
+  // binary response header format.
+  static void AddBinaryResponseHeader(
+      evbuffer* buffer, const RequestStatus& request_status,
+      const InferResponseHeader& response_header);
+
+  // Return the size of the input data of 'request_header' that is
+  // sent in the body of the request.
+  static size_t InputDataByteSize(const InferRequestHeader& request_header);
+
   static void OKReplyCallback(evthr_t* thr, void* arg, void* shared);
   static void BADReplyCallback(evthr_t* thr, void* arg, void* shared);
 
   static void StopCallback(int sock, short events, void* arg);
 
+  // One acceptor of the endpoint port with its own event base and
+  // evhtp threads. When there are multiple listeners they all bind
+  // the port with SO_REUSEPORT and the kernel spreads the incoming
+  // connections across them.
+  struct Listener {
+    evhtp_t* htp_;
+    struct event_base* evbase_;
+    std::thread worker_;
+    int fds_[2];
+    event* break_ev_;
+
+    // The CPUs that the listener threads are pinned to, empty if the
+    // threads are not pinned.
+    std::vector<int> cpus_;
+  };
+
+  Status StartListener(Listener* listener, int thread_cnt);
+
+  // Return the address the server listens on, for messages.
+  std::string Address() const;
+  void StopListener(Listener* listener);
+
+  // Return the CPUs to pin the threads of listener 'idx' to. The CPUs
+  // the process may run on are split into 'listener_cnt_' contiguous
+  // ranges so that, with the usual CPU numbering, the threads of a
+  // listener stay on one NUMA node.
+  std::vector<int> ListenerCpus(int idx) const;
+
+  static void PinThread(pthread_t thread, const std::vector<int>& cpus);
+  static void ListenerThreadInit(evhtp_t* htp, evthr_t* thr, void* arg);
+
   InferenceServer* server_;
   std::vector<std::string> endpoint_names_;
   int32_t port_;
+
+  // The path of the Unix domain socket to listen on instead of
+  // 'port_', empty to listen on 'port_'.
+  std::string unix_socket_path_;
   int thread_cnt_;
+  int work_thread_cnt_;
+  int listener_cnt_;
+  bool pin_listeners_;
+
+  // The minimum size of a response body to compress, negative to never
+  // compress responses.
+  int compression_threshold_;
+
+  // The body of a reply larger than this is sent in chunks of this
+  // size, zero to always send the body at once.
+  size_t response_chunk_byte_size_;
+
   re2::RE2 api_regex_;
   re2::RE2 health_regex_;
   re2::RE2 infer_regex_;
   re2::RE2 status_regex_;
+  re2::RE2 shm_regex_;
 
-  evhtp_t* htp_;
-  struct event_base* evbase_;
-  std::thread worker_;
-  int fds_[2];
-  event* break_ev_;
+  // Threads that prepare infer requests so that the evhtp threads
+  // only read requests and send replies. nullptr if requests are
+  // prepared on the evhtp threads.
+  std::unique_ptr<nvrpc::ThreadPool> work_pool_;
+
+  std::vector<std::unique_ptr<Listener>> listeners_;
+
+  // The infer requests whose body is being received.
+  std::mutex uploads_mu_;
+  std::unordered_map<evhtp_request_t*, std::shared_ptr<InferUpload>>
+      uploads_;
 };
 
 Status
 HTTPServerImpl::Start()
 {
-  if (!worker_.joinable()) {
-    evbase_ = event_base_new();
-    htp_ = evhtp_new(evbase_, NULL);
-    evhtp_set_gencb(htp_, HTTPServerImpl::Dispatch, this);
-    evhtp_use_threads_wexit(htp_, NULL, NULL, thread_cnt_, NULL);
-    evhtp_bind_socket(htp_, "0.0.0.0", port_, 1024);
-    // Set listening event for breaking event loop
-    evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds_);
-    break_ev_ = event_new(evbase_, fds_[0], EV_READ, StopCallback, evbase_);
-    event_add(break_ev_, NULL);
-    worker_ = std::thread(event_base_loop, evbase_, 0);
+  if (listeners_.empty()) {
+    if (work_thread_cnt_ > 0) {
+      work_pool_.reset(new nvrpc::ThreadPool(work_thread_cnt_));
+    }
+
+    // The evhtp threads are divided among the listeners.
+    const int listener_thread_cnt = std::max(1, thread_cnt_ / listener_cnt_);
+    for (int idx = 0; idx < listener_cnt_; ++idx) {
+      std::unique_ptr<Listener> listener(new Listener());
+      if (pin_listeners_) {
+        listener->cpus_ = ListenerCpus(idx);
+      }
+
+      Status status = StartListener(listener.get(), listener_thread_cnt);
+      if (!status.IsOk()) {
+        Stop();
+        return status;
+      }
+
+      listeners_.emplace_back(std::move(listener));
+    }
+
     return Status::Success;
   }
 
@@ -146,25 +489,152 @@ HTTPServerImpl::Start()
       RequestStatusCode::ALREADY_EXISTS, "HTTP server is already running.");
 }
 
+Status
+HTTPServerImpl::StartListener(Listener* listener, int thread_cnt)
+{
+  if (!unix_socket_path_.empty()) {
+    RETURN_IF_ERROR(RemoveStaleUnixSocket(unix_socket_path_));
+  }
+
+  listener->evbase_ = event_base_new();
+  listener->htp_ = evhtp_new(listener->evbase_, NULL);
+  if (listener_cnt_ > 1) {
+    evhtp_enable_flag(listener->htp_, EVHTP_FLAG_ENABLE_REUSEPORT);
+  }
+  evhtp_set_gencb(listener->htp_, HTTPServerImpl::Dispatch, this);
+  evhtp_set_post_accept_cb(listener->htp_, AcceptCallback, this);
+  evhtp_use_threads_wexit(
+      listener->htp_, ListenerThreadInit, NULL, thread_cnt, listener);
+  const int err =
+      unix_socket_path_.empty()
+          ? evhtp_bind_socket(listener->htp_, "0.0.0.0", port_, 1024)
+          : evhtp_bind_socket(
+                listener->htp_, Address().c_str(), 0 /* port */, 1024);
+  if (err != 0) {
+    evhtp_free(listener->htp_);
+    event_base_free(listener->evbase_);
+    return Status(
+        RequestStatusCode::INTERNAL, "failed to bind HTTP at " + Address());
+  }
+
+  // Set listening event for breaking event loop
+  evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, listener->fds_);
+  listener->break_ev_ = event_new(
+      listener->evbase_, listener->fds_[0], EV_READ, StopCallback,
+      listener->evbase_);
+  event_add(listener->break_ev_, NULL);
+  listener->worker_ = std::thread(event_base_loop, listener->evbase_, 0);
+  PinThread(listener->worker_.native_handle(), listener->cpus_);
+
+  return Status::Success;
+}
+
 Status
 HTTPServerImpl::Stop()
 {
-  if (worker_.joinable()) {
-    // Notify event loop to break via fd write
-    send(fds_[1], &evbase_, sizeof(event_base*), 0);
-    worker_.join();
-    event_free(break_ev_);
-    evutil_closesocket(fds_[0]);
-    evutil_closesocket(fds_[1]);
-    evhtp_unbind_socket(htp_);
-    evhtp_free(htp_);
-    event_base_free(evbase_);
+  if (!listeners_.empty()) {
+    // Notify event loops to break via fd write
+    for (auto& listener : listeners_) {
+      send(listener->fds_[1], &listener->evbase_, sizeof(event_base*), 0);
+    }
+    for (auto& listener : listeners_) {
+      listener->worker_.join();
+    }
+
+    // Finish preparing the pending requests while their evhtp threads
+    // are still able to send the replies.
+    work_pool_.reset();
+
+    for (auto& listener : listeners_) {
+      StopListener(listener.get());
+    }
+    listeners_.clear();
     return Status::Success;
   }
 
+  work_pool_.reset();
   return Status(RequestStatusCode::UNAVAILABLE, "HTTP server is not running.");
 }
 
+void
+HTTPServerImpl::StopListener(Listener* listener)
+{
+  event_free(listener->break_ev_);
+  evutil_closesocket(listener->fds_[0]);
+  evutil_closesocket(listener->fds_[1]);
+  evhtp_unbind_socket(listener->htp_);
+  evhtp_free(listener->htp_);
+  event_base_free(listener->evbase_);
+  if (!unix_socket_path_.empty()) {
+    unlink(unix_socket_path_.c_str());
+  }
+}
+
+std::string
+HTTPServerImpl::Address() const
+{
+  if (unix_socket_path_.empty()) {
+    return "0.0.0.0:" + std::to_string(port_);
+  }
+
+  return "unix:" + unix_socket_path_;
+}
+
+std::vector<int>
+HTTPServerImpl::ListenerCpus(int idx) const
+{
+  std::vector<int> available;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpuset)) {
+        available.push_back(cpu);
+      }
+    }
+  }
+
+  if (available.empty()) {
+    return available;
+  }
+
+  // With fewer CPUs than listeners, listeners share a CPU.
+  const size_t cnt = available.size();
+  if (cnt < (size_t)listener_cnt_) {
+    return std::vector<int>{available[idx % cnt]};
+  }
+
+  const size_t begin = (cnt * idx) / listener_cnt_;
+  const size_t end = (cnt * (idx + 1)) / listener_cnt_;
+  return std::vector<int>(available.begin() + begin, available.begin() + end);
+}
+
+void
+HTTPServerImpl::PinThread(pthread_t thread, const std::vector<int>& cpus)
+{
+  if (cpus.empty()) {
+    return;
+  }
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (const int cpu : cpus) {
+    CPU_SET(cpu, &cpuset);
+  }
+
+  const int err = pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset);
+  if (err != 0) {
+    LOG_WARNING << "failed to pin HTTP thread to CPUs: " << strerror(err);
+  }
+}
+
+void
+HTTPServerImpl::ListenerThreadInit(evhtp_t* htp, evthr_t* thr, void* arg)
+{
+  Listener* listener = reinterpret_cast<Listener*>(arg);
+  PinThread(pthread_self(), listener->cpus_);
+}
+
 void
 HTTPServerImpl::StopCallback(int sock, short events, void* arg)
 {
@@ -178,6 +648,228 @@ HTTPServerImpl::Dispatch(evhtp_request_t* req, void* arg)
   (static_cast<HTTPServerImpl*>(arg))->Handle(req);
 }
 
+evhtp_res
+HTTPServerImpl::AcceptCallback(evhtp_connection_t* conn, void* arg)
+{
+  evhtp_connection_set_hook(
+      conn, evhtp_hook_on_headers, (evhtp_hook)HeadersHook, arg);
+  return EVHTP_RES_OK;
+}
+
+evhtp_res
+HTTPServerImpl::HeadersHook(
+    evhtp_request_t* req, evhtp_headers_t* headers, void* arg)
+{
+  HTTPServerImpl* server = static_cast<HTTPServerImpl*>(arg);
+  const evhtp_res res = server->CheckBlobUpload(req);
+  if (res != EVHTP_RES_OK) {
+    return res;
+  }
+
+  return server->StartInferUpload(req);
+}
+
+evhtp_res
+HTTPServerImpl::BodyHook(
+    evhtp_request_t* req, struct evbuffer* buf, void* arg)
+{
+  InferUpload* upload = static_cast<InferUpload*>(arg);
+  upload->received_byte_size_ += evbuffer_get_length(buf);
+
+  // Until the upload is checked the body is kept as it arrives.
+  if (!upload->checked_.load(std::memory_order_acquire)) {
+    return EVHTP_RES_OK;
+  }
+
+  // The body of a failed request is not needed, it is dropped rather
+  // than added to the request. An uncompressed body must hold exactly
+  // the input data, so one that is announced or received larger is
+  // rejected without reading the rest of it.
+  if (!upload->status_.IsOk()) {
+    evbuffer_drain(buf, -1);
+  } else if (
+      (upload->compression_ == HTTPCompression::IDENTITY) &&
+      ((upload->content_length_ >
+        static_cast<int64_t>(upload->input_byte_size_)) ||
+       (upload->received_byte_size_ > upload->input_byte_size_))) {
+    LOG_VERBOSE(1) << "Infer failed: request body is larger than the "
+                   << upload->input_byte_size_ << " bytes of input data";
+    return EVHTP_RES_DATA_TOO_LONG;
+  }
+
+  return EVHTP_RES_OK;
+}
+
+evhtp_res
+HTTPServerImpl::RequestFiniHook(evhtp_request_t* req, void* arg)
+{
+  // Drop the upload of a request that is freed before its body is
+  // complete.
+  (static_cast<HTTPServerImpl*>(arg))->TakeInferUpload(req);
+  return EVHTP_RES_OK;
+}
+
+evhtp_res
+HTTPServerImpl::StartInferUpload(evhtp_request_t* req)
+{
+  std::string endpoint, rest, model_name, model_version_str;
+  if ((req->method != htp_method_POST) ||
+      !RE2::FullMatch(
+          std::string(req->uri->path->full), api_regex_, &endpoint, &rest) ||
+      (endpoint != "infer") ||
+      (std::find(endpoint_names_.begin(), endpoint_names_.end(), "infer") ==
+       endpoint_names_.end()) ||
+      !RE2::FullMatch(rest, infer_regex_, &model_name, &model_version_str)) {
+    return EVHTP_RES_OK;
+  }
+
+  int64_t model_version = -1;
+  if (!model_version_str.empty()) {
+    model_version = std::atoll(model_version_str.c_str());
+  }
+
+  std::shared_ptr<InferUpload> upload = std::make_shared<InferUpload>();
+  upload->arena_ = std::make_shared<RequestArena>();
+  upload->request_header_ = RequestArena::Borrow(
+      upload->arena_->NewMessage<InferRequestHeader>());
+  upload->model_name_ = model_name;
+  upload->model_version_ = model_version;
+  upload->compression_ = HTTPCompression::IDENTITY;
+  upload->content_length_ = -1;
+  upload->input_byte_size_ = 0;
+  upload->checked_ = false;
+  upload->received_byte_size_ = 0;
+
+  const char* binary_header =
+      evhtp_kv_find(req->headers_in, kInferRequestBinaryHTTPHeader);
+  if (binary_header != nullptr) {
+    upload->binary_header_.reset(new std::string(binary_header));
+  }
+  const char* text_header =
+      evhtp_kv_find(req->headers_in, kInferRequestHTTPHeader);
+  if (text_header != nullptr) {
+    upload->text_header_ = text_header;
+  }
+
+  upload->status_ = ParseContentEncoding(
+      evhtp_kv_find(req->headers_in, "Content-Encoding"),
+      &upload->compression_);
+
+  const char* content_length_c_str =
+      evhtp_kv_find(req->headers_in, "Content-Length");
+  if (content_length_c_str != nullptr) {
+    upload->content_length_ = static_cast<int64_t>(
+        std::min<uint64_t>(
+            std::strtoull(content_length_c_str, nullptr, 10), INT64_MAX));
+  }
+
+  evhtp_request_set_hook(
+      req, evhtp_hook_on_read, (evhtp_hook)BodyHook, upload.get());
+  evhtp_request_set_hook(
+      req, evhtp_hook_on_request_fini, (evhtp_hook)RequestFiniHook, this);
+
+  // Parsing the request header and looking up the model is left to a
+  // work thread so that it doesn't hold up the other connections of
+  // this thread. Without work threads that work is done on this
+  // thread in any case, so it is done right away.
+  if (work_pool_ != nullptr) {
+    work_pool_->enqueue([this, upload]() { CheckInferUpload(upload.get()); });
+  } else {
+    CheckInferUpload(upload.get());
+  }
+
+  std::lock_guard<std::mutex> lock(uploads_mu_);
+  uploads_.emplace(req, std::move(upload));
+  return EVHTP_RES_OK;
+}
+
+void
+HTTPServerImpl::CheckInferUpload(InferUpload* upload)
+{
+  std::lock_guard<std::mutex> lock(upload->mu_);
+  if (upload->checked_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  Status status = upload->status_;
+  if (status.IsOk()) {
+    status = ParseInferRequestHeader(
+        (upload->binary_header_ != nullptr) ? upload->binary_header_->c_str()
+                                            : nullptr,
+        upload->text_header_.c_str(), upload->request_header_.get());
+  }
+  if (status.IsOk()) {
+    status = InferenceServer::InferBackendHandle::Create(
+        server_, upload->model_name_, upload->model_version_,
+        &upload->backend_);
+  }
+  if (status.IsOk()) {
+    status = NormalizeRequestHeader(
+        *(upload->backend_->GetInferenceBackend()), *upload->request_header_,
+        &upload->ordinals_);
+  }
+  if (status.IsOk()) {
+    upload->input_byte_size_ = InputDataByteSize(*upload->request_header_);
+  }
+
+  // An uncompressed body that is announced smaller than the input
+  // data is discarded. One that is announced larger is rejected by
+  // the body hook.
+  if (status.IsOk() && (upload->compression_ == HTTPCompression::IDENTITY) &&
+      (upload->content_length_ >= 0) &&
+      (static_cast<uint64_t>(upload->content_length_) <
+       upload->input_byte_size_)) {
+    status = Status(
+        RequestStatusCode::INVALID_ARG,
+        "request body of " + std::to_string(upload->content_length_) +
+            " bytes is smaller than the " +
+            std::to_string(upload->input_byte_size_) +
+            " bytes of input data");
+  }
+
+  upload->status_ = status;
+  upload->checked_.store(true, std::memory_order_release);
+}
+
+evhtp_res
+HTTPServerImpl::CheckBlobUpload(evhtp_request_t* req)
+{
+  std::string endpoint, rest;
+  const char* content_length_c_str =
+      evhtp_kv_find(req->headers_in, "Content-Length");
+  if ((req->method != htp_method_POST) || (content_length_c_str == nullptr) ||
+      !RE2::FullMatch(
+          std::string(req->uri->path->full), api_regex_, &endpoint, &rest) ||
+      (endpoint != "blob")) {
+    return EVHTP_RES_OK;
+  }
+
+  const uint64_t content_length =
+      std::strtoull(content_length_c_str, nullptr, 10);
+  const Status status = BlobStore::CheckByteSize(content_length);
+  if (status.Code() == RequestStatusCode::INVALID_ARG) {
+    LOG_VERBOSE(1) << "Blob upload failed: " << status.Message();
+    return EVHTP_RES_DATA_TOO_LONG;
+  }
+
+  return EVHTP_RES_OK;
+}
+
+std::shared_ptr<HTTPServerImpl::InferUpload>
+HTTPServerImpl::TakeInferUpload(evhtp_request_t* req)
+{
+  std::shared_ptr<InferUpload> upload;
+
+  std::lock_guard<std::mutex> lock(uploads_mu_);
+  auto itr = uploads_.find(req);
+  if (itr != uploads_.end()) {
+    upload = std::move(itr->second);
+    uploads_.erase(itr);
+  }
+
+  return upload;
+}
+
 void
 HTTPServerImpl::Handle(evhtp_request_t* req)
 {
@@ -215,6 +907,29 @@ HTTPServerImpl::Handle(evhtp_request_t* req)
       HandleInfer(req, rest);
       return;
     }
+    // multiinfer
+    if (endpoint == "multiinfer" &&
+        (std::find(
+             endpoint_names_.begin(), endpoint_names_.end(), "multiinfer") !=
+         endpoint_names_.end())) {
+      HandleMultiInfer(req, rest);
+      return;
+    }
+    // blob
+    if (endpoint == "blob" &&
+        (std::find(endpoint_names_.begin(), endpoint_names_.end(), "blob") !=
+         endpoint_names_.end())) {
+      HandleBlob(req, rest);
+      return;
+    }
+    // sharedmemory
+    if (endpoint == "sharedmemory" &&
+        (std::find(
+             endpoint_names_.begin(), endpoint_names_.end(), "sharedmemory") !=
+         endpoint_names_.end())) {
+      HandleSharedMemory(req, rest);
+      return;
+    }
   }
 
   LOG_VERBOSE(1) << "HTTP error: " << req->method << " " << req->uri->path->full
@@ -313,89 +1028,387 @@ HTTPServerImpl::HandleInfer(evhtp_request_t* req, const std::string& infer_uri)
     model_version = std::atoll(model_version_str.c_str());
   }
 
-  auto infer_stats =
-      std::make_shared<ModelInferStats>(server_->StatusManager(), model_name);
-  auto timer = std::make_shared<ModelInferStats::ScopedTimer>();
-  infer_stats->StartRequestTimer(timer.get());
+  // All the objects needed to handle the request are created in the
+  // arena, which is released once the last of them is released. The
+  // arena of an upload already holds the parsed request header.
+  std::shared_ptr<InferUpload> upload = TakeInferUpload(req);
+  auto arena = (upload != nullptr) ? upload->arena_
+                                   : std::make_shared<RequestArena>();
+  auto infer_stats = RequestArena::MakeShared<ModelInferStats>(
+      arena, server_->StatusManager(), model_name);
+  auto timer = arena->New<ModelInferStats::ScopedTimer>();
+  infer_stats->StartRequestTimer(timer);
   infer_stats->SetRequestedVersion(model_version);
 
-  absl::string_view infer_request_header = absl::string_view(
-      evhtp_kv_find(req->headers_in, kInferRequestHTTPHeader));
-  std::string infer_request_header_str(
-      infer_request_header.data(), infer_request_header.size());
+  // The reply is sent later, from PrepareInfer() or when the inference
+  // completes.
+  evhtp_request_pause(req);
+
+  if (work_pool_ != nullptr) {
+    work_pool_->enqueue([this, req, arena, infer_stats, model_name,
+                         model_version, upload]() {
+      PrepareInfer(
+          req, arena, infer_stats, model_name, model_version, upload);
+    });
+  } else {
+    PrepareInfer(req, arena, infer_stats, model_name, model_version, upload);
+  }
+}
 
-  InferRequestHeader request_header;
-  google::protobuf::TextFormat::ParseFromString(
-      infer_request_header_str, &request_header);
+void
+HTTPServerImpl::PrepareInfer(
+    evhtp_request_t* req, const std::shared_ptr<RequestArena>& arena,
+    const std::shared_ptr<ModelInferStats>& infer_stats,
+    const std::string& model_name, int64_t model_version,
+    const std::shared_ptr<InferUpload>& upload)
+{
+  // The header is shared by the providers, which are in the same
+  // arena.
+  std::shared_ptr<InferRequestHeader> request_header;
+  Status status;
+  if (upload != nullptr) {
+    CheckInferUpload(upload.get());
+    request_header = upload->request_header_;
+    status = upload->status_;
+    if (status.IsOk()) {
+      status = DecompressRequestBody(req, upload->input_byte_size_);
+    }
+  } else {
+    request_header =
+        RequestArena::Borrow(arena->NewMessage<InferRequestHeader>());
+    status = DecompressRequestBody(req, MAX_HTTP_DECOMPRESSED_BODY_SIZE);
+    if (status.IsOk()) {
+      status = ParseInferRequestHeader(req, request_header.get());
+    }
+  }
 
-  Status status = InferHelper(
-      infer_stats, timer, model_name, model_version, request_header, req);
+  if (status.IsOk()) {
+    status = InferHelper(
+        arena, infer_stats, model_name, model_version, request_header, upload,
+        req);
+  }
 
   if (!status.IsOk()) {
     RequestStatus request_status;
     InferResponseHeader response_header;
-    response_header.set_id(request_header.id());
-    evhtp_headers_add_header(
-        req->headers_out,
-        evhtp_header_new(
-            kInferResponseHTTPHeader,
-            response_header.ShortDebugString().c_str(), 1, 1));
+    response_header.set_id(request_header->id());
     LOG_VERBOSE(1) << "Infer failed: " << status.Message();
     infer_stats->SetFailed(true);
     RequestStatusFactory::Create(
         &request_status, 0 /* request_id */, server_->Id(), status);
 
-    // this part still needs to be implemented in the completer
-    evhtp_headers_add_header(
-        req->headers_out, evhtp_header_new(
-                              kStatusHTTPHeader,
-                              request_status.ShortDebugString().c_str(), 1, 1));
-    evhtp_headers_add_header(
-        req->headers_out,
-        evhtp_header_new("Content-Type", "application/octet-stream", 1, 1));
+    evbuffer_drain(req->buffer_out, -1);
+    AddInferResponseHeaders(
+        req, UseBinaryResponseHeader(req), request_status, response_header);
 
-    evhtp_send_reply(
-        req, (request_status.code() == RequestStatusCode::SUCCESS)
-                 ? EVHTP_RES_OK
-                 : EVHTP_RES_BADREQ);
+    evthr_t* thread = evhtp_request_get_connection(req)->thread;
+    evthr_defer(thread, BADReplyCallback, req);
   }
 }
 
-void
-HTTPServerImpl::HandleStatus(
-    evhtp_request_t* req, const std::string& status_uri)
+Status
+HTTPServerImpl::ParseInferRequestHeader(
+    evhtp_request_t* req, InferRequestHeader* request_header)
 {
-  ServerStatTimerScoped timer(
-      server_->StatusManager(), ServerStatTimerScoped::Kind::STATUS);
+  return ParseInferRequestHeader(
+      evhtp_kv_find(req->headers_in, kInferRequestBinaryHTTPHeader),
+      evhtp_kv_find(req->headers_in, kInferRequestHTTPHeader),
+      request_header);
+}
 
-  if (req->method != htp_method_GET) {
+Status
+HTTPServerImpl::ParseInferRequestHeader(
+    const char* binary_header, const char* text_header,
+    InferRequestHeader* request_header)
+{
+  // The request header is sent either serialized and base64 encoded,
+  // which is much cheaper to parse, or in text format.
+  if (binary_header != nullptr) {
+    std::string serialized;
+    if (!absl::Base64Unescape(binary_header, &serialized) ||
+        !request_header->ParseFromString(serialized)) {
+      return Status(
+          RequestStatusCode::INVALID_ARG,
+          std::string("failed to parse ") + kInferRequestBinaryHTTPHeader +
+              " header");
+    }
+  } else {
+    absl::string_view infer_request_header =
+        absl::string_view((text_header != nullptr) ? text_header : "");
+    google::protobuf::io::ArrayInputStream header_stream(
+        infer_request_header.data(), infer_request_header.size());
+    google::protobuf::TextFormat::Parse(&header_stream, request_header);
+  }
+
+  return Status::Success;
+}
+
+void
+HTTPServerImpl::HandleMultiInfer(
+    evhtp_request_t* req, const std::string& multi_infer_uri)
+{
+  if (req->method != htp_method_POST) {
     evhtp_send_reply(req, EVHTP_RES_METHNALLOWED);
     return;
   }
 
-  std::string model_name;
-  if (!status_uri.empty()) {
-    if (!RE2::FullMatch(status_uri, status_regex_, &model_name)) {
-      evhtp_send_reply(req, EVHTP_RES_BADREQ);
-      return;
-    }
+  if (!multi_infer_uri.empty() && (multi_infer_uri != "/")) {
+    evhtp_send_reply(req, EVHTP_RES_BADREQ);
+    return;
   }
 
-  RequestStatus request_status;
-  ServerStatus server_status;
-  server_->HandleStatus(&request_status, &server_status, model_name);
+  // The reply is sent once all the requests are complete.
+  evhtp_request_pause(req);
 
-  // If got status successfully then send it...
-  if (request_status.code() == RequestStatusCode::SUCCESS) {
-    std::string format;
-    const char* format_c_str = evhtp_kv_find(req->uri->query, "format");
-    if (format_c_str != NULL) {
-      format = std::string(format_c_str);
-    } else {
-      format = "text";
-    }
+  if (work_pool_ != nullptr) {
+    work_pool_->enqueue([this, req]() { PrepareMultiInfer(req); });
+  } else {
+    PrepareMultiInfer(req);
+  }
+}
 
-    std::string server_status_str;
+void
+HTTPServerImpl::PrepareMultiInfer(evhtp_request_t* req)
+{
+  // Like the infer request header, the multi-infer request header is
+  // sent either serialized and base64 encoded or in text format.
+  MultiInferRequestHeader multi_header;
+  bool parsed = false;
+  const char* binary_header =
+      evhtp_kv_find(req->headers_in, kMultiInferRequestBinaryHTTPHeader);
+  if (binary_header != nullptr) {
+    std::string serialized;
+    parsed = absl::Base64Unescape(binary_header, &serialized) &&
+             multi_header.ParseFromString(serialized);
+  } else {
+    const char* text_header =
+        evhtp_kv_find(req->headers_in, kMultiInferRequestHTTPHeader);
+    parsed = (text_header != nullptr) &&
+             google::protobuf::TextFormat::ParseFromString(
+                 text_header, &multi_header);
+  }
+
+  Status status = DecompressRequestBody(req, MAX_HTTP_DECOMPRESSED_BODY_SIZE);
+  if (!status.IsOk()) {
+    // Reported below.
+  } else if (!parsed) {
+    status = Status(
+        RequestStatusCode::INVALID_ARG,
+        "failed to parse multi-infer request header");
+  } else if (multi_header.request_size() == 0) {
+    status = Status(
+        RequestStatusCode::INVALID_ARG,
+        "multi-infer request must contain at least one request");
+  }
+
+  if (!status.IsOk()) {
+    LOG_VERBOSE(1) << "Multi-infer failed: " << status.Message();
+    RequestStatus request_status;
+    RequestStatusFactory::Create(
+        &request_status, 0 /* request_id */, server_->Id(), status);
+    evhtp_headers_add_header(
+        req->headers_out,
+        evhtp_header_new(
+            kStatusHTTPHeader, request_status.ShortDebugString().c_str(), 1,
+            1));
+
+    evthr_t* thread = evhtp_request_get_connection(req)->thread;
+    evthr_defer(thread, BADReplyCallback, req);
+    return;
+  }
+
+  auto multi_req =
+      std::make_shared<MultiInferRequest>(req, multi_header.request_size());
+
+  // Issue all the requests as a group so that, once they are all
+  // issued, the models schedule the requests they are holding for a
+  // dynamic batch without waiting for more.
+  InferenceServer::InferGroup group(server_);
+  for (const auto& request : multi_header.request()) {
+    group.AddModel(request.model_name(), request.model_version());
+  }
+
+  for (int idx = 0; idx < multi_header.request_size(); ++idx) {
+    IssueMultiInfer(multi_req, idx, multi_header.mutable_request(idx));
+  }
+}
+
+void
+HTTPServerImpl::IssueMultiInfer(
+    const std::shared_ptr<MultiInferRequest>& multi_req, size_t idx,
+    MultiInferRequestHeader::Request* request)
+{
+  MultiInferRequest::Response* response = &multi_req->responses_[idx];
+  response->id_ = request->meta_data().id();
+
+  // Same as a single infer request, except that the arena also keeps
+  // the multi-infer request, and so the input data, alive as long as
+  // the providers.
+  auto arena = std::make_shared<RequestArena>();
+  arena->New<std::shared_ptr<MultiInferRequest>>(multi_req);
+  auto infer_stats = RequestArena::MakeShared<ModelInferStats>(
+      arena, server_->StatusManager(), request->model_name());
+  auto timer = arena->New<ModelInferStats::ScopedTimer>();
+  infer_stats->StartRequestTimer(timer);
+  infer_stats->SetRequestedVersion(request->model_version());
+
+  auto request_header =
+      RequestArena::Borrow(arena->New<InferRequestHeader>());
+  request_header->Swap(request->mutable_meta_data());
+
+  // The requests take their input data from the start of the body in
+  // turn.
+  evbuffer* body = multi_req->req_->buffer_in;
+  const size_t body_byte_size = evbuffer_get_length(body);
+
+  std::shared_ptr<InferenceServer::InferBackendHandle> backend;
+  std::shared_ptr<InferRequestProvider> request_provider;
+  std::shared_ptr<HTTPInferResponseProvider> response_provider;
+  Status status = CreateInferProviders(
+      arena, infer_stats, request->model_name(), request->model_version(),
+      request_header, nullptr /* ordinals */, body, response->input_buffer_,
+      response->output_buffer_, &backend, &request_provider,
+      &response_provider);
+  if (status.IsOk()) {
+    server_->HandleInfer(
+        &response->request_status_, backend, request_provider,
+        response_provider, infer_stats,
+        [this, multi_req, response, response_provider, timer]() {
+          if (response->request_status_.code() ==
+              RequestStatusCode::SUCCESS) {
+            response->response_header_.Swap(
+                response_provider->MutableResponseHeader());
+          }
+
+          timer->Stop();
+          if (multi_req->pending_cnt_.fetch_sub(1) == 1) {
+            FinishMultiInferResponse(multi_req);
+          }
+        });
+    return;
+  }
+
+  // If the request failed before taking its input data then skip the
+  // data as given in its header so that the following requests find
+  // theirs.
+  if (evbuffer_get_length(body) == body_byte_size) {
+    evbuffer_remove_buffer(
+        body, response->input_buffer_, InputDataByteSize(*request_header));
+  }
+
+  LOG_VERBOSE(1) << "Infer failed: " << status.Message();
+  infer_stats->SetFailed(true);
+  RequestStatusFactory::Create(
+      &response->request_status_, 0 /* request_id */, server_->Id(), status);
+  if (multi_req->pending_cnt_.fetch_sub(1) == 1) {
+    FinishMultiInferResponse(multi_req);
+  }
+}
+
+void
+HTTPServerImpl::HandleStatus(
+    evhtp_request_t* req, const std::string& status_uri)
+{
+  ServerStatTimerScoped timer(
+      server_->StatusManager(), ServerStatTimerScoped::Kind::STATUS);
+
+  if (req->method != htp_method_GET) {
+    evhtp_send_reply(req, EVHTP_RES_METHNALLOWED);
+    return;
+  }
+
+  std::string model_name;
+  if (!status_uri.empty()) {
+    if (!RE2::FullMatch(status_uri, status_regex_, &model_name)) {
+      evhtp_send_reply(req, EVHTP_RES_BADREQ);
+      return;
+    }
+  }
+
+  // The models and the model status fields to return, each as a
+  // comma-separated list.
+  std::vector<std::string> model_names, fields;
+  if (!model_name.empty()) {
+    model_names.push_back(model_name);
+  }
+  const char* models_c_str = evhtp_kv_find(req->uri->query, "models");
+  if (models_c_str != NULL) {
+    for (const auto& name :
+         absl::StrSplit(models_c_str, ',', absl::SkipWhitespace())) {
+      model_names.emplace_back(name);
+    }
+  }
+  const char* fields_c_str = evhtp_kv_find(req->uri->query, "fields");
+  if (fields_c_str != NULL) {
+    fields = absl::StrSplit(fields_c_str, ',', absl::SkipWhitespace());
+  }
+
+  RequestStatus request_status;
+  std::shared_ptr<const ServerStatusSnapshot> snapshot;
+  ServerReadyState ready_state;
+  uint64_t uptime_ns;
+  server_->HandleStatus(&request_status, &snapshot, &ready_state, &uptime_ns);
+
+  // Unless the whole status is requested copy the requested parts of
+  // the snapshot.
+  ServerStatus server_status;
+  const bool whole_status = model_names.empty() && fields.empty();
+  if ((request_status.code() == RequestStatusCode::SUCCESS) &&
+      !whole_status) {
+    Status status = snapshot->Filter(model_names, fields, &server_status);
+    if (!status.IsOk()) {
+      RequestStatusFactory::Create(
+          &request_status, request_status.request_id(), server_->Id(),
+          status);
+    }
+  }
+
+  // If got status successfully then send it, unless the client
+  // already has this generation. The tag is weak because the uptime
+  // differs between responses with the same generation.
+  if (request_status.code() == RequestStatusCode::SUCCESS) {
+    const std::string etag =
+        "W/\"" + std::to_string(snapshot->Generation()) + "\"";
+    evhtp_headers_add_header(
+        req->headers_out, evhtp_header_new("ETag", etag.c_str(), 0, 1));
+
+    const char* if_none_match =
+        evhtp_kv_find(req->headers_in, "If-None-Match");
+    if ((if_none_match != NULL) &&
+        ((strcmp(if_none_match, "*") == 0) ||
+         (strstr(if_none_match, etag.c_str() + 2) != NULL))) {
+      evhtp_send_reply(req, EVHTP_RES_NOTMOD);
+      return;
+    }
+
+    std::string format;
+    const char* format_c_str = evhtp_kv_find(req->uri->query, "format");
+    if (format_c_str != NULL) {
+      format = std::string(format_c_str);
+    } else {
+      format = "text";
+    }
+
+    // The ready state and uptime are not part of the snapshot. Both
+    // formats allow appending them to the serialized snapshot, which
+    // is then sent without copying it.
+    if (whole_status) {
+      const std::string& snapshot_str = (format == "binary")
+                                            ? snapshot->Serialized()
+                                            : snapshot->DebugString();
+      evbuffer_add_reference(
+          req->buffer_out, snapshot_str.data(), snapshot_str.size(),
+          [](const void* data, size_t len, void* arg) {
+            delete reinterpret_cast<
+                std::shared_ptr<const ServerStatusSnapshot>*>(arg);
+          },
+          new std::shared_ptr<const ServerStatusSnapshot>(snapshot));
+    }
+
+    server_status.set_ready_state(ready_state);
+    server_status.set_uptime_ns(uptime_ns);
+
+    std::string server_status_str;
     if (format == "binary") {
       server_status.SerializeToString(&server_status_str);
       evbuffer_add(
@@ -421,47 +1434,174 @@ HTTPServerImpl::HandleStatus(
                : EVHTP_RES_BADREQ);
 }
 
+void
+HTTPServerImpl::HandleBlob(evhtp_request_t* req, const std::string& blob_uri)
+{
+  if (req->method != htp_method_POST) {
+    evhtp_send_reply(req, EVHTP_RES_METHNALLOWED);
+    return;
+  }
+
+  if (!blob_uri.empty() && (blob_uri != "/")) {
+    evhtp_send_reply(req, EVHTP_RES_BADREQ);
+    return;
+  }
+
+  // Check the upload fits in the blob store before making a copy of
+  // it. The blob outlives the request so the body must be copied out
+  // of the evbuffer.
+  RequestStatus request_status;
+  std::string blob_key;
+  const size_t byte_size = evbuffer_get_length(req->buffer_in);
+  const Status status = BlobStore::CheckByteSize(byte_size);
+  if (status.IsOk()) {
+    auto blob = std::make_shared<AllocatedSystemMemory>(byte_size);
+    evbuffer_copyout(req->buffer_in, blob->MutableBuffer(), byte_size);
+    server_->HandleBlobUpload(&request_status, blob, &blob_key);
+  } else {
+    RequestStatusFactory::Create(
+        &request_status, 0 /* request_id */, server_->Id(), status);
+  }
+
+  if (request_status.code() == RequestStatusCode::SUCCESS) {
+    evhtp_headers_add_header(
+        req->headers_out,
+        evhtp_header_new(kBlobKeyHTTPHeader, blob_key.c_str(), 1, 1));
+  }
+
+  evhtp_headers_add_header(
+      req->headers_out,
+      evhtp_header_new(
+          kStatusHTTPHeader, request_status.ShortDebugString().c_str(), 1, 1));
+
+  evhtp_send_reply(
+      req, (request_status.code() == RequestStatusCode::SUCCESS)
+               ? EVHTP_RES_OK
+               : EVHTP_RES_BADREQ);
+}
+
+void
+HTTPServerImpl::HandleSharedMemory(
+    evhtp_request_t* req, const std::string& shm_uri)
+{
+  if (req->method != htp_method_POST) {
+    evhtp_send_reply(req, EVHTP_RES_METHNALLOWED);
+    return;
+  }
+
+  // /register/<name>/<shm_key>/<offset>/<byte_size>
+  // /unregister/<name>
+  // /unregisterall
+  std::string action, name, shm_key, offset_str, byte_size_str;
+  if (!RE2::FullMatch(
+          shm_uri, shm_regex_, &action, &name, &shm_key, &offset_str,
+          &byte_size_str)) {
+    evhtp_send_reply(req, EVHTP_RES_BADREQ);
+    return;
+  }
+
+  RequestStatus request_status;
+  if ((action == "register") && !name.empty() && !shm_key.empty()) {
+    server_->HandleRegisterSharedMemory(
+        &request_status, name, shm_key, std::stoull(offset_str),
+        std::stoull(byte_size_str));
+  } else if ((action == "unregister") && !name.empty() && shm_key.empty()) {
+    server_->HandleUnregisterSharedMemory(&request_status, name);
+  } else if ((action == "unregisterall") && name.empty()) {
+    server_->HandleUnregisterAllSharedMemory(&request_status);
+  } else {
+    evhtp_send_reply(req, EVHTP_RES_BADREQ);
+    return;
+  }
+
+  evhtp_headers_add_header(
+      req->headers_out,
+      evhtp_header_new(
+          kStatusHTTPHeader, request_status.ShortDebugString().c_str(), 1, 1));
+
+  evhtp_send_reply(
+      req, (request_status.code() == RequestStatusCode::SUCCESS)
+               ? EVHTP_RES_OK
+               : EVHTP_RES_BADREQ);
+}
+
 Status
 HTTPServerImpl::InferHelper(
-    std::shared_ptr<ModelInferStats>& infer_stats,
-    std::shared_ptr<ModelInferStats::ScopedTimer>& timer,
+    const std::shared_ptr<RequestArena>& arena,
+    const std::shared_ptr<ModelInferStats>& infer_stats,
     const std::string& model_name, int64_t model_version,
-    InferRequestHeader& request_header, evhtp_request_t* req)
+    const std::shared_ptr<InferRequestHeader>& request_header,
+    const std::shared_ptr<InferUpload>& upload, evhtp_request_t* req)
 {
   std::shared_ptr<InferenceServer::InferBackendHandle> backend = nullptr;
-  RETURN_IF_ERROR(InferenceServer::InferBackendHandle::Create(
-      server_, model_name, model_version, &backend));
-  infer_stats->SetMetricReporter(
-      backend->GetInferenceBackend()->MetricReporter());
-
-  std::unordered_map<std::string, std::shared_ptr<SystemMemory>> input_map;
-  RETURN_IF_ERROR(
-      NormalizeRequestHeader(*backend->GetInferenceBackend(), request_header));
-  RETURN_IF_ERROR(EVBufferToInputMap(
-      model_name, request_header, req->buffer_in, input_map));
+  const RequestOrdinals* ordinals = nullptr;
+  if (upload != nullptr) {
+    backend = upload->backend_;
+    ordinals = &upload->ordinals_;
+  }
 
   std::shared_ptr<InferRequestProvider> request_provider;
-  RETURN_IF_ERROR(InferRequestProvider::Create(
-      model_name, model_version, request_header, input_map, &request_provider));
-  infer_stats->SetBatchSize(request_provider->RequestHeader().batch_size());
-
   std::shared_ptr<HTTPInferResponseProvider> response_provider;
-  RETURN_IF_ERROR(HTTPInferResponseProvider::Create(
-      req->buffer_out, *backend->GetInferenceBackend(),
-      request_provider->RequestHeader(),
-      backend->GetInferenceBackend()->GetLabelProvider(), &response_provider));
+  RETURN_IF_ERROR(CreateInferProviders(
+      arena, infer_stats, model_name, model_version, request_header,
+      ordinals, nullptr /* body */, req->buffer_in, req->buffer_out,
+      &backend, &request_provider, &response_provider));
 
-  std::shared_ptr<InferRequest> request(new InferRequest(
-      req, request_header.id(), request_provider, response_provider,
-      infer_stats, timer));
+  auto request = RequestArena::MakeShared<InferRequest>(
+      arena, req, request_header->id(), response_provider.get());
   server_->HandleInfer(
-      &(request->request_status_), backend, request->request_provider_,
-      request->response_provider_, infer_stats,
+      &(request->request_status_), backend, request_provider,
+      response_provider, infer_stats,
       [this, request]() mutable { this->FinishInferResponse(request); });
 
   return Status::Success;
 }
 
+Status
+HTTPServerImpl::CreateInferProviders(
+    const std::shared_ptr<RequestArena>& arena,
+    const std::shared_ptr<ModelInferStats>& infer_stats,
+    const std::string& model_name, int64_t model_version,
+    const std::shared_ptr<InferRequestHeader>& request_header,
+    const RequestOrdinals* ordinals, evbuffer* body, evbuffer* input_buffer,
+    evbuffer* output_buffer,
+    std::shared_ptr<InferenceServer::InferBackendHandle>* backend,
+    std::shared_ptr<InferRequestProvider>* request_provider,
+    std::shared_ptr<HTTPInferResponseProvider>* response_provider)
+{
+  RequestOrdinals normalized_ordinals;
+  if (ordinals == nullptr) {
+    RETURN_IF_ERROR(InferenceServer::InferBackendHandle::Create(
+        server_, model_name, model_version, backend));
+    RETURN_IF_ERROR(NormalizeRequestHeader(
+        *((*backend)->GetInferenceBackend()), *request_header,
+        &normalized_ordinals));
+    ordinals = &normalized_ordinals;
+  }
+
+  InferenceBackend* is = (*backend)->GetInferenceBackend();
+  infer_stats->SetMetricReporter(is->MetricReporter());
+
+  InputMemoryList input_map;
+  if (body != nullptr) {
+    evbuffer_remove_buffer(
+        body, input_buffer, InputDataByteSize(*request_header));
+  }
+  RETURN_IF_ERROR(
+      EVBufferToInputMap(model_name, *request_header, input_buffer, input_map));
+
+  RETURN_IF_ERROR(InferRequestProvider::Create(
+      model_name, model_version, request_header, *ordinals, input_map,
+      request_provider, arena));
+  infer_stats->SetBatchSize(request_header->batch_size());
+
+  RETURN_IF_ERROR(HTTPInferResponseProvider::Create(
+      output_buffer, *is, request_header, *ordinals, is->GetLabelProvider(),
+      response_provider, arena));
+
+  return Status::Success;
+}
+
 void
 HTTPServerImpl::OKReplyCallback(evthr_t* thr, void* arg, void* shared)
 {
@@ -478,29 +1618,367 @@ HTTPServerImpl::BADReplyCallback(evthr_t* thr, void* arg, void* shared)
   evhtp_request_resume(request);
 }
 
+Status
+HTTPServerImpl::DecompressRequestBody(
+    evhtp_request_t* req, size_t max_byte_size)
+{
+  HTTPCompression compression;
+  RETURN_IF_ERROR(ParseContentEncoding(
+      evhtp_kv_find(req->headers_in, "Content-Encoding"), &compression));
+  if (compression == HTTPCompression::IDENTITY) {
+    return Status::Success;
+  }
+
+  // The data is inflated directly into the blocks of a new buffer,
+  // which are then moved, not copied, back into the request.
+  evbuffer* decompressed = evbuffer_new();
+  Status status = DecompressData(
+      compression, req->buffer_in, max_byte_size, decompressed);
+  if (status.IsOk()) {
+    evbuffer_add_buffer(req->buffer_in, decompressed);
+  }
+  evbuffer_free(decompressed);
+
+  return status;
+}
+
+HTTPCompression
+HTTPServerImpl::ResponseCompression(
+    evhtp_request_t* req, size_t byte_size) const
+{
+  if ((compression_threshold_ < 0) ||
+      (byte_size < (size_t)compression_threshold_)) {
+    return HTTPCompression::IDENTITY;
+  }
+
+  return SelectAcceptEncoding(
+      evhtp_kv_find(req->headers_in, "Accept-Encoding"));
+}
+
 void
-HTTPServerImpl::FinishInferResponse(const std::shared_ptr<InferRequest>& req)
+HTTPServerImpl::CompressResponseBody(
+    evhtp_request_t* req, HTTPCompression compression)
 {
-  if (req->FinalizeResponse() == EVHTP_RES_OK) {
-    evthr_defer(req->thread_, OKReplyCallback, req->req_);
+  evbuffer* compressed = evbuffer_new();
+  Status status = CompressData(compression, req->buffer_out, compressed);
+  if (status.IsOk()) {
+    evbuffer_add_buffer(req->buffer_out, compressed);
+    evhtp_headers_add_header(
+        req->headers_out,
+        evhtp_header_new(
+            "Content-Encoding", ContentEncodingString(compression), 0, 0));
   } else {
-    evthr_defer(req->thread_, BADReplyCallback, req->req_);
+    LOG_VERBOSE(1) << "Sending uncompressed response: " << status.Message();
+  }
+  evbuffer_free(compressed);
+}
+
+void
+HTTPServerImpl::CompressedReply::Callback(
+    evthr_t* thr, void* arg, void* shared)
+{
+  std::unique_ptr<CompressedReply> reply(
+      reinterpret_cast<CompressedReply*>(arg));
+  CompressResponseBody(reply->req_, reply->compression_);
+  evhtp_send_reply(reply->req_, reply->code_);
+  evhtp_request_resume(reply->req_);
+}
+
+void
+HTTPServerImpl::FinishInferResponse(const std::shared_ptr<InferRequest>& req)
+{
+  DeferReply(req->req_, req->thread_, req->FinalizeResponse());
+}
+
+void
+HTTPServerImpl::FinishMultiInferResponse(
+    const std::shared_ptr<MultiInferRequest>& multi_req)
+{
+  multi_req->FinalizeResponse();
+  DeferReply(multi_req->req_, multi_req->thread_, EVHTP_RES_OK);
+}
+
+void
+HTTPServerImpl::DeferReply(
+    evhtp_request_t* req, evthr_t* thread, evhtp_res code) const
+{
+  // Chunked transfer encoding requires HTTP/1.1.
+  const size_t byte_size = evbuffer_get_length(req->buffer_out);
+  const HTTPCompression compression = ResponseCompression(req, byte_size);
+  if ((response_chunk_byte_size_ > 0) &&
+      (byte_size > response_chunk_byte_size_) &&
+      (req->proto == EVHTP_PROTO_11)) {
+    evthr_defer(
+        thread, ChunkedReply::StartCallback,
+        new ChunkedReply(req, code, response_chunk_byte_size_, compression));
+    return;
+  }
+
+  if (compression != HTTPCompression::IDENTITY) {
+    evthr_defer(
+        thread, CompressedReply::Callback,
+        new CompressedReply{req, code, compression});
+    return;
+  }
+
+  evthr_defer(
+      thread, (code == EVHTP_RES_OK) ? OKReplyCallback : BADReplyCallback,
+      req);
+}
+
+HTTPServerImpl::ChunkedReply::ChunkedReply(
+    evhtp_request_t* req, evhtp_res code, size_t chunk_byte_size,
+    HTTPCompression compression)
+    : req_(req), code_(code), chunk_byte_size_(chunk_byte_size),
+      output_(nullptr), write_cb_(nullptr)
+{
+  if (compression != HTTPCompression::IDENTITY) {
+    Status status = HTTPCompressor::Create(compression, &compressor_);
+    if (status.IsOk()) {
+      evhtp_headers_add_header(
+          req_->headers_out,
+          evhtp_header_new(
+              "Content-Encoding", ContentEncodingString(compression), 0, 0));
+    } else {
+      LOG_VERBOSE(1) << "Sending uncompressed response: " << status.Message();
+    }
+  }
+}
+
+void
+HTTPServerImpl::ChunkedReply::StartCallback(
+    evthr_t* thr, void* arg, void* shared)
+{
+  ChunkedReply* reply = reinterpret_cast<ChunkedReply*>(arg);
+  evhtp_connection_t* conn = evhtp_request_get_connection(reply->req_);
+
+  evhtp_send_reply_chunk_start(reply->req_, reply->code_);
+
+  // The request stays paused until the reply is complete, so if the
+  // connection fails meanwhile it is only freed once the request is
+  // resumed.
+  evhtp_connection_set_hook(
+      conn, evhtp_hook_on_conn_error, (evhtp_hook)ConnectionErrorHook, reply);
+  reply->output_ = bufferevent_get_output(evhtp_connection_get_bev(conn));
+  reply->write_cb_ = evbuffer_add_cb(reply->output_, WriteCallback, reply);
+
+  reply->SendNextChunk();
+}
+
+void
+HTTPServerImpl::ChunkedReply::WriteCallback(
+    struct evbuffer* buffer, const struct evbuffer_cb_info* info, void* arg)
+{
+  // Send the next chunk when the connection has written at least
+  // half of the data it holds.
+  ChunkedReply* reply = reinterpret_cast<ChunkedReply*>(arg);
+  if ((info->n_deleted > 0) &&
+      (evbuffer_get_length(buffer) <= (reply->chunk_byte_size_ / 2))) {
+    reply->SendNextChunk();
+  }
+}
+
+void
+HTTPServerImpl::ChunkedReply::ConnectionErrorHook(
+    evhtp_connection_t* conn, evhtp_error_flags errtype, void* arg)
+{
+  LOG_VERBOSE(1) << "Connection failed while sending chunked response";
+  reinterpret_cast<ChunkedReply*>(arg)->Finish(false /* end */);
+}
+
+void
+HTTPServerImpl::ChunkedReply::SendNextChunk()
+{
+  // The compressor may hold back all the data of a chunk, which must
+  // not be sent empty since an empty chunk ends the body.
+  evbuffer* chunk = evbuffer_new();
+  Status status;
+  while (status.IsOk() && (evbuffer_get_length(chunk) == 0) &&
+         (evbuffer_get_length(req_->buffer_out) > 0)) {
+    const size_t remaining = evbuffer_get_length(req_->buffer_out);
+    const size_t byte_size = std::min(remaining, chunk_byte_size_);
+    if (compressor_ != nullptr) {
+      status = compressor_->Compress(
+          req_->buffer_out, byte_size, (byte_size == remaining), chunk);
+    } else {
+      evbuffer_remove_buffer(req_->buffer_out, chunk, byte_size);
+    }
+  }
+
+  if (evbuffer_get_length(chunk) > 0) {
+    evhtp_send_reply_chunk(req_, chunk);
+  }
+  evbuffer_free(chunk);
+
+  // The headers are already sent so a failure can only truncate the
+  // body, which the client detects from the compressed data.
+  if (!status.IsOk()) {
+    LOG_ERROR << "Failed to send chunked response: " << status.Message();
+    Finish(true /* end */);
+  } else if (evbuffer_get_length(req_->buffer_out) == 0) {
+    Finish(true /* end */);
+  }
+}
+
+void
+HTTPServerImpl::ChunkedReply::Finish(bool end)
+{
+  evbuffer_remove_cb_entry(output_, write_cb_);
+  evhtp_connection_unset_hook(
+      evhtp_request_get_connection(req_), evhtp_hook_on_conn_error);
+
+  if (end) {
+    evhtp_send_reply_chunk_end(req_);
   }
+  evhtp_request_resume(req_);
+
+  delete this;
 }
 
 HTTPServerImpl::InferRequest::InferRequest(
     evhtp_request_t* req, uint64_t id,
-    const std::shared_ptr<InferRequestProvider>& request_provider,
-    const std::shared_ptr<HTTPInferResponseProvider>& response_provider,
-    const std::shared_ptr<ModelInferStats>& infer_stats,
-    const std::shared_ptr<ModelInferStats::ScopedTimer>& timer)
-    : req_(req), id_(id), request_provider_(request_provider),
-      response_provider_(response_provider), infer_stats_(infer_stats),
-      timer_(timer)
+    HTTPInferResponseProvider* response_provider)
+    : req_(req), id_(id), response_provider_(response_provider)
 {
   evhtp_connection_t* htpconn = evhtp_request_get_connection(req);
   thread_ = htpconn->thread;
-  evhtp_request_pause(req);
+}
+
+bool
+HTTPServerImpl::UseBinaryResponseHeader(evhtp_request_t* req)
+{
+  const char* format_c_str = evhtp_kv_find(req->uri->query, "format");
+  return (format_c_str != NULL) && (strcmp(format_c_str, "binary_header") == 0);
+}
+
+void
+HTTPServerImpl::AddInferResponseHeaders(
+    evhtp_request_t* req, bool binary_header,
+    const RequestStatus& request_status,
+    const InferResponseHeader& response_header)
+{
+  if (binary_header) {
+    // Prepending a buffer to the body moves its contents instead of
+    // copying them.
+    evbuffer* prefix = evbuffer_new();
+    AddBinaryResponseHeader(prefix, request_status, response_header);
+    evbuffer_prepend_buffer(req->buffer_out, prefix);
+    evbuffer_free(prefix);
+
+    char code[16];
+    snprintf(code, sizeof(code), "%d", request_status.code());
+    evhtp_headers_add_header(
+        req->headers_out, evhtp_header_new(kStatusCodeHTTPHeader, code, 0, 1));
+  } else {
+    evhtp_headers_add_header(
+        req->headers_out,
+        evhtp_header_new(
+            kInferResponseHTTPHeader,
+            response_header.ShortDebugString().c_str(), 1, 1));
+    evhtp_headers_add_header(
+        req->headers_out,
+        evhtp_header_new(
+            kStatusHTTPHeader, request_status.ShortDebugString().c_str(), 1,
+            1));
+  }
+
+  evhtp_headers_add_header(
+      req->headers_out,
+      evhtp_header_new("Content-Type", "application/octet-stream", 0, 0));
+}
+
+void
+HTTPServerImpl::AddBinaryResponseHeader(
+    evbuffer* buffer, const RequestStatus& request_status,
+    const InferResponseHeader& response_header)
+{
+  // Serialize both messages directly into a single reserved extent.
+  const size_t status_byte_size = request_status.ByteSizeLong();
+  const size_t header_byte_size = response_header.ByteSizeLong();
+  const size_t byte_size =
+      2 * sizeof(uint32_t) + status_byte_size + header_byte_size;
+
+  struct evbuffer_iovec extent;
+  evbuffer_reserve_space(buffer, byte_size, &extent, 1);
+
+  uint8_t* dst = reinterpret_cast<uint8_t*>(extent.iov_base);
+  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+    *dst++ = (status_byte_size >> (8 * i)) & 0xff;
+  }
+  dst = request_status.SerializeWithCachedSizesToArray(dst);
+  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+    *dst++ = (header_byte_size >> (8 * i)) & 0xff;
+  }
+  response_header.SerializeWithCachedSizesToArray(dst);
+
+  extent.iov_len = byte_size;
+  evbuffer_commit_space(buffer, &extent, 1);
+}
+
+size_t
+HTTPServerImpl::InputDataByteSize(const InferRequestHeader& request_header)
+{
+  // Blob and shared-memory inputs have no data in the body.
+  size_t byte_size = 0;
+  for (const auto& io : request_header.input()) {
+    if (io.blob_key().empty() && !io.has_shared_memory()) {
+      byte_size += io.batch_byte_size();
+    }
+  }
+
+  return byte_size;
+}
+
+HTTPServerImpl::MultiInferRequest::MultiInferRequest(
+    evhtp_request_t* req, size_t request_cnt)
+    : req_(req), responses_(request_cnt), pending_cnt_(request_cnt)
+{
+  evhtp_connection_t* htpconn = evhtp_request_get_connection(req);
+  thread_ = htpconn->thread;
+  for (auto& response : responses_) {
+    response.id_ = 0;
+    response.input_buffer_ = evbuffer_new();
+    response.output_buffer_ = evbuffer_new();
+  }
+}
+
+HTTPServerImpl::MultiInferRequest::~MultiInferRequest()
+{
+  for (auto& response : responses_) {
+    evbuffer_free(response.input_buffer_);
+    evbuffer_free(response.output_buffer_);
+  }
+}
+
+void
+HTTPServerImpl::MultiInferRequest::FinalizeResponse()
+{
+  // The body holds the response to each request in order, in the
+  // binary response header format followed by the 8-byte
+  // little-endian size of the raw output and the raw output itself.
+  for (auto& response : responses_) {
+    if (response.request_status_.code() != RequestStatusCode::SUCCESS) {
+      evbuffer_drain(response.output_buffer_, -1);
+      response.response_header_.Clear();
+    }
+    response.response_header_.set_id(response.id_);
+
+    AddBinaryResponseHeader(
+        req_->buffer_out, response.request_status_, response.response_header_);
+
+    const uint64_t output_byte_size =
+        evbuffer_get_length(response.output_buffer_);
+    uint8_t size_buf[sizeof(uint64_t)];
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      size_buf[i] = (output_byte_size >> (8 * i)) & 0xff;
+    }
+    evbuffer_add(req_->buffer_out, size_buf, sizeof(size_buf));
+    evbuffer_add_buffer(req_->buffer_out, response.output_buffer_);
+  }
+
+  evhtp_headers_add_header(
+      req_->headers_out,
+      evhtp_header_new("Content-Type", "application/octet-stream", 0, 0));
 }
 
 evhtp_res
@@ -508,7 +1986,16 @@ HTTPServerImpl::InferRequest::FinalizeResponse()
 {
   InferResponseHeader* response_header =
       response_provider_->MutableResponseHeader();
-  if (request_status_.code() == RequestStatusCode::SUCCESS) {
+  const bool binary_header = UseBinaryResponseHeader(req_);
+  if (request_status_.code() != RequestStatusCode::SUCCESS) {
+    evbuffer_drain(req_->buffer_out, -1);
+    response_header->Clear();
+    response_header->set_id(id_);
+  } else if (binary_header) {
+    // The entire response (including classifications) goes in the
+    // header at the start of the body.
+    response_header->set_id(id_);
+  } else {
     std::string format;
     const char* format_c_str = evhtp_kv_find(req_->uri->query, "format");
     if (format_c_str != NULL) {
@@ -538,23 +2025,10 @@ HTTPServerImpl::InferRequest::FinalizeResponse()
       InferResponseHeader::Output* output = response_header->mutable_output(i);
       output->clear_batch_classes();
     }
-  } else {
-    evbuffer_drain(req_->buffer_out, -1);
-    response_header->Clear();
-    response_header->set_id(id_);
   }
-  evhtp_headers_add_header(
-      req_->headers_out,
-      evhtp_header_new(
-          kInferResponseHTTPHeader, response_header->ShortDebugString().c_str(),
-          1, 1));
-  evhtp_headers_add_header(
-      req_->headers_out,
-      evhtp_header_new(
-          kStatusHTTPHeader, request_status_.ShortDebugString().c_str(), 1, 1));
-  evhtp_headers_add_header(
-      req_->headers_out,
-      evhtp_header_new("Content-Type", "application/octet-stream", 1, 1));
+
+  AddInferResponseHeaders(
+      req_, binary_header, request_status_, *response_header);
 
   return (request_status_.code() == RequestStatusCode::SUCCESS)
              ? EVHTP_RES_OK
@@ -564,21 +2038,36 @@ HTTPServerImpl::InferRequest::FinalizeResponse()
 Status
 HTTPServer::Create(
     InferenceServer* server,
-    const std::map<int32_t, std::vector<std::string>>& port_map, int thread_cnt,
+    const std::map<int32_t, std::vector<std::string>>& port_map,
+    const std::map<std::string, std::vector<std::string>>& unix_socket_map,
+    int thread_cnt, int work_thread_cnt, int listener_cnt, bool pin_listeners,
+    int compression_threshold, int response_chunk_byte_size,
     std::vector<std::unique_ptr<HTTPServer>>* http_servers)
 {
-  if (port_map.empty()) {
+  if (port_map.empty() && unix_socket_map.empty()) {
     return Status(
         RequestStatusCode::INVALID_ARG,
         "HTTP is enabled but none of the service endpoints have a valid port "
-        "assignment");
+        "or Unix domain socket assignment");
   }
   http_servers->clear();
   for (auto const& ep_map : port_map) {
     std::string addr = "0.0.0.0:" + std::to_string(ep_map.first);
     LOG_INFO << "Starting HTTPService at " << addr;
-    http_servers->emplace_back(
-        new HTTPServerImpl(server, ep_map.second, ep_map.first, thread_cnt));
+    http_servers->emplace_back(new HTTPServerImpl(
+        server, ep_map.second, ep_map.first, "" /* unix_socket_path */,
+        thread_cnt, work_thread_cnt, listener_cnt, pin_listeners,
+        compression_threshold, response_chunk_byte_size));
+  }
+
+  // A Unix domain socket has a single listener, SO_REUSEPORT doesn't
+  // apply to it.
+  for (auto const& ep_map : unix_socket_map) {
+    LOG_INFO << "Starting HTTPService at unix:" << ep_map.first;
+    http_servers->emplace_back(new HTTPServerImpl(
+        server, ep_map.second, -1 /* port */, ep_map.first, thread_cnt,
+        work_thread_cnt, 1 /* listener_cnt */, pin_listeners,
+        compression_threshold, response_chunk_byte_size));
   }
 
   return Status::Success;
@@ -36,7 +36,11 @@ class HTTPServer {
   static Status Create(
       InferenceServer* server,
       const std::map<int32_t, std::vector<std::string>>& port_map,
-      int thread_cnt, std::vector<std::unique_ptr<HTTPServer>>* http_servers);
+      const std::map<std::string, std::vector<std::string>>& unix_socket_map,
+      int thread_cnt, int work_thread_cnt, int listener_cnt,
+      bool pin_listeners, int compression_threshold,
+      int response_chunk_byte_size,
+      std::vector<std::unique_ptr<HTTPServer>>* http_servers);
 
   virtual Status Start() = 0;
   virtual Status Stop() = 0;
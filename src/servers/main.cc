@@ -79,6 +79,12 @@ int32_t grpc_port_ = 8001;
 int32_t http_health_port_ = -1;
 std::vector<int32_t> http_ports_;
 
+// The paths of the Unix domain sockets that the HTTP and GRPC servers
+// listen on in addition to their ports. Empty to not listen on a
+// Unix domain socket.
+std::string http_unix_socket_;
+std::string grpc_unix_socket_;
+
 // The metric port. Initialized to default values and modifyied based
 // on command-line args. Set to -1 to indicate the protocol is
 // disabled.
@@ -89,8 +95,9 @@ bool allow_grpc_ = true;
 bool allow_metrics_ = true;
 
 // endpoint names for http/gRPC
-std::vector<std::string> endpoint_names = {"status", "health", "profile",
-                                           "infer"};
+std::vector<std::string> endpoint_names = {
+    "status", "health", "profile", "infer", "blob", "sharedmemory",
+    "multiinfer"};
 
 // Should GPU metrics be reported.
 bool allow_gpu_metrics_ = false;
@@ -104,6 +111,27 @@ int grpc_stream_infer_thread_cnt_ = 1000;
 // The number of threads to initialize for the HTTP front-end.
 int http_thread_cnt_ = 8;
 
+// The number of threads to initialize for preparing HTTP inference
+// requests. Zero indicates that the requests are prepared by the HTTP
+// front-end threads.
+int http_work_thread_cnt_ = 0;
+
+// The number of listeners accepting connections on each HTTP port. With
+// more than one listener the port is bound with SO_REUSEPORT and each
+// listener has its own event loop.
+int http_listener_cnt_ = 1;
+
+// Pin the threads of each HTTP listener to its own range of CPUs?
+bool http_pin_listeners_ = false;
+
+// The minimum size in bytes of an HTTP response body to compress when
+// the client accepts gzip or deflate. Negative disables compression.
+int http_compression_threshold_ = -1;
+
+// HTTP response bodies larger than this many bytes are sent in chunks
+// of this size with chunked transfer encoding. Zero disables chunking.
+int http_response_chunk_byte_size_ = 0;
+
 // Command-line options
 enum OptionId {
   OPTION_HELP = 1000,
@@ -124,15 +152,27 @@ enum OptionId {
   OPTION_GRPC_PORT,
   OPTION_HTTP_PORT,
   OPTION_HTTP_HEALTH_PORT,
+  OPTION_GRPC_UNIX_SOCKET,
+  OPTION_HTTP_UNIX_SOCKET,
   OPTION_METRICS_PORT,
   OPTION_GRPC_INFER_THREAD_COUNT,
   OPTION_GRPC_STREAM_INFER_THREAD_COUNT,
   OPTION_HTTP_THREAD_COUNT,
+  OPTION_HTTP_WORK_THREAD_COUNT,
+  OPTION_HTTP_LISTENER_COUNT,
+  OPTION_HTTP_PIN_LISTENERS,
+  OPTION_HTTP_COMPRESSION_THRESHOLD,
+  OPTION_HTTP_RESPONSE_CHUNK_BYTE_SIZE,
   OPTION_ALLOW_POLL_REPO,
   OPTION_POLL_REPO_SECS,
   OPTION_EXIT_TIMEOUT_SECS,
   OPTION_TF_ALLOW_SOFT_PLACEMENT,
   OPTION_TF_GPU_MEMORY_FRACTION,
+  OPTION_MEMORY_POOL_BYTE_SIZE,
+  OPTION_MEMORY_POOL_THREAD_CACHE_BYTE_SIZE,
+  OPTION_MEMORY_POOL_HUGE_PAGES,
+  OPTION_BLOB_STORE_BYTE_SIZE,
+  OPTION_STATUS_SNAPSHOT_INTERVAL_MS,
 };
 
 struct Option {
@@ -191,6 +231,15 @@ std::vector<Option> options_{
      "The port for the server to listen on for HTTP requests."},
     {OPTION_HTTP_HEALTH_PORT, "http-health-port",
      "The port for the server to listen on for HTTP Health requests."},
+    {OPTION_GRPC_UNIX_SOCKET, "grpc-unix-socket",
+     "The path of a Unix domain socket for the server to listen on for GRPC "
+     "requests, in addition to --grpc-port. A client on the same host "
+     "connects to it with the server URL unix:<path>."},
+    {OPTION_HTTP_UNIX_SOCKET, "http-unix-socket",
+     "The path of a Unix domain socket for the server to listen on for "
+     "requests to all the HTTP endpoints, in addition to the HTTP ports. A "
+     "client on the same host connects to it with the server URL "
+     "unix:<path>."},
     {OPTION_METRICS_PORT, "metrics-port",
      "The port reporting prometheus metrics."},
     {OPTION_GRPC_INFER_THREAD_COUNT, "grpc-infer-thread-count",
@@ -199,6 +248,28 @@ std::vector<Option> options_{
      "Number of threads handling GRPC stream inference requests."},
     {OPTION_HTTP_THREAD_COUNT, "http-thread-count",
      "Number of threads handling HTTP requests."},
+    {OPTION_HTTP_WORK_THREAD_COUNT, "http-work-thread-count",
+     "Number of threads preparing HTTP inference requests. A value of zero "
+     "indicates that the inference requests are prepared by the threads "
+     "handling HTTP requests."},
+    {OPTION_HTTP_LISTENER_COUNT, "http-listener-count",
+     "Number of listeners accepting connections on each HTTP port. Each "
+     "listener has its own event loop and the threads handling HTTP "
+     "requests are divided among the listeners. A value greater than one "
+     "requires SO_REUSEPORT support."},
+    {OPTION_HTTP_PIN_LISTENERS, "http-pin-listeners",
+     "Pin the threads of each HTTP listener to a separate range of the "
+     "CPUs available to the server."},
+    {OPTION_HTTP_COMPRESSION_THRESHOLD, "http-compression-threshold",
+     "The minimum size, in bytes, of an HTTP response body to compress "
+     "with gzip or deflate when the client's Accept-Encoding allows it. "
+     "The default of -1 disables response compression. A threshold of "
+     "1024 avoids compressing responses too small to benefit."},
+    {OPTION_HTTP_RESPONSE_CHUNK_BYTE_SIZE, "http-response-chunk-byte-size",
+     "HTTP/1.1 response bodies larger than this many bytes are sent with "
+     "chunked transfer encoding, one chunk of this size at a time as the "
+     "connection drains, and are compressed chunk by chunk. A value of 0 "
+     "sends every response body at once."},
     {OPTION_ALLOW_POLL_REPO, "allow-poll-model-repository",
      "Poll the model repository to detect changes. The poll rate is "
      "controlled by 'repository-poll-secs'."},
@@ -218,7 +289,28 @@ std::vector<Option> options_{
      "Reserve a portion of GPU memory for TensorFlow models. Default "
      "value 0.0 indicates that TensorFlow should dynamically allocate "
      "memory as needed. Value of 1.0 indicates that TensorFlow should "
-     "allocate all of GPU memory."}};
+     "allocate all of GPU memory."},
+    {OPTION_MEMORY_POOL_BYTE_SIZE, "memory-pool-byte-size",
+     "The maximum number of bytes of freed input and output tensor buffers "
+     "that are cached for reuse. A value of 0 disables the memory pool."},
+    {OPTION_MEMORY_POOL_THREAD_CACHE_BYTE_SIZE,
+     "memory-pool-thread-cache-byte-size",
+     "The maximum number of bytes of freed tensor buffers cached by each "
+     "thread, in addition to --memory-pool-byte-size."},
+    {OPTION_MEMORY_POOL_HUGE_PAGES, "memory-pool-huge-pages",
+     "Request transparent huge pages for tensor buffers of 2MB or larger."},
+    {OPTION_BLOB_STORE_BYTE_SIZE, "blob-store-byte-size",
+     "The maximum number of bytes of uploaded input tensor blobs held by "
+     "the server. Least recently used blobs are evicted when the limit is "
+     "reached. A value of 0 disables the blob store."},
+    {OPTION_STATUS_SNAPSHOT_INTERVAL_MS, "status-snapshot-interval-ms",
+     "The minimum interval, in milliseconds, between the snapshots of the "
+     "server status returned by status requests when only inference "
+     "statistics changed. Status requests within the interval share the "
+     "same snapshot, so the returned statistics may be out-of-date by up to "
+     "the interval. Added models and changed ready states are returned at "
+     "once. The default of 0 takes a new snapshot for each request made "
+     "after the status changed."}};
 
 
 void
@@ -252,6 +344,14 @@ CheckPortCollision()
     return true;
   }
 
+  // Check if HTTP and GRPC have the same Unix domain socket
+  if (!http_unix_socket_.empty() && (http_unix_socket_ == grpc_unix_socket_) &&
+      allow_http_ && allow_grpc_) {
+    LOG_ERROR << "The server cannot listen to HTTP requests "
+              << "and gRPC requests at the same Unix domain socket";
+    return true;
+  }
+
   // Check if Metric and GRPC have shared ports
   if ((grpc_port_ == metrics_port_) && (metrics_port_ != -1) &&
        allow_grpc_ && allow_metrics_) {
@@ -277,13 +377,14 @@ StartGrpcService(nvidia::inferenceserver::InferenceServer* server)
   std::unique_ptr<nvidia::inferenceserver::GRPCServer> service;
   nvidia::inferenceserver::Status status =
       nvidia::inferenceserver::GRPCServer::Create(
-          server, grpc_port_, grpc_infer_thread_cnt_,
+          server, grpc_port_, grpc_unix_socket_, grpc_infer_thread_cnt_,
           grpc_stream_infer_thread_cnt_, &service);
   if (status.IsOk()) {
     status = service->Start();
   }
 
   if (!status.IsOk()) {
+    LOG_ERROR << "Failed to start gRPC service: " << status.Message();
     service.reset();
   }
 
@@ -293,11 +394,15 @@ StartGrpcService(nvidia::inferenceserver::InferenceServer* server)
 nvidia::inferenceserver::Status
 StartMultipleHttpService(
     nvidia::inferenceserver::InferenceServer* server,
-    const std::map<int32_t, std::vector<std::string>>& port_map)
+    const std::map<int32_t, std::vector<std::string>>& port_map,
+    const std::map<std::string, std::vector<std::string>>& unix_socket_map)
 {
   nvidia::inferenceserver::Status status =
       nvidia::inferenceserver::HTTPServer::Create(
-          server, port_map, http_thread_cnt_, &http_endpoint_services_);
+          server, port_map, unix_socket_map, http_thread_cnt_,
+          http_work_thread_cnt_, http_listener_cnt_, http_pin_listeners_,
+          http_compression_threshold_, http_response_chunk_byte_size_,
+          &http_endpoint_services_);
   if (status.IsOk()) {
     for (auto& http_eps : http_endpoint_services_) {
       if (http_eps != nullptr) {
@@ -325,10 +430,9 @@ StartEndpoints(nvidia::inferenceserver::InferenceServer* server)
   LOG_INFO << "Starting endpoints, '" << server->Id() << "' listening on";
 
   // Enable gRPC endpoints if requested...
-  if (allow_grpc_ && (grpc_port_ != -1)) {
+  if (allow_grpc_ && ((grpc_port_ != -1) || !grpc_unix_socket_.empty())) {
     grpc_service_ = StartGrpcService(server);
     if (grpc_service_ == nullptr) {
-      LOG_ERROR << "Failed to start gRPC service";
       return false;
     }
   }
@@ -344,9 +448,17 @@ StartEndpoints(nvidia::inferenceserver::InferenceServer* server)
       }
     }
 
-    create_status = StartMultipleHttpService(server, port_map);
+    // The Unix domain socket serves all the endpoints
+    std::map<std::string, std::vector<std::string>> unix_socket_map;
+    if (!http_unix_socket_.empty()) {
+      unix_socket_map[http_unix_socket_] = endpoint_names;
+    }
+
+    create_status =
+        StartMultipleHttpService(server, port_map, unix_socket_map);
     if (!create_status.IsOk()) {
-      LOG_ERROR << "Failed to start HTTP service";
+      LOG_ERROR << "Failed to start HTTP service: "
+                << create_status.Message();
       return false;
     }
   }
@@ -401,6 +513,12 @@ ParseIntOption(const std::string arg)
   return std::stoi(arg);
 }
 
+int64_t
+ParseLongLongOption(const std::string arg)
+{
+  return std::stoll(arg);
+}
+
 float
 ParseFloatOption(const std::string arg)
 {
@@ -417,6 +535,12 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
   bool allow_profiling = server->ProfilingEnabled();
   bool tf_allow_soft_placement = server->TensorFlowSoftPlacementEnabled();
   float tf_gpu_memory_fraction = server->TensorFlowGPUMemoryFraction();
+  int64_t memory_pool_byte_size = server->MemoryPoolByteSize();
+  int64_t memory_pool_thread_cache_byte_size =
+      server->MemoryPoolThreadCacheByteSize();
+  bool memory_pool_huge_pages = server->MemoryPoolHugePagesEnabled();
+  int64_t blob_store_byte_size = server->BlobStoreByteSize();
+  int64_t status_snapshot_interval_ms = server->StatusSnapshotIntervalMs();
   int32_t exit_timeout_secs = server->ExitTimeoutSeconds();
   int32_t repository_poll_secs = server->RepositoryPollSeconds();
 
@@ -429,8 +553,15 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
   int32_t grpc_infer_thread_cnt = grpc_infer_thread_cnt_;
   int32_t grpc_stream_infer_thread_cnt = grpc_stream_infer_thread_cnt_;
   int32_t http_thread_cnt = http_thread_cnt_;
+  int32_t http_work_thread_cnt = http_work_thread_cnt_;
+  int32_t http_listener_cnt = http_listener_cnt_;
+  bool http_pin_listeners = http_pin_listeners_;
+  int32_t http_compression_threshold = http_compression_threshold_;
+  int32_t http_response_chunk_byte_size = http_response_chunk_byte_size_;
 
   int32_t http_health_port = http_port_;
+  std::string http_unix_socket = http_unix_socket_;
+  std::string grpc_unix_socket = grpc_unix_socket_;
 
   bool allow_poll_model_repository = repository_poll_secs > 0;
 
@@ -508,6 +639,12 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
       case OPTION_HTTP_HEALTH_PORT:
         http_health_port = ParseIntOption(optarg);
         break;
+      case OPTION_GRPC_UNIX_SOCKET:
+        grpc_unix_socket = optarg;
+        break;
+      case OPTION_HTTP_UNIX_SOCKET:
+        http_unix_socket = optarg;
+        break;
 
       case OPTION_METRICS_PORT:
         metrics_port = ParseIntOption(optarg);
@@ -522,6 +659,21 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
       case OPTION_HTTP_THREAD_COUNT:
         http_thread_cnt = ParseIntOption(optarg);
         break;
+      case OPTION_HTTP_WORK_THREAD_COUNT:
+        http_work_thread_cnt = ParseIntOption(optarg);
+        break;
+      case OPTION_HTTP_LISTENER_COUNT:
+        http_listener_cnt = ParseIntOption(optarg);
+        break;
+      case OPTION_HTTP_PIN_LISTENERS:
+        http_pin_listeners = ParseBoolOption(optarg);
+        break;
+      case OPTION_HTTP_COMPRESSION_THRESHOLD:
+        http_compression_threshold = ParseIntOption(optarg);
+        break;
+      case OPTION_HTTP_RESPONSE_CHUNK_BYTE_SIZE:
+        http_response_chunk_byte_size = ParseIntOption(optarg);
+        break;
       case OPTION_ALLOW_POLL_REPO:
         allow_poll_model_repository = ParseBoolOption(optarg);
         break;
@@ -538,6 +690,23 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
       case OPTION_TF_GPU_MEMORY_FRACTION:
         tf_gpu_memory_fraction = ParseFloatOption(optarg);
         break;
+
+      case OPTION_MEMORY_POOL_BYTE_SIZE:
+        memory_pool_byte_size = ParseLongLongOption(optarg);
+        break;
+      case OPTION_MEMORY_POOL_THREAD_CACHE_BYTE_SIZE:
+        memory_pool_thread_cache_byte_size = ParseLongLongOption(optarg);
+        break;
+      case OPTION_MEMORY_POOL_HUGE_PAGES:
+        memory_pool_huge_pages = ParseBoolOption(optarg);
+        break;
+
+      case OPTION_BLOB_STORE_BYTE_SIZE:
+        blob_store_byte_size = ParseLongLongOption(optarg);
+        break;
+      case OPTION_STATUS_SNAPSHOT_INTERVAL_MS:
+        status_snapshot_interval_ms = ParseLongLongOption(optarg);
+        break;
     }
   }
 
@@ -565,9 +734,12 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
   http_port_ = http_port;
   grpc_port_ = grpc_port;
   http_health_port_ = http_health_port;
+  http_unix_socket_ = http_unix_socket;
+  grpc_unix_socket_ = grpc_unix_socket;
 
   metrics_port_ = allow_metrics_ ? metrics_port : -1;
-  http_ports_ = {http_port_, http_health_port_, http_port_, http_port_};
+  http_ports_ = {http_port_, http_health_port_, http_port_, http_port_,
+                 http_port_, http_port_, http_port_};
 
   // Check if HTTP, GRPC and metrics port clash
   if (CheckPortCollision())
@@ -577,6 +749,11 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
   grpc_infer_thread_cnt_ = grpc_infer_thread_cnt;
   grpc_stream_infer_thread_cnt_ = grpc_stream_infer_thread_cnt;
   http_thread_cnt_ = http_thread_cnt;
+  http_work_thread_cnt_ = http_work_thread_cnt;
+  http_listener_cnt_ = http_listener_cnt;
+  http_pin_listeners_ = http_pin_listeners;
+  http_compression_threshold_ = http_compression_threshold;
+  http_response_chunk_byte_size_ = http_response_chunk_byte_size;
 
   server->SetId(server_id);
   server->SetModelStorePath(model_store_path);
@@ -591,6 +768,15 @@ Parse(nvidia::inferenceserver::InferenceServer* server, int argc, char** argv)
   server->SetTensorFlowSoftPlacementEnabled(tf_allow_soft_placement);
   server->SetTensorFlowGPUMemoryFraction(tf_gpu_memory_fraction);
 
+  server->SetMemoryPoolByteSize(std::max((int64_t)0, memory_pool_byte_size));
+  server->SetMemoryPoolThreadCacheByteSize(
+      std::max((int64_t)0, memory_pool_thread_cache_byte_size));
+  server->SetMemoryPoolHugePagesEnabled(memory_pool_huge_pages);
+
+  server->SetBlobStoreByteSize(std::max((int64_t)0, blob_store_byte_size));
+  server->SetStatusSnapshotIntervalMs(
+      std::max((int64_t)0, status_snapshot_interval_ms));
+
   return true;
 }
 }  // namespace
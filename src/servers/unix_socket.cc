@@ -0,0 +1,100 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/servers/unix_socket.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace nvidia { namespace inferenceserver {
+
+Status
+RemoveStaleUnixSocket(const std::string& path)
+{
+  struct stat st;
+  if (lstat(path.c_str(), &st) != 0) {
+    return Status::Success;
+  }
+
+  if (!S_ISSOCK(st.st_mode)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "failed to bind unix:" + path +
+            ", the path exists and is not a socket");
+  }
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    return Status(
+        RequestStatusCode::INVALID_ARG,
+        "failed to bind unix:" + path + ", the path is too long");
+  }
+  memcpy(addr.sun_path, path.c_str(), path.size());
+
+  // The socket is only stale if nothing accepts connections on it.
+  // Any other failure to connect leaves the file alone, since a live
+  // server may still be using it.
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "failed to check socket " + path + ": " + strerror(errno));
+  }
+  int err = 0;
+  if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) !=
+      0) {
+    err = errno;
+  }
+  close(fd);
+
+  if (err == 0) {
+    return Status(
+        RequestStatusCode::ALREADY_EXISTS,
+        "failed to bind unix:" + path +
+            ", another server is listening on the socket");
+  }
+  if (err != ECONNREFUSED) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "failed to check socket " + path + ": " + strerror(err));
+  }
+
+  if (unlink(path.c_str()) != 0) {
+    return Status(
+        RequestStatusCode::INTERNAL,
+        "failed to remove stale socket " + path + ": " + strerror(errno));
+  }
+
+  return Status::Success;
+}
+
+}}  // namespace nvidia::inferenceserver
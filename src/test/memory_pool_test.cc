@@ -0,0 +1,404 @@
+// Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "src/core/memory_pool.h"
+#include "src/core/metrics.h"
+
+namespace nvidia { namespace inferenceserver { namespace test {
+
+namespace {
+
+constexpr size_t kKB = 1024;
+constexpr size_t kMB = 1024 * 1024;
+
+// Run 'fn' on a new thread and wait for it to exit. The thread's
+// local free lists are drained to the shared free lists when it
+// exits, so tests that run all allocations this way see every
+// released buffer in the shared statistics.
+template <typename F>
+void
+RunOnThread(F fn)
+{
+  std::thread thread(fn);
+  thread.join();
+}
+
+// Return all buffers in the shared free lists to the system and then
+// apply the default options.
+void
+EmptyPool()
+{
+  SystemMemoryPool::Options options;
+  options.max_cached_byte_size_ = 0;
+  SystemMemoryPool::Configure(options);
+  SystemMemoryPool::Configure(SystemMemoryPool::Options());
+}
+
+class MemoryPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    EmptyPool();
+    SystemMemoryPool::GetStats(&base_);
+    ASSERT_EQ(base_.cached_byte_size_, 0u);
+  }
+
+  void TearDown() override
+  {
+    SystemMemoryPool::Options options;
+    options.max_cached_byte_size_ = 0;
+    SystemMemoryPool::Configure(options);
+  }
+
+  // Return the statistics accumulated since SetUp().
+  SystemMemoryPool::Stats Delta() const
+  {
+    SystemMemoryPool::Stats stats;
+    SystemMemoryPool::GetStats(&stats);
+    stats.hit_count_ -= base_.hit_count_;
+    stats.miss_count_ -= base_.miss_count_;
+    stats.resident_byte_size_ -= base_.resident_byte_size_;
+    return stats;
+  }
+
+  SystemMemoryPool::Stats base_;
+};
+
+}  // namespace
+
+TEST_F(MemoryPoolTest, SizeClassBoundaries)
+{
+  // Each request and the byte size of the size class it is rounded
+  // up to. Each power-of-two range is split into four classes.
+  const std::vector<std::pair<size_t, size_t>> classes{
+      {1, 256},
+      {256, 256},
+      {257, 320},
+      {320, 320},
+      {321, 384},
+      {512, 512},
+      {513, 640},
+      {1 * kMB, 1 * kMB},
+      {1 * kMB + 1, 1 * kMB + 256 * kKB},
+      {2 * kMB - 1, 2 * kMB},
+      {2 * kMB, 2 * kMB},
+  };
+
+  for (const auto& c : classes) {
+    SCOPED_TRACE(c.first);
+    RunOnThread([&c]() {
+      SystemMemoryPool::Stats before;
+      SystemMemoryPool::GetStats(&before);
+
+      char* buffer = SystemMemoryPool::Allocate(c.first);
+      ASSERT_NE(buffer, nullptr);
+      SystemMemoryPool::Stats after;
+      SystemMemoryPool::GetStats(&after);
+      EXPECT_EQ(after.miss_count_, before.miss_count_ + 1);
+      EXPECT_EQ(
+          after.resident_byte_size_, before.resident_byte_size_ + c.second);
+
+      // The whole class must be usable.
+      buffer[c.second - 1] = 1;
+
+      // A request for the largest size in the same class is served
+      // by the released buffer.
+      SystemMemoryPool::Release(buffer, c.first);
+      char* reused = SystemMemoryPool::Allocate(c.second);
+      EXPECT_EQ(reused, buffer);
+      SystemMemoryPool::Release(reused, c.second);
+
+      SystemMemoryPool::GetStats(&after);
+      EXPECT_EQ(after.hit_count_, before.hit_count_ + 1);
+      EXPECT_EQ(after.miss_count_, before.miss_count_ + 1);
+    });
+    EmptyPool();
+  }
+
+  // A request just over a class boundary is a different class and so
+  // is not served by a released buffer of the smaller class.
+  RunOnThread([]() {
+    char* buffer = SystemMemoryPool::Allocate(320);
+    SystemMemoryPool::Release(buffer, 320);
+    char* larger = SystemMemoryPool::Allocate(321);
+    SystemMemoryPool::Release(larger, 321);
+  });
+
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(delta.hit_count_, classes.size());
+  EXPECT_EQ(delta.miss_count_, classes.size() + 2);
+}
+
+TEST_F(MemoryPoolTest, HugePageAlignment)
+{
+  const size_t huge_page_byte_size = 2 * kMB;
+  for (size_t byte_size : {2 * kMB, 3 * kMB, 16 * kMB + 1}) {
+    char* buffer = SystemMemoryPool::Allocate(byte_size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % huge_page_byte_size, 0u)
+        << byte_size;
+    SystemMemoryPool::Release(buffer, byte_size);
+  }
+}
+
+TEST_F(MemoryPoolTest, LargerThanLargestClass)
+{
+  // Buffers larger than the largest size class (1GB) are never
+  // pooled. The mapping is not touched so no memory is committed.
+  const size_t byte_size = (size_t(1) << 30) + 1;
+  RunOnThread([this, byte_size]() {
+    char* buffer = SystemMemoryPool::Allocate(byte_size);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(Delta().resident_byte_size_, byte_size);
+    SystemMemoryPool::Release(buffer, byte_size);
+  });
+
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(delta.miss_count_, 1u);
+  EXPECT_EQ(delta.resident_byte_size_, 0u);
+  EXPECT_EQ(delta.cached_byte_size_, 0u);
+}
+
+TEST_F(MemoryPoolTest, Disabled)
+{
+  SystemMemoryPool::Options options;
+  options.max_cached_byte_size_ = 0;
+  SystemMemoryPool::Configure(options);
+
+  RunOnThread([]() {
+    for (size_t i = 0; i < 10; ++i) {
+      char* buffer = SystemMemoryPool::Allocate(4 * kKB);
+      SystemMemoryPool::Release(buffer, 4 * kKB);
+    }
+  });
+
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(delta.hit_count_, 0u);
+  EXPECT_EQ(delta.miss_count_, 10u);
+  EXPECT_EQ(delta.resident_byte_size_, 0u);
+  EXPECT_EQ(delta.cached_byte_size_, 0u);
+}
+
+TEST_F(MemoryPoolTest, CrossThreadFree)
+{
+  const size_t cnt = 32;
+  const size_t byte_size = 64 * kKB;
+
+  // Allocate on one thread and release on another.
+  std::vector<char*> buffers;
+  RunOnThread([&buffers, cnt, byte_size]() {
+    for (size_t i = 0; i < cnt; ++i) {
+      buffers.push_back(SystemMemoryPool::Allocate(byte_size));
+    }
+  });
+  RunOnThread([&buffers, byte_size]() {
+    for (char* buffer : buffers) {
+      SystemMemoryPool::Release(buffer, byte_size);
+    }
+  });
+
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(delta.miss_count_, cnt);
+  EXPECT_EQ(delta.cached_byte_size_, cnt * byte_size);
+  EXPECT_EQ(delta.resident_byte_size_, cnt * byte_size);
+
+  // A third thread is served entirely from the released buffers.
+  std::vector<char*> reused;
+  RunOnThread([&reused, cnt, byte_size]() {
+    for (size_t i = 0; i < cnt; ++i) {
+      reused.push_back(SystemMemoryPool::Allocate(byte_size));
+    }
+  });
+
+  delta = Delta();
+  EXPECT_EQ(delta.hit_count_, cnt);
+  EXPECT_EQ(delta.miss_count_, cnt);
+  EXPECT_EQ(delta.cached_byte_size_, 0u);
+  EXPECT_EQ(delta.resident_byte_size_, cnt * byte_size);
+
+  std::sort(buffers.begin(), buffers.end());
+  std::sort(reused.begin(), reused.end());
+  EXPECT_EQ(reused, buffers);
+
+  // Many threads allocating and releasing concurrently, each
+  // releasing buffers allocated by its neighbor.
+  const size_t thread_cnt = 8;
+  std::vector<std::vector<char*>> allocated(thread_cnt);
+  for (size_t i = 0; i < thread_cnt; ++i) {
+    for (size_t j = 0; j < cnt; ++j) {
+      allocated[i].push_back(SystemMemoryPool::Allocate(byte_size));
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_cnt; ++i) {
+    threads.emplace_back([&allocated, i, thread_cnt, cnt, byte_size]() {
+      for (char* buffer : allocated[(i + 1) % thread_cnt]) {
+        SystemMemoryPool::Release(buffer, byte_size);
+        SystemMemoryPool::Release(
+            SystemMemoryPool::Allocate(byte_size), byte_size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  RunOnThread([&reused, byte_size]() {
+    for (char* buffer : reused) {
+      SystemMemoryPool::Release(buffer, byte_size);
+    }
+  });
+
+  // Every buffer is back in the pool and none were lost or doubly
+  // counted.
+  delta = Delta();
+  EXPECT_EQ(
+      delta.hit_count_ + delta.miss_count_, (2 * cnt) + (2 * thread_cnt * cnt));
+  EXPECT_EQ(delta.cached_byte_size_, delta.resident_byte_size_);
+}
+
+TEST_F(MemoryPoolTest, CacheLimit)
+{
+  const size_t byte_size = 256 * kKB;
+  SystemMemoryPool::Options options;
+  options.max_cached_byte_size_ = 1 * kMB;
+  options.thread_cache_byte_size_ = 0;
+  SystemMemoryPool::Configure(options);
+
+  RunOnThread([byte_size]() {
+    std::vector<char*> buffers;
+    for (size_t i = 0; i < 8; ++i) {
+      buffers.push_back(SystemMemoryPool::Allocate(byte_size));
+    }
+    for (char* buffer : buffers) {
+      SystemMemoryPool::Release(buffer, byte_size);
+    }
+  });
+
+  // Only as many buffers as fit in the limit are kept, the rest are
+  // returned to the system.
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(delta.miss_count_, 8u);
+  EXPECT_EQ(delta.cached_byte_size_, 1 * kMB);
+  EXPECT_EQ(delta.resident_byte_size_, 1 * kMB);
+
+  // Lowering the limit returns the excess to the system.
+  options.max_cached_byte_size_ = 512 * kKB;
+  SystemMemoryPool::Configure(options);
+  delta = Delta();
+  EXPECT_LE(delta.cached_byte_size_, 512 * kKB);
+  EXPECT_EQ(delta.resident_byte_size_, delta.cached_byte_size_);
+
+  // Buffers larger than the limit are never cached.
+  RunOnThread([]() {
+    char* buffer = SystemMemoryPool::Allocate(1 * kMB);
+    SystemMemoryPool::Release(buffer, 1 * kMB);
+  });
+  delta = Delta();
+  EXPECT_LE(delta.cached_byte_size_, 512 * kKB);
+  EXPECT_EQ(delta.resident_byte_size_, delta.cached_byte_size_);
+}
+
+TEST_F(MemoryPoolTest, ThreadCacheLimit)
+{
+  const size_t byte_size = 512 * kKB;
+  SystemMemoryPool::Options options;
+  options.thread_cache_byte_size_ = 1 * kMB;
+  SystemMemoryPool::Configure(options);
+
+  RunOnThread([this, byte_size]() {
+    std::vector<char*> buffers;
+    for (size_t i = 0; i < 4; ++i) {
+      buffers.push_back(SystemMemoryPool::Allocate(byte_size));
+    }
+
+    // The third release overflows the thread's cache, which moves
+    // the buffers it holds to the shared free lists.
+    for (char* buffer : buffers) {
+      SystemMemoryPool::Release(buffer, byte_size);
+    }
+    EXPECT_EQ(Delta().cached_byte_size_, 2 * byte_size);
+  });
+
+  EXPECT_EQ(Delta().cached_byte_size_, 4 * byte_size);
+}
+
+TEST_F(MemoryPoolTest, StatsMatchUse)
+{
+  // A mix of sizes, each allocated and released several times from
+  // several threads. The statistics and the exported metrics must
+  // account for every allocation and every resident byte.
+  const std::vector<size_t> sizes{100, 300, 4 * kKB, 100 * kKB, 3 * kMB};
+  const size_t rounds = 100;
+  const size_t thread_cnt = 4;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_cnt; ++t) {
+    threads.emplace_back([&sizes, rounds]() {
+      for (size_t r = 0; r < rounds; ++r) {
+        std::vector<char*> buffers;
+        for (size_t byte_size : sizes) {
+          buffers.push_back(SystemMemoryPool::Allocate(byte_size));
+        }
+        for (size_t i = 0; i < sizes.size(); ++i) {
+          SystemMemoryPool::Release(buffers[i], sizes[i]);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Nothing is in use so every resident byte is cached. Each thread
+  // needs at most one buffer of each class at a time, so there are at
+  // most 'thread_cnt' misses per size.
+  const size_t class_byte_size = 256 + 320 + 4 * kKB + 112 * kKB + 3 * kMB;
+  SystemMemoryPool::Stats delta = Delta();
+  EXPECT_EQ(
+      delta.hit_count_ + delta.miss_count_,
+      thread_cnt * rounds * sizes.size());
+  EXPECT_LE(delta.miss_count_, thread_cnt * sizes.size());
+  EXPECT_EQ(delta.cached_byte_size_, delta.resident_byte_size_);
+  EXPECT_EQ(delta.resident_byte_size_ % class_byte_size, 0u);
+  EXPECT_LE(delta.resident_byte_size_, thread_cnt * class_byte_size);
+
+  SystemMemoryPool::Stats stats;
+  SystemMemoryPool::GetStats(&stats);
+  EXPECT_EQ(Metrics::MemoryPoolHitCount().Value(), stats.hit_count_);
+  EXPECT_EQ(Metrics::MemoryPoolMissCount().Value(), stats.miss_count_);
+  EXPECT_EQ(
+      Metrics::MemoryPoolResidentBytes().Value(), stats.resident_byte_size_);
+  EXPECT_EQ(
+      Metrics::MemoryPoolCachedBytes().Value(), stats.cached_byte_size_);
+}
+
+}}}  // namespace nvidia::inferenceserver::test
@@ -0,0 +1,191 @@
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "src/core/topk.h"
+
+namespace ni = nvidia::inferenceserver;
+
+namespace {
+
+void
+Usage(char** argv, const std::string& msg = std::string())
+{
+  if (!msg.empty()) {
+    std::cerr << "error: " << msg << std::endl;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " [options]" << std::endl;
+  std::cerr << "\t-i <iterations per measurement>" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Measures classification top-K selection against a full "
+            << "sort for common class counts, top-K sizes and batch sizes."
+            << std::endl;
+
+  exit(1);
+}
+
+// The selection previously used for classification results: sort
+// the indices of every row.
+template <typename T>
+void
+SortTopK(
+    const T* values, const size_t batch_size, const size_t entry_cnt,
+    const size_t k, size_t* topk)
+{
+  std::vector<size_t> idx(entry_cnt);
+  for (size_t b = 0; b < batch_size; ++b) {
+    const T* row = values + (b * entry_cnt);
+    std::iota(idx.begin(), idx.end(), 0);
+    std::sort(idx.begin(), idx.end(), [row](size_t i1, size_t i2) {
+      return row[i1] > row[i2];
+    });
+    std::copy(idx.begin(), idx.begin() + k, topk + (b * k));
+  }
+}
+
+template <typename F>
+double
+MeasureUs(const int iterations, F fn)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+         iterations;
+}
+
+// Convert a float to half precision, truncating the mantissa. Only
+// used to generate benchmark data so denormals flush to zero.
+ni::Float16
+FloatToFloat16(const float f)
+{
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+  if (exponent <= 0) {
+    return ni::Float16{sign};
+  }
+  if (exponent >= 0x1f) {
+    return ni::Float16{static_cast<uint16_t>(sign | 0x7c00)};
+  }
+  return ni::Float16{static_cast<uint16_t>(
+      sign | (exponent << 10) | ((bits >> 13) & 0x3ff))};
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  int iterations = 100;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "i:")) != -1) {
+    switch (opt) {
+      case 'i':
+        iterations = atoi(optarg);
+        break;
+      case '?':
+        Usage(argv);
+        break;
+    }
+  }
+
+  if (iterations <= 0) {
+    Usage(argv, "iterations must be > 0");
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+  std::cout << std::setw(8) << "classes" << std::setw(6) << "k"
+            << std::setw(7) << "batch" << std::setw(14) << "sort(us)"
+            << std::setw(14) << "fp32(us)" << std::setw(14) << "fp16(us)"
+            << std::setw(10) << "speedup" << std::endl;
+
+  for (const size_t entry_cnt : {1000, 30000}) {
+    for (const size_t batch_size : {1, 32}) {
+      std::vector<float> values(batch_size * entry_cnt);
+      for (auto& v : values) {
+        v = dist(rng);
+      }
+      std::vector<ni::Float16> half_values(values.size());
+      std::transform(
+          values.begin(), values.end(), half_values.begin(), FloatToFloat16);
+
+      for (const size_t k : {1, 5, 100}) {
+        std::vector<size_t> expected(batch_size * k);
+        std::vector<size_t> topk(batch_size * k);
+
+        const double sort_us = MeasureUs(iterations, [&] {
+          SortTopK(values.data(), batch_size, entry_cnt, k, expected.data());
+        });
+        const double fp32_us = MeasureUs(iterations, [&] {
+          ni::BatchTopK(values.data(), batch_size, entry_cnt, k, topk.data());
+        });
+
+        // The full sort does not order equal values so compare the
+        // selected values rather than the indices.
+        bool match = true;
+        for (size_t i = 0; i < topk.size(); ++i) {
+          const size_t row = (i / k) * entry_cnt;
+          match &= (values[row + topk[i]] == values[row + expected[i]]);
+        }
+        if (!match) {
+          std::cerr << "error: top-" << k << " mismatch for " << entry_cnt
+                    << " classes, batch " << batch_size << std::endl;
+          return 1;
+        }
+
+        const double fp16_us = MeasureUs(iterations, [&] {
+          ni::BatchTopK(
+              half_values.data(), batch_size, entry_cnt, k, topk.data());
+        });
+
+        std::cout << std::setw(8) << entry_cnt << std::setw(6) << k
+                  << std::setw(7) << batch_size << std::fixed
+                  << std::setprecision(1) << std::setw(14) << sort_us
+                  << std::setw(14) << fp32_us << std::setw(14) << fp16_us
+                  << std::setw(9) << (sort_us / fp32_us) << "x" << std::endl;
+      }
+    }
+  }
+
+  return 0;
+}
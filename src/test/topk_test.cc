@@ -0,0 +1,195 @@
+// Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "src/core/float16.h"
+#include "src/core/topk.h"
+
+namespace nvidia { namespace inferenceserver { namespace test {
+
+namespace {
+
+float
+ToFloat(float v)
+{
+  return v;
+}
+
+float
+ToFloat(int32_t v)
+{
+  return static_cast<float>(v);
+}
+
+float
+ToFloat(uint8_t v)
+{
+  return static_cast<float>(v);
+}
+
+float
+ToFloat(Float16 v)
+{
+  return Float16ToFloat(v);
+}
+
+// Select the top-K of each row by sorting all of the row's indices,
+// as classification results were selected before BatchTopK. A stable
+// sort orders equal values by index, which BatchTopK must match.
+template <typename T>
+std::vector<size_t>
+SortTopK(
+    const std::vector<T>& values, const size_t batch_size,
+    const size_t entry_cnt, const size_t k)
+{
+  std::vector<size_t> topk;
+  std::vector<size_t> idx(entry_cnt);
+  for (size_t b = 0; b < batch_size; ++b) {
+    const T* row = values.data() + (b * entry_cnt);
+    std::iota(idx.begin(), idx.end(), 0);
+    std::stable_sort(idx.begin(), idx.end(), [row](size_t i1, size_t i2) {
+      return ToFloat(row[i1]) > ToFloat(row[i2]);
+    });
+    topk.insert(topk.end(), idx.begin(), idx.begin() + k);
+  }
+
+  return topk;
+}
+
+template <typename T>
+void
+CheckTopK(
+    const std::vector<T>& values, const size_t batch_size,
+    const size_t entry_cnt)
+{
+  for (size_t k : {size_t(1), size_t(2), size_t(5), topk::kMaxHeapK,
+                   topk::kMaxHeapK + 1, size_t(100), entry_cnt}) {
+    k = std::min(k, entry_cnt);
+    SCOPED_TRACE(
+        "classes " + std::to_string(entry_cnt) + ", batch " +
+        std::to_string(batch_size) + ", k " + std::to_string(k));
+
+    std::vector<size_t> topk(batch_size * k);
+    BatchTopK(values.data(), batch_size, entry_cnt, k, topk.data());
+    EXPECT_EQ(topk, SortTopK(values, batch_size, entry_cnt, k));
+  }
+}
+
+// Run CheckTopK for a range of class counts and batch sizes with
+// values produced by 'gen'.
+template <typename T, typename G>
+void
+CheckAll(G gen)
+{
+  for (const size_t entry_cnt : {1, 7, 16, 17, 1000, 30000}) {
+    for (const size_t batch_size : {1, 3}) {
+      std::vector<T> values(batch_size * entry_cnt);
+      for (auto& v : values) {
+        v = gen();
+      }
+      CheckTopK(values, batch_size, entry_cnt);
+    }
+  }
+}
+
+class TopKTest : public ::testing::Test {
+ protected:
+  TopKTest() : rng_(0) {}
+
+  std::mt19937 rng_;
+};
+
+}  // namespace
+
+TEST_F(TopKTest, Float)
+{
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  CheckAll<float>([this, &dist]() { return dist(rng_); });
+}
+
+TEST_F(TopKTest, FloatTies)
+{
+  // Only a few distinct values so most of the top-K are ties that
+  // must be ordered by index.
+  std::uniform_int_distribution<int> dist(-2, 2);
+  CheckAll<float>([this, &dist]() { return 0.5f * dist(rng_); });
+}
+
+TEST_F(TopKTest, Int32Ties)
+{
+  std::uniform_int_distribution<int32_t> dist(-3, 3);
+  CheckAll<int32_t>([this, &dist]() { return dist(rng_); });
+}
+
+TEST_F(TopKTest, UInt8)
+{
+  std::uniform_int_distribution<int> dist(0, 255);
+  CheckAll<uint8_t>(
+      [this, &dist]() { return static_cast<uint8_t>(dist(rng_)); });
+}
+
+TEST_F(TopKTest, Float16)
+{
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  CheckAll<Float16>([this, &dist]() { return FloatToFloat16(dist(rng_)); });
+}
+
+TEST_F(TopKTest, Float16Ties)
+{
+  std::uniform_int_distribution<int> dist(-2, 2);
+  CheckAll<Float16>(
+      [this, &dist]() { return FloatToFloat16(0.25f * dist(rng_)); });
+}
+
+TEST_F(TopKTest, Float16Extremes)
+{
+  // Infinities, the largest finite values and subnormals, which must
+  // order the same as their single-precision values.
+  const std::vector<uint16_t> bits{
+      0x7c00, 0xfc00, 0x7bff, 0xfbff, 0x0001, 0x8001,
+      0x03ff, 0x83ff, 0x0400, 0x8400, 0x3c00, 0xbc00};
+  std::uniform_int_distribution<size_t> dist(0, bits.size() - 1);
+  CheckAll<Float16>([this, &bits, &dist]() {
+    return Float16{bits[dist(rng_)]};
+  });
+}
+
+TEST_F(TopKTest, Empty)
+{
+  // Nothing is written when there is nothing to select.
+  const std::vector<float> values{1.0f, 2.0f};
+  std::vector<size_t> topk{42};
+  BatchTopK(values.data(), 1, 2, 0, topk.data());
+  BatchTopK(values.data(), 1, 0, 0, topk.data());
+  EXPECT_EQ(topk, std::vector<size_t>{42});
+}
+
+}}}  // namespace nvidia::inferenceserver::test